@@ -0,0 +1,219 @@
+extern "C" {
+#include "dubins.h"
+#include "dubins_cache.h"
+}
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+#include "benchmark/benchmark.h"
+
+/*
+ * Random configuration pairs in the style of the Monte Carlo tests, drawn
+ * from two distance distributions: short pairs (d < 4, where CCC words can
+ * win) and long pairs (d between 10 and 100, always CSC).
+ */
+enum Distribution { SHORT_PATHS = 0, LONG_PATHS = 1 };
+
+static const size_t POOL_SIZE = 4096;
+static const double RHO = 1.0;
+
+struct Workload
+{
+    std::vector<double> q0, q1;
+    std::vector<DubinsPath> paths;
+
+    explicit Workload(int distribution)
+    {
+        srand(1729 + distribution);
+        q0.resize(3 * POOL_SIZE);
+        q1.resize(3 * POOL_SIZE);
+        paths.resize(POOL_SIZE);
+        for(size_t i = 0; i < POOL_SIZE; i++) {
+            double d = (distribution == SHORT_PATHS) ? uniform(0.0, 4.0) : uniform(10.0, 100.0);
+            double bearing = uniform(-M_PI, M_PI);
+            q0[3*i]   = uniform(-100.0, 100.0);
+            q0[3*i+1] = uniform(-100.0, 100.0);
+            q0[3*i+2] = uniform(-M_PI, M_PI);
+            q1[3*i]   = q0[3*i] + d * RHO * cos(bearing);
+            q1[3*i+1] = q0[3*i+1] + d * RHO * sin(bearing);
+            q1[3*i+2] = uniform(-M_PI, M_PI);
+            dubins_shortest_path(&paths[i], &q0[3*i], &q1[3*i], RHO);
+        }
+    }
+
+    static double uniform(double lo, double hi)
+    {
+        return lo + (hi - lo) * (rand() / (double)RAND_MAX);
+    }
+
+    static const Workload& get(int distribution)
+    {
+        static const Workload short_paths(SHORT_PATHS);
+        static const Workload long_paths(LONG_PATHS);
+        return (distribution == SHORT_PATHS) ? short_paths : long_paths;
+    }
+};
+
+static void label(benchmark::State& state, int distribution)
+{
+    state.SetLabel(distribution == SHORT_PATHS ? "short" : "long");
+}
+
+static void report_paths(benchmark::State& state, double per_iteration)
+{
+    state.counters["paths/s"] = benchmark::Counter(state.iterations() * per_iteration,
+                                                   benchmark::Counter::kIsRate);
+}
+
+static void BM_ShortestPath(benchmark::State& state)
+{
+    const Workload& w = Workload::get((int)state.range(0));
+    std::vector<double> q0 = w.q0, q1 = w.q1;
+    DubinsPath path;
+    size_t i = 0;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(dubins_shortest_path(&path, &q0[3*i], &q1[3*i], RHO));
+        benchmark::DoNotOptimize(path);
+        i = (i + 1) % POOL_SIZE;
+    }
+    label(state, (int)state.range(0));
+    report_paths(state, 1);
+}
+BENCHMARK(BM_ShortestPath)->Arg(SHORT_PATHS)->Arg(LONG_PATHS);
+
+static void BM_ShortestPathFloat(benchmark::State& state)
+{
+    const Workload& w = Workload::get((int)state.range(0));
+    std::vector<float> q0(w.q0.begin(), w.q0.end()), q1(w.q1.begin(), w.q1.end());
+    DubinsPathF path;
+    size_t i = 0;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(dubins_shortest_path_f(&path, &q0[3*i], &q1[3*i], (float)RHO));
+        benchmark::DoNotOptimize(path);
+        i = (i + 1) % POOL_SIZE;
+    }
+    label(state, (int)state.range(0));
+    report_paths(state, 1);
+}
+BENCHMARK(BM_ShortestPathFloat)->Arg(SHORT_PATHS)->Arg(LONG_PATHS);
+
+static void BM_ShortestPathCached(benchmark::State& state)
+{
+    const Workload& w = Workload::get((int)state.range(0));
+    std::vector<double> q0 = w.q0, q1 = w.q1;
+    DubinsPathCache* cache = dubins_path_cache_create(2 * POOL_SIZE, 0.0);
+    DubinsPath path;
+    size_t i = 0;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(dubins_shortest_path_cached(cache, &path, &q0[3*i], &q1[3*i], RHO));
+        benchmark::DoNotOptimize(path);
+        i = (i + 1) % POOL_SIZE;
+    }
+    dubins_path_cache_destroy(cache);
+    label(state, (int)state.range(0));
+    report_paths(state, 1);
+}
+BENCHMARK(BM_ShortestPathCached)->Arg(SHORT_PATHS)->Arg(LONG_PATHS);
+
+static void BM_Path(benchmark::State& state)
+{
+    const Workload& w = Workload::get((int)state.range(1));
+    std::vector<double> q0 = w.q0, q1 = w.q1;
+    DubinsPathType word = (DubinsPathType)state.range(0);
+    static const char* names[] = { "LSL", "LSR", "RSL", "RSR", "RLR", "LRL" };
+    DubinsPath path;
+    size_t i = 0;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(dubins_path(&path, &q0[3*i], &q1[3*i], RHO, word));
+        benchmark::DoNotOptimize(path);
+        i = (i + 1) % POOL_SIZE;
+    }
+    state.SetLabel(std::string(names[word]) + (state.range(1) == SHORT_PATHS ? "/short" : "/long"));
+    report_paths(state, 1);
+}
+BENCHMARK(BM_Path)->ArgsProduct({ { LSL, LSR, RSL, RSR, RLR, LRL }, { SHORT_PATHS, LONG_PATHS } });
+
+static void BM_ShortestPathBatch(benchmark::State& state)
+{
+    const Workload& w = Workload::get((int)state.range(0));
+    std::vector<double> soa[6];
+    std::vector<double> length(POOL_SIZE);
+    for(size_t i = 0; i < POOL_SIZE; i++) {
+        for(int j = 0; j < 3; j++) {
+            soa[j].push_back(w.q0[3*i+j]);
+            soa[3+j].push_back(w.q1[3*i+j]);
+        }
+    }
+    DubinsBatchInput in = { &soa[0][0], &soa[1][0], &soa[2][0], &soa[3][0], &soa[4][0], &soa[5][0], NULL, RHO };
+    DubinsBatchOutput out = { &length[0], NULL, { NULL, NULL, NULL }, NULL };
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(dubins_shortest_path_batch(&in, &out, POOL_SIZE));
+        benchmark::ClobberMemory();
+    }
+    label(state, (int)state.range(0));
+    report_paths(state, POOL_SIZE);
+}
+BENCHMARK(BM_ShortestPathBatch)->Arg(SHORT_PATHS)->Arg(LONG_PATHS);
+
+static void BM_PathSample(benchmark::State& state)
+{
+    const Workload& w = Workload::get((int)state.range(0));
+    std::vector<DubinsPath> paths = w.paths;
+    double q[3];
+    size_t i = 0;
+    for(auto _ : state) {
+        DubinsPath* path = &paths[i];
+        benchmark::DoNotOptimize(dubins_path_sample(path, 0.5 * dubins_path_length(path), q));
+        benchmark::DoNotOptimize(q);
+        i = (i + 1) % POOL_SIZE;
+    }
+    label(state, (int)state.range(0));
+}
+BENCHMARK(BM_PathSample)->Arg(SHORT_PATHS)->Arg(LONG_PATHS);
+
+static int count_samples(double q[3], double t, void* user_data)
+{
+    (void)q;
+    (void)t;
+    (*(size_t*)user_data)++;
+    return 0;
+}
+
+static void BM_PathSampleMany(benchmark::State& state)
+{
+    const Workload& w = Workload::get((int)state.range(0));
+    std::vector<DubinsPath> paths = w.paths;
+    size_t i = 0, samples = 0;
+    for(auto _ : state) {
+        benchmark::DoNotOptimize(dubins_path_sample_many(&paths[i], 0.1 * RHO, count_samples, &samples));
+        i = (i + 1) % POOL_SIZE;
+    }
+    label(state, (int)state.range(0));
+    state.counters["samples/s"] = benchmark::Counter((double)samples, benchmark::Counter::kIsRate);
+    report_paths(state, 1);
+}
+BENCHMARK(BM_PathSampleMany)->Arg(SHORT_PATHS)->Arg(LONG_PATHS);
+
+static void BM_ExtractSubpath(benchmark::State& state)
+{
+    const Workload& w = Workload::get((int)state.range(0));
+    std::vector<DubinsPath> paths = w.paths;
+    DubinsPath sub;
+    size_t i = 0;
+    for(auto _ : state) {
+        DubinsPath* path = &paths[i];
+        benchmark::DoNotOptimize(dubins_extract_subpath(path, 0.5 * dubins_path_length(path), &sub));
+        benchmark::DoNotOptimize(sub);
+        i = (i + 1) % POOL_SIZE;
+    }
+    label(state, (int)state.range(0));
+    report_paths(state, 1);
+}
+BENCHMARK(BM_ExtractSubpath)->Arg(SHORT_PATHS)->Arg(LONG_PATHS);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,544 @@
+extern "C" {
+#include "dubins.h"
+#include "dubins_cache.h"
+}
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ * Monte Carlo cross-check of every solver engine against the reference
+ * (dubins_shortest_path_scan with DUBINS_SCAN_FULL).
+ *
+ * Pairs are generated in chunks, each from its own seed, so a run is
+ * reproducible whatever the thread count.  Every chunk is solved by the
+ * reference and then by each engine; only the engine's own solve is timed.
+ * An engine fails a pair when its error code differs from the reference,
+ * its length is off by more than its tolerance, or the end of its path
+ * misses the goal configuration.  Single precision engines are compared with
+ * the reference solve of their inputs rounded to float, since rounding alone
+ * can move a pair across the boundary where a word becomes feasible and the
+ * shortest length jumps.  Differing words of equal length are
+ * counted but are not failures, since ties may be broken either way.
+ *
+ *     stress_dubins [--pairs N] [--threads T] [--seed S] [--rho R]
+ */
+
+static const size_t CHUNK = 4096;
+
+typedef std::chrono::steady_clock Clock;
+
+struct Chunk
+{
+    std::vector<double> q0, q1;
+    std::vector<double> x0, y0, th0, x1, y1, th1;
+    std::vector<float> q0f, q1f;
+    std::vector<DubinsPath> reference;
+    std::vector<int> reference_err;
+    /* the reference solve of the inputs rounded to float, and those inputs */
+    std::vector<double> q0r, q1r;
+    std::vector<DubinsPath> reference_f;
+    std::vector<int> reference_f_err;
+    size_t n;
+    double rho;
+
+    /* half the pairs are short (d < 4, where CCC words can win), half long */
+    void generate(uint64_t seed, size_t count, double radius)
+    {
+        std::mt19937_64 gen(seed);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        n = count;
+        rho = radius;
+        q0.resize(3 * n);
+        q1.resize(3 * n);
+        for(size_t i = 0; i < n; i++) {
+            double d = (unit(gen) < 0.5) ? 4.0 * unit(gen) : 4.0 + 96.0 * unit(gen);
+            double bearing = 2 * M_PI * unit(gen);
+            q0[3*i]   = 200.0 * unit(gen) - 100.0;
+            q0[3*i+1] = 200.0 * unit(gen) - 100.0;
+            q0[3*i+2] = 2 * M_PI * unit(gen);
+            q1[3*i]   = q0[3*i] + d * rho * cos(bearing);
+            q1[3*i+1] = q0[3*i+1] + d * rho * sin(bearing);
+            q1[3*i+2] = 2 * M_PI * unit(gen);
+        }
+        x0.resize(n); y0.resize(n); th0.resize(n);
+        x1.resize(n); y1.resize(n); th1.resize(n);
+        for(size_t i = 0; i < n; i++) {
+            x0[i] = q0[3*i]; y0[i] = q0[3*i+1]; th0[i] = q0[3*i+2];
+            x1[i] = q1[3*i]; y1[i] = q1[3*i+1]; th1[i] = q1[3*i+2];
+        }
+        q0f.assign(q0.begin(), q0.end());
+        q1f.assign(q1.begin(), q1.end());
+        q0r.assign(q0f.begin(), q0f.end());
+        q1r.assign(q1f.begin(), q1f.end());
+
+        reference.resize(n);
+        reference_err.resize(n);
+        for(size_t i = 0; i < n; i++) {
+            reference_err[i] = dubins_shortest_path_scan(&reference[i], &q0[3*i], &q1[3*i], rho,
+                                                         DUBINS_SCAN_FULL);
+        }
+        reference_f.resize(n);
+        reference_f_err.resize(n);
+        for(size_t i = 0; i < n; i++) {
+            reference_f_err[i] = dubins_shortest_path_scan(&reference_f[i], &q0r[3*i], &q1r[3*i],
+                                                           (double)(float)rho, DUBINS_SCAN_FULL);
+        }
+    }
+
+    DubinsBatchInput batch() const
+    {
+        DubinsBatchInput in = { x0.data(), y0.data(), th0.data(), x1.data(), y1.data(), th1.data(), NULL, rho };
+        return in;
+    }
+};
+
+/* what an engine produced for one chunk */
+struct Result
+{
+    std::vector<int> err;
+    std::vector<double> length;
+    /* -1 when the engine does not report a word */
+    std::vector<int> type;
+    /* the end of the path, NAN when the engine gives no path */
+    std::vector<double> end;
+
+    void reset(size_t n)
+    {
+        err.assign(n, EDUBOK);
+        length.assign(n, NAN);
+        type.assign(n, -1);
+        end.assign(3 * n, NAN);
+    }
+
+    void set_path(size_t i, DubinsPath* path)
+    {
+        length[i] = dubins_path_length(path);
+        type[i] = (int)dubins_path_type(path);
+        if(dubins_path_endpoint(path, &end[3*i]) != EDUBOK) {
+            end[3*i] = NAN;
+        }
+    }
+
+    void set_path(size_t i, DubinsPathF* path)
+    {
+        float q[3];
+        length[i] = dubins_path_length_f(path);
+        type[i] = (int)path->type;
+        if(dubins_path_sample_f(path, dubins_path_length_f(path), q) == EDUBOK) {
+            end[3*i] = q[0];
+            end[3*i+1] = q[1];
+            end[3*i+2] = q[2];
+        }
+    }
+};
+
+struct Engine
+{
+    const char* name;
+    /* solve the chunk, returning the seconds spent in the solver */
+    double (*run)(const Chunk& chunk, Result& result);
+    /* queries issued per pair */
+    int queries;
+    /* allowed length error, relative to 1 + the reference length */
+    double length_tolerance;
+    /* allowed distance from the goal, relative to 1 + the reference length */
+    double end_tolerance;
+    /* non-zero to run the engine at every supported SIMD level, otherwise once at DUBINS_SIMD_NONE */
+    int per_level;
+    /* non-zero for single precision engines, which are compared with the solve of their rounded inputs */
+    int single;
+};
+
+struct Report
+{
+    std::string name;
+    uint64_t pairs = 0;
+    uint64_t queries = 0;
+    double seconds = 0.0;
+    double max_length_error = 0.0;
+    double max_end_error = 0.0;
+    uint64_t word_differences = 0;
+    uint64_t failures = 0;
+
+    void merge(const Report& other)
+    {
+        pairs += other.pairs;
+        queries += other.queries;
+        seconds += other.seconds;
+        max_length_error = std::max(max_length_error, other.max_length_error);
+        max_end_error = std::max(max_end_error, other.max_end_error);
+        word_differences += other.word_differences;
+        failures += other.failures;
+    }
+};
+
+static DubinsPathCache* shared_cache;
+
+static double seconds_since(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+static double run_reference(const Chunk& chunk, Result& result)
+{
+    std::vector<DubinsPath> paths(chunk.n);
+    Clock::time_point start = Clock::now();
+    for(size_t i = 0; i < chunk.n; i++) {
+        result.err[i] = dubins_shortest_path_scan(&paths[i], (double*)&chunk.q0[3*i], (double*)&chunk.q1[3*i],
+                                                  chunk.rho, DUBINS_SCAN_FULL);
+    }
+    double seconds = seconds_since(start);
+    for(size_t i = 0; i < chunk.n; i++) {
+        result.set_path(i, &paths[i]);
+    }
+    return seconds;
+}
+
+static double run_scalar(const Chunk& chunk, Result& result)
+{
+    std::vector<DubinsPath> paths(chunk.n);
+    Clock::time_point start = Clock::now();
+    for(size_t i = 0; i < chunk.n; i++) {
+        result.err[i] = dubins_shortest_path(&paths[i], (double*)&chunk.q0[3*i], (double*)&chunk.q1[3*i], chunk.rho);
+    }
+    double seconds = seconds_since(start);
+    for(size_t i = 0; i < chunk.n; i++) {
+        result.set_path(i, &paths[i]);
+    }
+    return seconds;
+}
+
+static double run_length(const Chunk& chunk, Result& result)
+{
+    Clock::time_point start = Clock::now();
+    for(size_t i = 0; i < chunk.n; i++) {
+        result.err[i] = dubins_shortest_length(&result.length[i], (double*)&chunk.q0[3*i],
+                                               (double*)&chunk.q1[3*i], chunk.rho);
+    }
+    return seconds_since(start);
+}
+
+static double run_float(const Chunk& chunk, Result& result)
+{
+    std::vector<DubinsPathF> paths(chunk.n);
+    Clock::time_point start = Clock::now();
+    for(size_t i = 0; i < chunk.n; i++) {
+        result.err[i] = dubins_shortest_path_f(&paths[i], (float*)&chunk.q0f[3*i], (float*)&chunk.q1f[3*i],
+                                               (float)chunk.rho);
+    }
+    double seconds = seconds_since(start);
+    for(size_t i = 0; i < chunk.n; i++) {
+        result.set_path(i, &paths[i]);
+    }
+    return seconds;
+}
+
+static double run_canonical(const Chunk& chunk, Result& result)
+{
+    std::vector<DubinsPath> paths(chunk.n);
+    Clock::time_point start = Clock::now();
+    for(size_t i = 0; i < chunk.n; i++) {
+        DubinsCanonicalPair pair;
+        DubinsPathType type;
+        double param[3];
+        double* q0 = (double*)&chunk.q0[3*i];
+        int err = dubins_canonicalize(&pair, q0, (double*)&chunk.q1[3*i], chunk.rho);
+        if(err == EDUBOK) {
+            err = dubins_canonical_shortest(&pair, &type, param);
+        }
+        if(err == EDUBOK) {
+            err = dubins_canonical_attach(&paths[i], &pair, type, param, q0, chunk.rho);
+        }
+        result.err[i] = err;
+    }
+    double seconds = seconds_since(start);
+    for(size_t i = 0; i < chunk.n; i++) {
+        result.set_path(i, &paths[i]);
+    }
+    return seconds;
+}
+
+/* every pair is asked twice, so the second answer comes from the cache unless it was evicted */
+static double run_cached(const Chunk& chunk, Result& result)
+{
+    std::vector<DubinsPath> paths(chunk.n);
+    Clock::time_point start = Clock::now();
+    for(int pass = 0; pass < 2; pass++) {
+        for(size_t i = 0; i < chunk.n; i++) {
+            result.err[i] = dubins_shortest_path_cached(shared_cache, &paths[i], (double*)&chunk.q0[3*i],
+                                                        (double*)&chunk.q1[3*i], chunk.rho);
+        }
+    }
+    double seconds = seconds_since(start);
+    for(size_t i = 0; i < chunk.n; i++) {
+        result.set_path(i, &paths[i]);
+    }
+    return seconds;
+}
+
+static double run_batch(const Chunk& chunk, Result& result)
+{
+    std::vector<DubinsPathType> type(chunk.n);
+    std::vector<double> param[3];
+    for(int j = 0; j < 3; j++) {
+        param[j].resize(chunk.n);
+    }
+    DubinsBatchInput in = chunk.batch();
+    DubinsBatchOutput out = { result.length.data(), type.data(),
+                              { param[0].data(), param[1].data(), param[2].data() }, result.err.data() };
+    Clock::time_point start = Clock::now();
+    dubins_shortest_path_batch(&in, &out, chunk.n);
+    double seconds = seconds_since(start);
+    for(size_t i = 0; i < chunk.n; i++) {
+        DubinsPath path;
+        memcpy(path.qi, &chunk.q0[3*i], sizeof(path.qi));
+        path.param[0] = param[0][i];
+        path.param[1] = param[1][i];
+        path.param[2] = param[2][i];
+        path.rho = chunk.rho;
+        path.type = type[i];
+        if(result.err[i] == EDUBOK) {
+            result.set_path(i, &path);
+        }
+    }
+    return seconds;
+}
+
+static double run_length_batch(const Chunk& chunk, Result& result)
+{
+    DubinsBatchInput in = chunk.batch();
+    Clock::time_point start = Clock::now();
+    dubins_shortest_length_batch(&in, result.length.data(), result.err.data(), chunk.n);
+    return seconds_since(start);
+}
+
+static double run_float_many(const Chunk& chunk, Result& result)
+{
+    std::vector<DubinsPathF> paths(chunk.n);
+    Clock::time_point start = Clock::now();
+    dubins_shortest_path_many_f(paths.data(), chunk.q0f.data(), chunk.q1f.data(), (float)chunk.rho,
+                                result.err.data(), chunk.n);
+    double seconds = seconds_since(start);
+    for(size_t i = 0; i < chunk.n; i++) {
+        result.set_path(i, &paths[i]);
+    }
+    return seconds;
+}
+
+static const Engine ENGINES[] = {
+    { "reference",    run_reference,    1, 0.0,   1e-8, 0, 0 },
+    { "scalar",       run_scalar,       1, 0.0,   1e-8, 0, 0 },
+    { "length",       run_length,       1, 0.0,   0.0,  0, 0 },
+    { "canonical",    run_canonical,    1, 1e-12, 1e-8, 0, 0 },
+    { "cached",       run_cached,       2, 0.0,   1e-8, 0, 0 },
+    /* coordinates reach 100 rho, where one float ulp is already 8e-6 rho */
+    { "float",        run_float,        1, 5e-4,  5e-4, 0, 1 },
+    { "batch",        run_batch,        1, 1e-12, 1e-8, 1, 0 },
+    { "length_batch", run_length_batch, 1, 1e-12, 0.0,  1, 0 },
+    { "float_many",   run_float_many,   1, 5e-4,  5e-4, 0, 1 },
+};
+static const size_t N_ENGINES = sizeof(ENGINES) / sizeof(ENGINES[0]);
+
+static const char* level_name(int level)
+{
+    static const char* names[] = { "none", "sse2", "avx2", "avx512", "neon", "wasm" };
+    return names[level];
+}
+
+static void check(const Engine& engine, const Chunk& chunk, const Result& result, Report& report)
+{
+    for(size_t i = 0; i < chunk.n; i++) {
+        const DubinsPath& ref = engine.single ? chunk.reference_f[i] : chunk.reference[i];
+        const double* goal = engine.single ? &chunk.q1r[3*i] : &chunk.q1[3*i];
+        if(result.err[i] != (engine.single ? chunk.reference_f_err[i] : chunk.reference_err[i])) {
+            report.failures++;
+            continue;
+        }
+        if(result.err[i] != EDUBOK) {
+            continue;
+        }
+        double ref_length = dubins_path_length((DubinsPath*)&ref);
+        double scale = 1.0 + ref_length;
+        double length_error = fabs(result.length[i] - ref_length) / scale;
+        report.max_length_error = std::max(report.max_length_error, length_error);
+        bool failed = !(length_error <= engine.length_tolerance);
+
+        if(result.type[i] >= 0 && result.type[i] != (int)ref.type) {
+            report.word_differences++;
+        }
+        if(engine.end_tolerance > 0.0) {
+            const double* end = &result.end[3*i];
+            double heading = fabs(remainder(end[2] - goal[2], 2 * M_PI));
+            double end_error = std::max(hypot(end[0] - goal[0], end[1] - goal[1]) / chunk.rho, heading) / scale;
+            if(!(end_error <= engine.end_tolerance)) {
+                failed = true;
+                end_error = std::isnan(end_error) ? INFINITY : end_error;
+            }
+            report.max_end_error = std::max(report.max_end_error, end_error);
+        }
+        if(failed) {
+            report.failures++;
+        }
+    }
+}
+
+struct Task
+{
+    const Engine* engine;
+    int level;
+    std::string name;
+};
+
+/* run every task of one SIMD level over all chunks */
+static void run_level(const std::vector<Task*>& tasks, std::vector<Report>& reports, const std::vector<size_t>& report_of,
+                      uint64_t n_pairs, unsigned n_threads, uint64_t seed, double rho)
+{
+    uint64_t n_chunks = (n_pairs + CHUNK - 1) / CHUNK;
+    std::atomic<uint64_t> next(0);
+    std::mutex lock;
+    std::vector<std::thread> threads;
+
+    for(unsigned t = 0; t < n_threads; t++) {
+        threads.emplace_back([&]() {
+            Chunk chunk;
+            Result result;
+            std::vector<Report> local(tasks.size());
+            for(uint64_t c = next++; c < n_chunks; c = next++) {
+                size_t n = (size_t)std::min<uint64_t>(CHUNK, n_pairs - c * CHUNK);
+                chunk.generate(seed + c * 0x9E3779B97F4A7C15ull, n, rho);
+                for(size_t k = 0; k < tasks.size(); k++) {
+                    result.reset(n);
+                    local[k].seconds += tasks[k]->engine->run(chunk, result);
+                    local[k].pairs += n;
+                    local[k].queries += (uint64_t)n * tasks[k]->engine->queries;
+                    check(*tasks[k]->engine, chunk, result, local[k]);
+                }
+            }
+            std::lock_guard<std::mutex> guard(lock);
+            for(size_t k = 0; k < tasks.size(); k++) {
+                reports[report_of[k]].merge(local[k]);
+            }
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+}
+
+static void usage(const char* program)
+{
+    fprintf(stderr, "usage: %s [--pairs N] [--threads T] [--seed S] [--rho R]\n", program);
+}
+
+int main(int argc, char** argv)
+{
+    uint64_t n_pairs = 100000000;
+    unsigned n_threads = std::max(1u, std::thread::hardware_concurrency());
+    uint64_t seed = 1729;
+    double rho = 1.0;
+
+    for(int i = 1; i < argc; i++) {
+        if(i + 1 < argc && strcmp(argv[i], "--pairs") == 0) {
+            n_pairs = strtoull(argv[++i], NULL, 10);
+        }
+        else if(i + 1 < argc && strcmp(argv[i], "--threads") == 0) {
+            n_threads = (unsigned)std::max(1l, strtol(argv[++i], NULL, 10));
+        }
+        else if(i + 1 < argc && strcmp(argv[i], "--seed") == 0) {
+            seed = strtoull(argv[++i], NULL, 10);
+        }
+        else if(i + 1 < argc && strcmp(argv[i], "--rho") == 0) {
+            rho = strtod(argv[++i], NULL);
+        }
+        else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+    if(!(rho > 0.0)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    shared_cache = dubins_path_cache_create((size_t)1 << 20, 0.0);
+    if(shared_cache == NULL) {
+        fprintf(stderr, "could not create the path cache\n");
+        return 1;
+    }
+
+    DubinsSimdLevel detected = dubins_simd_level();
+    std::vector<Task> all_tasks;
+    for(int level = DUBINS_SIMD_NONE; level <= DUBINS_SIMD_WASM; level++) {
+        if(dubins_simd_set_level((DubinsSimdLevel)level) != EDUBOK) {
+            continue;
+        }
+        for(size_t e = 0; e < N_ENGINES; e++) {
+            if(!ENGINES[e].per_level && level != DUBINS_SIMD_NONE) {
+                continue;
+            }
+            std::string name = ENGINES[e].name;
+            if(ENGINES[e].per_level) {
+                name += std::string("/") + level_name(level);
+            }
+            all_tasks.push_back(Task{ &ENGINES[e], level, name });
+        }
+    }
+
+    printf("%llu pairs on %u threads, seed %llu, rho %g, detected SIMD level %s\n",
+           (unsigned long long)n_pairs, n_threads, (unsigned long long)seed, rho, level_name(detected));
+
+    std::vector<Report> reports(all_tasks.size());
+    for(size_t k = 0; k < all_tasks.size(); k++) {
+        reports[k].name = all_tasks[k].name;
+    }
+    for(int level = DUBINS_SIMD_NONE; level <= DUBINS_SIMD_WASM; level++) {
+        std::vector<Task*> tasks;
+        std::vector<size_t> report_of;
+        for(size_t k = 0; k < all_tasks.size(); k++) {
+            if(all_tasks[k].level == level) {
+                tasks.push_back(&all_tasks[k]);
+                report_of.push_back(k);
+            }
+        }
+        if(tasks.empty()) {
+            continue;
+        }
+        dubins_simd_set_level((DubinsSimdLevel)level);
+        run_level(tasks, reports, report_of, n_pairs, n_threads, seed, rho);
+    }
+    dubins_simd_set_level(detected);
+
+    DubinsPathCacheStats cache_stats;
+    dubins_path_cache_stats(shared_cache, &cache_stats);
+    dubins_path_cache_destroy(shared_cache);
+
+    uint64_t failures = 0;
+    printf("%-20s %14s %12s %14s %14s %12s %10s\n",
+           "engine", "queries", "Mq/s", "max len err", "max end err", "word diffs", "failures");
+    for(const Report& r : reports) {
+        /* solver time is summed over threads, so divide it back out for throughput */
+        double rate = (r.seconds > 0.0) ? r.queries / (r.seconds / n_threads) / 1e6 : 0.0;
+        printf("%-20s %14llu %12.2f %14.3e %14.3e %12llu %10llu\n", r.name.c_str(),
+               (unsigned long long)r.queries, rate, r.max_length_error, r.max_end_error,
+               (unsigned long long)r.word_differences, (unsigned long long)r.failures);
+        failures += r.failures;
+    }
+    printf("cache: %llu hits, %llu misses, %llu evictions\n", (unsigned long long)cache_stats.hits,
+           (unsigned long long)cache_stats.misses, (unsigned long long)cache_stats.evictions);
+    printf("errors are relative to 1 + the reference length, end errors in units of rho\n");
+    return failures == 0 ? 0 : 1;
+}
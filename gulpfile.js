@@ -6,14 +6,25 @@ let babel = require('gulp-babel');
 
 let wasm_config = require('./wasm.config.js');
 
-gulp.task('build', (cb) => {
-    let cmd = `emcc ${wasm_config.flags.join(' ')} ${wasm_config.inputfile} -o ${wasm_config.outputfile}`
+function emcc(flags, outputfile, cb) {
+    let cmd = `emcc ${flags.join(' ')} ${wasm_config.inputfiles.join(' ')} -o ${outputfile}`
     exec(cmd, (err, stdout, stderr) => {
         if (err) {
             console.error('❌\tCompilation Failed. Did you activated emsdk environment?\n');
             console.error(` $ ${cmd} \nstdout: ${stdout} \nstderr: ${stderr}\n`);
-        } else { console.log("✔\tCompilation successul ") }
-        cb()
+        } else { console.log(`✔\tCompilation successul (${outputfile})`) }
+        cb(err)
+    })
+}
+
+gulp.task('build', (cb) => {
+    let simd = wasm_config.simd_threads
+    emcc(wasm_config.flags, wasm_config.outputfile, (err) => {
+        if (err) return cb(err)
+        emcc(wasm_config.flags.concat(simd.flags), simd.outputfile, (err) => {
+            if (err) return cb(err)
+            gulp.src(['src/dubins_loader.js', 'src/dubins_async.js', 'src/dubins_worker.js']).pipe(gulp.dest('dist/')).on('end', cb)
+        })
     })
 });
 
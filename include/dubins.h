@@ -22,6 +22,9 @@
 #ifndef DUBINS_H
 #define DUBINS_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 typedef enum 
 {
     LSL = 0,
@@ -32,6 +35,34 @@ typedef enum
     LRL = 5
 } DubinsPathType;
 
+/**
+ * Initialiser of the table of words that can be optimal when d >= 4, as bit
+ * masks of DubinsPathType, indexed by the quadrants of alpha and beta
+ *
+ * This is the long path case of Shkel and Lumelsky, "Classification of the
+ * Dubins set" (2001).  dubins.c and dubins.hpp both build their pruning
+ * tables from it.
+ */
+#define DUBINS_LONG_PATH_WORDS { \
+    /* rows are the quadrant of alpha, columns the quadrant of beta */ \
+    { (1u << RSL), \
+      (1u << LSR) | (1u << RSL) | (1u << RSR), \
+      (1u << LSR) | (1u << RSR), \
+      (1u << LSR) | (1u << RSL) | (1u << RSR) }, \
+    { (1u << LSL) | (1u << LSR) | (1u << RSL), \
+      (1u << LSL) | (1u << RSL) | (1u << RSR), \
+      (1u << RSR), \
+      (1u << RSL) | (1u << RSR) }, \
+    { (1u << LSL) | (1u << LSR), \
+      (1u << LSL), \
+      (1u << LSL) | (1u << LSR) | (1u << RSR), \
+      (1u << LSR) | (1u << RSL) | (1u << RSR) }, \
+    { (1u << LSL) | (1u << LSR) | (1u << RSL), \
+      (1u << LSL) | (1u << RSL), \
+      (1u << LSL) | (1u << LSR) | (1u << RSL), \
+      (1u << LSR) } \
+}
+
 typedef struct 
 {
     /* the initial configuration */
@@ -44,11 +75,228 @@ typedef struct
     DubinsPathType type; 
 } DubinsPath;
 
+/**
+ * Single precision counterpart of DubinsPath, see dubins_shortest_path_f
+ */
+typedef struct
+{
+    /* the initial configuration */
+    float qi[3];
+    /* the lengths of the three segments */
+    float param[3];
+    /* model forward velocity / model angular velocity */
+    float rho;
+    /* the path type described */
+    DubinsPathType type;
+} DubinsPathF;
+
+/**
+ * A path stored in 16 bytes, for keeping very many of them
+ *
+ * The segment lengths are rounded to float, and the start configuration and
+ * turning radius are shared through a DubinsNodeTable.  Create packed paths
+ * with dubins_path_pack and read the word and node back with
+ * dubins_packed_path_type and dubins_packed_path_node.
+ */
+typedef struct
+{
+    /* the normalised lengths of the three segments */
+    float param[3];
+    /* bits 0-2 hold the DubinsPathType, bits 3-31 the index of the start node */
+    uint32_t word_node;
+} DubinsPackedPath;
+
+/**
+ * The start configurations referenced by packed paths
+ */
+typedef struct
+{
+    /* 3 * n values, node i is (q[3i], q[3i + 1], q[3i + 2]) */
+    const double* q;
+    /* the number of nodes */
+    size_t n;
+    /* turning radius shared by every path from these nodes */
+    double rho;
+} DubinsNodeTable;
+
+/**
+ * A pair of configurations reduced to the relative pose its paths depend on
+ *
+ * The positions and headings are replaced by the distance between the
+ * positions divided by rho, and each heading measured from the line joining
+ * them.  Reflecting a pair in that line swaps left and right turns (LSL with
+ * RSR, LSR with RSL and RLR with LRL) but keeps every segment length, so
+ * pairs are reflected as needed to bring alpha into [0, pi] and each
+ * reflected pair shares its solution with the original.
+ */
+typedef struct
+{
+    /* start heading relative to the line between the positions, in [0, pi] */
+    double alpha;
+    /* goal heading relative to the line between the positions, in [0, 2pi) */
+    double beta;
+    /* distance between the positions divided by rho */
+    double d;
+    /* non-zero when the pair was reflected, so words must be mirrored back */
+    int mirrored;
+} DubinsCanonicalPair;
+
 #define EDUBOK        (0)   /* No error */
 #define EDUBCOCONFIGS (1)   /* Colocated configurations */
 #define EDUBPARAM     (2)   /* Path parameterisitation error */
 #define EDUBBADRHO    (3)   /* the rho value is invalid */
 #define EDUBNOPATH    (4)   /* no connection between configurations with this word */
+#define EDUBVERIFY    (5)   /* the classified and full word scans disagree */
+#define EDUBIO        (6)   /* a file could not be read or written */
+#define EDUBFORMAT    (7)   /* a file is not in the expected format */
+#define EDUBNOMEM     (8)   /* memory allocation failed */
+
+/**
+ * How dubins_shortest_path_scan chooses which words to evaluate
+ */
+typedef enum
+{
+    /* evaluate all six words */
+    DUBINS_SCAN_FULL       = 0,
+    /* evaluate only the words that can be optimal in the (alpha, beta, d) region */
+    DUBINS_SCAN_CLASSIFIED = 1,
+    /* run both scans and report EDUBVERIFY unless they give identical paths */
+    DUBINS_SCAN_VERIFY     = 2
+} DubinsScanMode;
+
+/**
+ * Structure-of-arrays description of a batch of path queries
+ *
+ * Pair i connects (x0[i], y0[i], th0[i]) to (x1[i], y1[i], th1[i])
+ */
+typedef struct
+{
+    /* the initial configurations */
+    const double* x0;
+    const double* y0;
+    const double* th0;
+    /* the target configurations */
+    const double* x1;
+    const double* y1;
+    const double* th1;
+    /* per-pair turning radii, or NULL to use rho_shared for every pair */
+    const double* rho;
+    /* turning radius used for every pair when rho is NULL */
+    double rho_shared;
+} DubinsBatchInput;
+
+/**
+ * Caller-owned structure-of-arrays results of a batch query
+ *
+ * Every member may be NULL if that output is not wanted
+ */
+typedef struct
+{
+    /* path lengths, INFINITY for pairs that could not be solved */
+    double* length;
+    /* the path type of each result */
+    DubinsPathType* type;
+    /* the normalised lengths of the three segments, one array per segment */
+    double* param[3];
+    /* per-pair error codes */
+    int* errcode;
+} DubinsBatchOutput;
+
+/**
+ * Structure-of-arrays set of configurations, entry i is (x[i], y[i], th[i])
+ */
+typedef struct
+{
+    const double* x;
+    const double* y;
+    const double* th;
+} DubinsConfigSet;
+
+/**
+ * Instruction sets available to the batch solvers
+ */
+typedef enum
+{
+    DUBINS_SIMD_NONE   = 0,
+    DUBINS_SIMD_SSE2   = 1,
+    DUBINS_SIMD_AVX2   = 2,
+    DUBINS_SIMD_AVX512 = 3,
+    DUBINS_SIMD_NEON   = 4,
+    DUBINS_SIMD_WASM   = 5
+} DubinsSimdLevel;
+
+/**
+ * Iterator over fixed-step samples of a path, see dubins_path_sampler_init
+ *
+ * All members are private to the sampler
+ */
+typedef struct
+{
+    DubinsPath path;
+    double step;
+    double length;
+    /* sample k is taken at origin + k * step, index is that of the next sample */
+    double origin;
+    size_t index;
+    /* distance along the path of the next sample */
+    double t;
+    /* the current segment, its start configuration and heading terms */
+    int segment;
+    double qs[3][3];
+    double sin_s[3];
+    double cos_s[3];
+    /* normalised distance at which each segment starts */
+    double start[3];
+    /* direction of the current arc sample, and the rotation of one step */
+    double cu, su;
+    double rc, rs;
+    /* samples since the direction was last evaluated directly */
+    unsigned since_anchor;
+} DubinsPathSampler;
+
+/**
+ * Speed limits of a trajectory along a path, see dubins_trajectory_init
+ *
+ * A lateral acceleration limit a_lat corresponds to an arc speed of
+ * sqrt(a_lat * rho).
+ */
+typedef struct
+{
+    /* top speed on straight segments */
+    double straight_speed;
+    /* top speed on turning segments */
+    double arc_speed;
+    /* largest rate of speeding up */
+    double accel;
+    /* largest rate of slowing down, as a positive number */
+    double decel;
+    /* speed at the start of the path */
+    double start_speed;
+    /* speed at the end of the path */
+    double end_speed;
+} DubinsSpeedProfile;
+
+/**
+ * A path timed by a trapezoidal speed profile, see dubins_trajectory_init
+ *
+ * Each segment is split into an accelerating, a cruising and a decelerating
+ * phase, some of which may be empty.  All members are private to the
+ * trajectory.
+ */
+typedef struct
+{
+    DubinsPath path;
+    double duration;
+    /* start configuration of each segment, normalised and relative to the path start */
+    double qs[3][3];
+    /* normalised distance at which each segment starts */
+    double start[3];
+    /* time, distance, speed and acceleration at the start of each phase */
+    double phase_t[9];
+    double phase_s[9];
+    double phase_v[9];
+    double phase_a[9];
+} DubinsTrajectory;
 
 /**
  * Callback function for path sampling
@@ -60,6 +308,46 @@ typedef struct
  */
 typedef int (*DubinsPathSamplingCallback)(double q[3], double t, void* user_data);
 
+/**
+ * Callback function supplying the waypoints of a route
+ *
+ * @note the q parameter receives the next waypoint configuration
+ * @note the user_data parameter is forwarded from the caller
+ * @note return non-zero once there are no more waypoints
+ */
+typedef int (*DubinsWaypointCallback)(double q[3], void* user_data);
+
+/**
+ * Streaming sampler over the shortest paths through a sequence of
+ * waypoints, see dubins_route_init
+ *
+ * All members are private to the route
+ */
+typedef struct
+{
+    DubinsWaypointCallback next_waypoint;
+    void* user_data;
+    double rho;
+    double step;
+    /* caller-owned ring of solved legs, count of them starting at head */
+    DubinsPath* legs;
+    size_t capacity;
+    size_t head;
+    size_t count;
+    /* the last waypoint taken, whether the waypoints ran out, and why if a leg failed */
+    double last[3];
+    int waypoints_done;
+    int error;
+    /* the leg being sampled and its index */
+    DubinsPathSampler sampler;
+    int sampling;
+    size_t leg;
+    /* route distance at which the current leg starts */
+    double leg_start;
+    /* distance into the next leg of its first sample */
+    double carry;
+} DubinsRoute;
+
 /**
  * Generate a path from an initial configuration to
  * a target configuration, with a specified maximum turning
@@ -76,6 +364,23 @@ typedef int (*DubinsPathSamplingCallback)(double q[3], double t, void* user_data
  */
 int dubins_shortest_path(DubinsPath* path, double q0[3], double q1[3], double rho);
 
+/**
+ * Generate the shortest path, choosing how the candidate words are scanned
+ *
+ * dubins_shortest_path uses DUBINS_SCAN_CLASSIFIED, which skips the CCC words
+ * when the normalised distance is at least 4 and keeps only the CSC words
+ * that can win for the quadrants of the start and goal headings.  The
+ * result is identical to DUBINS_SCAN_FULL, which DUBINS_SCAN_VERIFY checks.
+ *
+ * @param path  - the resultant path
+ * @param q0    - a configuration specified as an array of x, y, theta
+ * @param q1    - a configuration specified as an array of x, y, theta
+ * @param rho   - turning radius of the vehicle (forward velocity divided by maximum angular velocity)
+ * @param mode  - the word scanning strategy
+ * @return      - non-zero on error
+ */
+int dubins_shortest_path_scan(DubinsPath* path, double q0[3], double q1[3], double rho, DubinsScanMode mode);
+
 /**
  * Generate a path with a specified word from an initial configuration to
  * a target configuration, with a specified turning radius 
@@ -89,6 +394,387 @@ int dubins_shortest_path(DubinsPath* path, double q0[3], double q1[3], double rh
  */
 int dubins_path(DubinsPath* path, double q0[3], double q1[3], double rho, DubinsPathType pathType);
 
+/**
+ * Find the shortest path for every pair of a batch of configurations
+ *
+ * Processes the batch in blocks of structure-of-arrays data.  At
+ * DUBINS_SIMD_NONE (see dubins_simd_set_level) the results are exactly those
+ * of calling dubins_shortest_path for each pair.  The vector kernels used by
+ * default approximate atan2 and acos, so lengths and params may differ from
+ * the scalar solver in the last few bits (around a dozen ulp), and a pair
+ * whose two best words tie to within that may report the other word.  Pairs
+ * that cannot be solved get a length of INFINITY, zero params and the type LSL.
+ *
+ * @param in  - the batch of start and goal configurations
+ * @param out - the caller-owned output arrays, each holding at least n entries
+ * @param n   - the number of pairs in the batch
+ * @return    - zero if every pair was solved, otherwise the error code of the first failing pair
+ */
+int dubins_shortest_path_batch(const DubinsBatchInput* in, DubinsBatchOutput* out, size_t n);
+
+/**
+ * Generate a path with a specified word for every pair of a batch
+ *
+ * The batch counterpart of dubins_path, pairs that have no path with this
+ * word report EDUBNOPATH and get a length of INFINITY.
+ *
+ * @param in       - the batch of start and goal configurations
+ * @param out      - the caller-owned output arrays, each holding at least n entries
+ * @param n        - the number of pairs in the batch
+ * @param pathType - the specific path type to use
+ * @return         - zero if every pair was solved, otherwise the error code of the first failing pair
+ */
+int dubins_path_batch(const DubinsBatchInput* in, DubinsBatchOutput* out, size_t n, DubinsPathType pathType);
+
+/**
+ * Find the shortest path for every pair of configurations stored as
+ * consecutive x, y, theta values
+ *
+ * The array-of-structures counterpart of dubins_shortest_path_batch, for
+ * callers (such as the JavaScript binding) that keep configurations and
+ * paths in flat arrays.  Paths that cannot be solved get zero params, the
+ * type LSL and their start configuration and rho as usual.
+ *
+ * @param paths    - caller-owned array of n resultant paths
+ * @param q0s      - 3 * n values, the start configurations
+ * @param q1s      - 3 * n values, the goal configurations
+ * @param rho      - turning radius of the vehicle (forward velocity divided by maximum angular velocity)
+ * @param errcodes - optional caller-owned array of n per-pair error codes, may be NULL
+ * @param n        - the number of pairs
+ * @return         - zero if every pair was solved, otherwise the error code of the first failing pair
+ */
+int dubins_shortest_path_many(DubinsPath* paths, const double* q0s, const double* q1s, double rho,
+                              int* errcodes, size_t n);
+
+/**
+ * Find the shortest path to a goal position over a set of goal headings
+ *
+ * Equivalent to calling dubins_shortest_path for each heading and keeping
+ * the first shortest, but the parts of the problem that do not depend on
+ * the goal heading are computed once and the headings are solved in vector
+ * blocks.
+ *
+ * @param path       - the resultant path
+ * @param q0         - a configuration specified as an array of x, y, theta
+ * @param x1         - the goal x
+ * @param y1         - the goal y
+ * @param headings   - n candidate goal headings
+ * @param n          - the number of candidates, at least 1
+ * @param rho        - turning radius of the vehicle (forward velocity divided by maximum angular velocity)
+ * @param best_index - optional, the index of the heading of the resultant path
+ * @return           - non-zero on error
+ */
+int dubins_shortest_path_headings(DubinsPath* path, double q0[3], double x1, double y1,
+                                  const double* headings, size_t n, double rho, size_t* best_index);
+
+/**
+ * Find the shortest path to a goal position over n evenly spaced goal
+ * headings from heading_min to heading_max inclusive
+ *
+ * @param path         - the resultant path
+ * @param q0           - a configuration specified as an array of x, y, theta
+ * @param x1           - the goal x
+ * @param y1           - the goal y
+ * @param heading_min  - the first candidate heading
+ * @param heading_max  - the last candidate heading
+ * @param n            - the number of candidates, at least 1
+ * @param rho          - turning radius of the vehicle (forward velocity divided by maximum angular velocity)
+ * @param best_heading - optional, the goal heading of the resultant path
+ * @return             - non-zero on error
+ */
+int dubins_shortest_path_heading_range(DubinsPath* path, double q0[3], double x1, double y1,
+                                       double heading_min, double heading_max, size_t n, double rho,
+                                       double* best_heading);
+
+/**
+ * Find the shortest path to a goal position with any goal heading
+ *
+ * The optimum is a turn followed by a straight line or by a turn the other
+ * way (Bui, Boissonnat, Soueres and Laumond, 1994), so it is solved in
+ * closed form.  The result is an LSL or RSR path whose last segment is
+ * empty, or an LRL or RLR path whose last segment is empty, and its final
+ * heading is the optimal goal heading.
+ *
+ * @param path  - the resultant path
+ * @param q0    - a configuration specified as an array of x, y, theta
+ * @param x1    - the goal x
+ * @param y1    - the goal y
+ * @param rho   - turning radius of the vehicle (forward velocity divided by maximum angular velocity)
+ * @return      - non-zero on error
+ */
+int dubins_shortest_path_free_heading(DubinsPath* path, double q0[3], double x1, double y1, double rho);
+
+/**
+ * Find the length of the shortest path between two configurations
+ *
+ * Equivalent to dubins_path_length of the result of dubins_shortest_path,
+ * but never builds the path and skips words that cannot be the shortest.
+ *
+ * @param length - the resultant length
+ * @param q0     - a configuration specified as an array of x, y, theta
+ * @param q1     - a configuration specified as an array of x, y, theta
+ * @param rho    - turning radius of the vehicle (forward velocity divided by maximum angular velocity)
+ * @return       - non-zero on error
+ */
+int dubins_shortest_length(double* length, double q0[3], double q1[3], double rho);
+
+/**
+ * Find the length of the shortest path for every pair of a batch
+ *
+ * @param in       - the batch of start and goal configurations
+ * @param lengths  - caller-owned array of n lengths, INFINITY for pairs that could not be solved
+ * @param errcodes - optional caller-owned array of n per-pair error codes, may be NULL
+ * @param n        - the number of pairs in the batch
+ * @return         - zero if every pair was solved, otherwise the error code of the first failing pair
+ */
+int dubins_shortest_length_batch(const DubinsBatchInput* in, double* lengths, int* errcodes, size_t n);
+
+/**
+ * Reduce a pair of configurations to its canonical relative pose
+ *
+ * Ties at alpha = 0 or alpha = pi, where a reflection keeps alpha, are
+ * settled by bringing beta into [0, pi] as well.
+ *
+ * @param pair - the resultant canonical pair
+ * @param q0   - a configuration specified as an array of x, y, theta
+ * @param q1   - a configuration specified as an array of x, y, theta
+ * @param rho  - turning radius of the vehicle (forward velocity divided by maximum angular velocity)
+ * @return     - non-zero on error
+ */
+int dubins_canonicalize(DubinsCanonicalPair* pair, double q0[3], double q1[3], double rho);
+
+/**
+ * The word a path takes once left and right turns are swapped
+ *
+ * @param pathType - a word
+ * @return         - its mirror image
+ */
+DubinsPathType dubins_mirror_type(DubinsPathType pathType);
+
+/**
+ * Find the shortest word in the canonical frame
+ *
+ * Pairs that are not reflected give exactly the word and segment lengths of
+ * dubins_shortest_path.
+ *
+ * @param pair  - a canonical pair
+ * @param type  - the resultant word, in the canonical frame
+ * @param param - the resultant normalised segment lengths
+ * @return      - non-zero on error
+ */
+int dubins_canonical_shortest(const DubinsCanonicalPair* pair, DubinsPathType* type, double param[3]);
+
+/**
+ * Solve a specific word in the canonical frame
+ *
+ * To solve word w of the original pair, ask for dubins_mirror_type(w) when
+ * the pair is mirrored.
+ *
+ * @param pair     - a canonical pair
+ * @param pathType - the word to use, in the canonical frame
+ * @param param    - the resultant normalised segment lengths
+ * @return         - non-zero on error
+ */
+int dubins_canonical_word(const DubinsCanonicalPair* pair, DubinsPathType pathType, double param[3]);
+
+/**
+ * Turn a solution in the canonical frame back into a path between the
+ * original configurations
+ *
+ * The solution may come from any pair with the same canonical form, for
+ * instance from a cache keyed on (alpha, beta, d).
+ *
+ * @param path  - the resultant path
+ * @param pair  - the canonical form of the pair being solved
+ * @param type  - the word of the solution, in the canonical frame
+ * @param param - the normalised segment lengths of the solution
+ * @param q0    - the start configuration of the pair, specified as an array of x, y, theta
+ * @param rho   - turning radius of the vehicle (forward velocity divided by maximum angular velocity)
+ * @return      - non-zero on error
+ */
+int dubins_canonical_attach(DubinsPath* path, const DubinsCanonicalPair* pair, DubinsPathType type,
+                            const double param[3], double q0[3], double rho);
+
+/**
+ * Find the shortest path from every configuration of one set to every
+ * configuration of another
+ *
+ * Entry i * n_to + j of each output array describes the path from from[i]
+ * to to[j], with the same conventions as dubins_shortest_path_batch.  The
+ * matrix is solved in tiles so each target is reused while it is in cache,
+ * and the sines and cosines of every heading are computed once per tile
+ * rather than per pair, so results may differ from dubins_shortest_path in
+ * the last few bits.
+ *
+ * @param from   - the n_from start configurations
+ * @param n_from - the number of rows
+ * @param to     - the n_to goal configurations
+ * @param n_to   - the number of columns
+ * @param rho    - turning radius of the vehicle (forward velocity divided by maximum angular velocity)
+ * @param out    - the caller-owned row-major output arrays, each holding at least n_from * n_to entries
+ * @return       - zero if every pair was solved, otherwise the error code of the first failing pair
+ */
+int dubins_distance_matrix(const DubinsConfigSet* from, size_t n_from,
+                           const DubinsConfigSet* to, size_t n_to,
+                           double rho, DubinsBatchOutput* out);
+
+/**
+ * Fill rows [row_begin, row_end) of a distance matrix
+ *
+ * Rows are independent, so disjoint row ranges of the same matrix can be
+ * solved concurrently, for instance by the workers of an existing pool.
+ * The output arrays are indexed exactly as for dubins_distance_matrix.
+ *
+ * @param from      - the start configurations, holding at least row_end entries
+ * @param to        - the n_to goal configurations
+ * @param n_to      - the number of columns
+ * @param rho       - turning radius of the vehicle (forward velocity divided by maximum angular velocity)
+ * @param out       - the caller-owned row-major output arrays of the whole matrix
+ * @param row_begin - the first row to solve
+ * @param row_end   - one past the last row to solve
+ * @return          - zero if every pair was solved, otherwise the error code of the first failing pair
+ */
+int dubins_distance_matrix_rows(const DubinsConfigSet* from, const DubinsConfigSet* to, size_t n_to,
+                                double rho, DubinsBatchOutput* out, size_t row_begin, size_t row_end);
+
+/**
+ * A pool of worker threads shared by the parallel batch solvers
+ */
+typedef struct DubinsThreadPool DubinsThreadPool;
+
+/**
+ * Start a thread pool
+ *
+ * The calling thread of each parallel solve acts as one of the workers, so
+ * n_threads - 1 threads are started.  Builds without thread support (such
+ * as single-threaded WebAssembly) give a pool that runs on the caller.
+ *
+ * @param n_threads - the number of workers, or zero for one per processor
+ * @return          - the new pool, or NULL if it could not be created
+ */
+DubinsThreadPool* dubins_thread_pool_create(unsigned n_threads);
+
+/**
+ * Stop the threads of a pool and release it
+ *
+ * @param pool - a pool from dubins_thread_pool_create, may be NULL
+ */
+void dubins_thread_pool_destroy(DubinsThreadPool* pool);
+
+/**
+ * The number of workers of a pool, counting the calling thread
+ *
+ * @param pool - a pool, or NULL which stands for the calling thread alone
+ */
+unsigned dubins_thread_pool_size(const DubinsThreadPool* pool);
+
+/**
+ * dubins_shortest_path_batch spread over the workers of a pool
+ *
+ * The batch is split into chunks of a few blocks which idle workers steal
+ * from busy ones, so uneven workloads stay balanced.  Every output entry and
+ * the returned error code are the same as for dubins_shortest_path_batch,
+ * whatever the number of threads.  Solves on the same pool are serialised.
+ *
+ * @param in   - the batch of start and goal configurations
+ * @param out  - the caller-owned output arrays, each holding at least n entries
+ * @param n    - the number of pairs in the batch
+ * @param pool - the pool to use, or NULL to solve on the calling thread
+ * @return     - zero if every pair was solved, otherwise the error code of the first failing pair
+ */
+int dubins_shortest_path_batch_parallel(const DubinsBatchInput* in, DubinsBatchOutput* out, size_t n,
+                                        DubinsThreadPool* pool);
+
+/**
+ * dubins_path_batch spread over the workers of a pool
+ *
+ * @param in       - the batch of start and goal configurations
+ * @param out      - the caller-owned output arrays, each holding at least n entries
+ * @param n        - the number of pairs in the batch
+ * @param pathType - the specific path type to use
+ * @param pool     - the pool to use, or NULL to solve on the calling thread
+ * @return         - zero if every pair was solved, otherwise the error code of the first failing pair
+ */
+int dubins_path_batch_parallel(const DubinsBatchInput* in, DubinsBatchOutput* out, size_t n,
+                               DubinsPathType pathType, DubinsThreadPool* pool);
+
+/**
+ * dubins_distance_matrix spread over the workers of a pool, in chunks of rows
+ *
+ * @param from   - the n_from start configurations
+ * @param n_from - the number of rows
+ * @param to     - the n_to goal configurations
+ * @param n_to   - the number of columns
+ * @param rho    - turning radius of the vehicle (forward velocity divided by maximum angular velocity)
+ * @param out    - the caller-owned row-major output arrays, each holding at least n_from * n_to entries
+ * @param pool   - the pool to use, or NULL to solve on the calling thread
+ * @return       - zero if every pair was solved, otherwise the error code of the first failing pair
+ */
+int dubins_distance_matrix_parallel(const DubinsConfigSet* from, size_t n_from,
+                                    const DubinsConfigSet* to, size_t n_to,
+                                    double rho, DubinsBatchOutput* out, DubinsThreadPool* pool);
+
+/**
+ * Solver counters gathered by builds with DUBINS_ENABLE_STATS
+ *
+ * Ticks come from the cycle counter where one is available (and are
+ * nanoseconds otherwise), and are only recorded when DUBINS_ENABLE_STATS_TIMING
+ * is also defined.  Vectorised batch solves evaluate words without calling
+ * dubins_word, so they only contribute to wins.
+ */
+typedef struct
+{
+    /* shortest word chosen, indexed by DubinsPathType */
+    uint64_t wins[6];
+    /* dubins_word evaluations, and those that reported EDUBNOPATH */
+    uint64_t word_calls[6];
+    uint64_t word_nopath[6];
+    /* infeasible CSC words (p_sq < 0) and CCC words (|tmp0| > 1) */
+    uint64_t p_sq_rejects;
+    uint64_t acos_rejects;
+    /* words skipped by the classified scan */
+    uint64_t words_pruned;
+    /* dubins_intermediate_results calls and time */
+    uint64_t intermediate_calls;
+    uint64_t intermediate_ticks;
+    /* time spent in the word solvers */
+    uint64_t word_ticks;
+} DubinsStats;
+
+/**
+ * Sum the counters of every thread that has used the library
+ *
+ * Counters are kept per thread, so a snapshot taken while other threads are
+ * solving may be slightly behind them.
+ *
+ * @param stats - the totals
+ * @return      - EDUBPARAM if the library was built without DUBINS_ENABLE_STATS
+ */
+int dubins_stats_snapshot(DubinsStats* stats);
+
+/**
+ * Zero the counters of every thread
+ */
+void dubins_stats_reset(void);
+
+/**
+ * Report the instruction set used by the batch solvers
+ *
+ * Unless overridden with dubins_simd_set_level this is the widest one
+ * supported by the CPU, detected on first use.  Vector kernels use rational
+ * approximations of atan2 and acos, so results may differ from the scalar
+ * solver in the last few bits.
+ */
+DubinsSimdLevel dubins_simd_level(void);
+
+/**
+ * Force the batch solvers to use a specific instruction set
+ *
+ * @param level - DUBINS_SIMD_NONE selects the scalar solver
+ * @return      - non-zero if the level is not supported on this CPU
+ */
+int dubins_simd_set_level(DubinsSimdLevel level);
+
 /**
  * Calculate the length of an initialised path
  *
@@ -141,13 +827,187 @@ int dubins_path_sample(DubinsPath* path, double t, double q[3]);
  * @param cb        - the callback function to call for each sample
  * @param user_data - optional information to pass on to the callback
  *
- * @returns - zero on successful completion, or the result of the callback
+ * @returns - zero on successful completion, EDUBPARAM if stepSize is not positive, or the result of the callback
  */
 int dubins_path_sample_many(DubinsPath* path, 
                             double stepSize, 
                             DubinsPathSamplingCallback cb, 
                             void* user_data);
 
+/**
+ * Prepare to walk along a path at a fixed sampling interval
+ *
+ * The sampler visits the same distances as dubins_path_sample_many, but
+ * computes the segment endpoints once and advances along each arc by
+ * rotating the previous direction by a fixed step.  The direction is
+ * re-evaluated at every segment start and every few dozen samples, so the
+ * drift from dubins_path_sample stays within a few ulps of the path scale.
+ *
+ * @param sampler  - the sampler to initialise
+ * @param path     - the path to sample, copied into the sampler
+ * @param stepSize - the distance along the path for subsequent samples, must be positive
+ * @return         - non-zero on error
+ */
+int dubins_path_sampler_init(DubinsPathSampler* sampler, DubinsPath* path, double stepSize);
+
+/**
+ * Produce the next sample of a path
+ *
+ * @param sampler - an initialised sampler
+ * @param q       - the configuration result
+ * @param t       - optional, the distance along the path of the sample
+ * @return        - EDUBPARAM once the whole path has been sampled, zero otherwise
+ */
+int dubins_path_sampler_next(DubinsPathSampler* sampler, double q[3], double* t);
+
+/**
+ * Write fixed-step samples of a path into caller-owned arrays
+ *
+ * Sample k is taken at the distance k * stepSize along the path.  Writing
+ * starts at sample offset and stops at the end of the path or after cap
+ * samples, so a long path can be sampled in pieces by advancing offset by
+ * the count returned.  With offset zero the samples are those of
+ * dubins_path_sample_many.
+ *
+ * @param path     - the path to sample
+ * @param stepSize - the distance along the path for subsequent samples, must be positive
+ * @param xs       - optional, at least cap x coordinates
+ * @param ys       - optional, at least cap y coordinates
+ * @param ths      - optional, at least cap headings
+ * @param ts       - optional, at least cap distances along the path
+ * @param cap      - the capacity of the arrays
+ * @param offset   - the index of the first sample to write
+ * @return         - the number of samples written, zero if stepSize is not positive
+ */
+size_t dubins_path_sample_into(DubinsPath* path, double stepSize,
+                               double* xs, double* ys, double* ths, double* ts,
+                               size_t cap, size_t offset);
+
+/**
+ * As dubins_path_sample_into, writing each sample as consecutive x, y, theta
+ *
+ * @param path     - the path to sample
+ * @param stepSize - the distance along the path for subsequent samples, must be positive
+ * @param qs       - at least 3 * cap values
+ * @param ts       - optional, at least cap distances along the path
+ * @param cap      - the capacity of the arrays, in samples
+ * @param offset   - the index of the first sample to write
+ * @return         - the number of samples written, zero if stepSize is not positive
+ */
+size_t dubins_path_sample_into_interleaved(DubinsPath* path, double stepSize,
+                                           double* qs, double* ts, size_t cap, size_t offset);
+
+/**
+ * Prepare to sample the shortest paths through a sequence of waypoints
+ *
+ * Legs are solved lazily, at most `lookahead` ahead of the leg being
+ * sampled, into the caller's ring of legs, so memory stays bounded however
+ * long the route is.  Samples are spaced stepSize apart along the whole
+ * route rather than restarting at every waypoint.
+ *
+ * @param route         - the route to initialise
+ * @param next_waypoint - called for each waypoint in turn, starting with the first
+ * @param user_data     - optional information to pass on to next_waypoint
+ * @param rho           - turning radius of the vehicle (forward velocity divided by maximum angular velocity)
+ * @param stepSize      - the distance along the route between samples, must be positive
+ * @param legs          - caller-owned storage for lookahead legs, which must outlive the route
+ * @param lookahead     - the number of legs solved ahead, at least 1
+ * @return              - non-zero on error
+ */
+int dubins_route_init(DubinsRoute* route, DubinsWaypointCallback next_waypoint, void* user_data,
+                      double rho, double stepSize, DubinsPath* legs, size_t lookahead);
+
+/**
+ * Produce the next sample of a route
+ *
+ * The samples are at distances 0, stepSize, 2 * stepSize ... short of the
+ * total length of the route, as dubins_path_sample_many does for one path.
+ *
+ * @param route - an initialised route
+ * @param q     - the configuration result
+ * @param s     - optional, the distance along the route of the sample
+ * @return      - EDUBPARAM once the whole route has been sampled, or the error
+ *                of the first leg that could not be solved (such as one to a
+ *                waypoint that is not finite) once the legs before it have
+ *                been sampled, zero otherwise
+ */
+int dubins_route_next(DubinsRoute* route, double q[3], double* s);
+
+/**
+ * The index of the leg holding the last sample, leg i ends at waypoint i + 1
+ *
+ * @param route - an initialised route
+ */
+size_t dubins_route_leg(const DubinsRoute* route);
+
+/**
+ * Time a path with a trapezoidal speed profile
+ *
+ * The speed never exceeds the limit of the segment it is on, changes at no
+ * more than accel and decel, and is as high as those allow everywhere.  A
+ * start or end speed above the limit of the first or last segment is
+ * lowered to it, and a start speed is also lowered if the path is too short
+ * to slow down to the end speed (and likewise the end speed).
+ *
+ * @param traj    - the trajectory to initialise
+ * @param path    - an initialised path, copied into the trajectory
+ * @param profile - the speed limits, all positive except the start and end speeds which may be zero
+ * @return        - EDUBPARAM if the profile is invalid
+ */
+int dubins_trajectory_init(DubinsTrajectory* traj, DubinsPath* path, const DubinsSpeedProfile* profile);
+
+/**
+ * The time taken to follow a trajectory to its end
+ *
+ * @param traj - an initialised trajectory
+ * @return     - the duration
+ */
+double dubins_trajectory_duration(const DubinsTrajectory* traj);
+
+/**
+ * Find where a trajectory is at a given time
+ *
+ * @param traj  - an initialised trajectory
+ * @param t     - the time since the start, where 0 <= t <= dubins_trajectory_duration(traj)
+ * @param q     - the configuration result
+ * @param s     - optional, the distance along the path
+ * @param speed - optional, the speed
+ * @return      - EDUBPARAM if t is out of range
+ */
+int dubins_trajectory_sample(const DubinsTrajectory* traj, double t, double q[3], double* s, double* speed);
+
+/**
+ * Find when a trajectory reaches a given distance along its path
+ *
+ * @param traj - an initialised trajectory
+ * @param s    - the distance, where 0 <= s <= dubins_path_length of the path
+ * @param t    - the time result
+ * @return     - EDUBPARAM if s is out of range
+ */
+int dubins_trajectory_time_at(const DubinsTrajectory* traj, double s, double* t);
+
+/**
+ * Write samples of a trajectory at fixed time steps into caller-owned arrays
+ *
+ * Sample k is taken at the time k * dt.  Writing starts at sample offset and
+ * stops at the end of the trajectory or after cap samples, as for
+ * dubins_path_sample_into.
+ *
+ * @param traj   - an initialised trajectory
+ * @param dt     - the time between samples, must be positive
+ * @param xs     - optional, at least cap x coordinates
+ * @param ys     - optional, at least cap y coordinates
+ * @param ths    - optional, at least cap headings
+ * @param ss     - optional, at least cap distances along the path
+ * @param speeds - optional, at least cap speeds
+ * @param cap    - the capacity of the arrays
+ * @param offset - the index of the first sample to write
+ * @return       - the number of samples written, zero if dt is not positive
+ */
+size_t dubins_trajectory_sample_into(const DubinsTrajectory* traj, double dt,
+                                     double* xs, double* ys, double* ths, double* ss, double* speeds,
+                                     size_t cap, size_t offset);
+
 /**
  * Convenience function to identify the endpoint of a path
  *
@@ -165,6 +1025,180 @@ int dubins_path_endpoint(DubinsPath* path, double q[3]);
  */
 int dubins_extract_subpath(DubinsPath* path, double t, DubinsPath* newpath);
 
+/**
+ * Extract the part of a path between two lengths without solving again
+ *
+ * The new path starts at the configuration dubins_path_sample gives for t0
+ * and keeps the word of the original, with the segments before the window
+ * shrunk to zero length, so sampling it at t gives the original at t0 + t.
+ *
+ * @param path    - an initialised path
+ * @param t0      - the start of the window, where 0 <= t0 <= t1
+ * @param t1      - the end of the window, where t1 <= dubins_path_length(path)
+ * @param newpath - the resultant path
+ * @return        - EDUBPARAM if the window is out of range
+ */
+int dubins_extract_window(DubinsPath* path, double t0, double t1, DubinsPath* newpath);
+
+/**
+ * Extract the part of a path after a given length, see dubins_extract_window
+ *
+ * @param path    - an initialised path
+ * @param t       - a length measure, where 0 <= t <= dubins_path_length(path)
+ * @param newpath - the resultant path
+ * @return        - EDUBPARAM if t is out of range
+ */
+int dubins_extract_suffix(DubinsPath* path, double t, DubinsPath* newpath);
+
+/**
+ * Extract a window of every path of an array, see dubins_extract_window
+ *
+ * Paths whose window is out of range are not written.
+ *
+ * @param paths    - n initialised paths
+ * @param t0s      - n window starts
+ * @param t1s      - n window ends
+ * @param newpaths - caller-owned array of n resultant paths, which may be paths itself
+ * @param errcodes - optional caller-owned array of n per-path error codes, may be NULL
+ * @param n        - the number of paths
+ * @return         - zero if every window was extracted, otherwise the error code of the first failing one
+ */
+int dubins_extract_windows(DubinsPath* paths, const double* t0s, const double* t1s,
+                           DubinsPath* newpaths, int* errcodes, size_t n);
+
+/**
+ * Join two paths into one, where the second starts where the first ends
+ *
+ * This puts back together windows cut from one path, or any pair of paths
+ * whose segments, after merging the segments that meet at the join when
+ * they turn the same way, still form a single word.
+ *
+ * @param first   - an initialised path
+ * @param second  - an initialised path with the same rho, starting within
+ *                  1e-9 * (rho + both lengths) and 1e-9 radians of the end of first
+ * @param newpath - the resultant path, which may be first or second
+ * @return        - EDUBPARAM if the paths do not meet, EDUBNOPATH if no word describes the join
+ */
+int dubins_path_splice(DubinsPath* first, DubinsPath* second, DubinsPath* newpath);
+
+/**
+ * Store a path in the packed format
+ *
+ * The start configuration and rho of the path are not stored, the caller
+ * keeps them as node `node` of the table used to unpack it.  Rounding the
+ * segment lengths to float moves the end of the path by about 1e-7 of its
+ * length.
+ *
+ * @param path   - an initialised path
+ * @param node   - index of the path's start configuration in the node table, below 2^29
+ * @param packed - the packed result
+ * @return       - EDUBPARAM if node does not fit
+ */
+int dubins_path_pack(const DubinsPath* path, uint32_t node, DubinsPackedPath* packed);
+
+/**
+ * Rebuild a full path from its packed form
+ *
+ * @param packed - a packed path
+ * @param nodes  - the node table the path was packed against
+ * @param path   - the resultant path
+ * @return       - EDUBPARAM if the node index is outside the table
+ */
+int dubins_path_unpack(const DubinsPackedPath* packed, const DubinsNodeTable* nodes, DubinsPath* path);
+
+/**
+ * The node index of the start configuration of a packed path
+ */
+uint32_t dubins_packed_path_node(const DubinsPackedPath* packed);
+
+/**
+ * The word of a packed path
+ */
+DubinsPathType dubins_packed_path_type(const DubinsPackedPath* packed);
+
+/**
+ * Calculate the length of a packed path
+ *
+ * @param packed - a packed path
+ * @param rho    - the turning radius of its node table
+ */
+double dubins_packed_path_length(const DubinsPackedPath* packed, double rho);
+
+/**
+ * Calculate the configuration along a packed path, as dubins_path_sample
+ *
+ * @param packed - a packed path
+ * @param nodes  - the node table the path was packed against
+ * @param t      - a length measure, where 0 <= t <= dubins_packed_path_length(packed, nodes->rho)
+ * @param q      - the configuration result
+ * @return       - non-zero if the node or 't' is out of range
+ */
+int dubins_packed_path_sample(const DubinsPackedPath* packed, const DubinsNodeTable* nodes,
+                              double t, double q[3]);
+
+/**
+ * Single precision variant of dubins_shortest_path
+ *
+ * Every word is solved in float arithmetic, mirroring the scalar double
+ * solver.  On one x86-64 host, benchmarks/stress_dubins measured about 1.17
+ * times the throughput of dubins_shortest_path.  Over the unit tests'
+ * configurations (rho = 1, distances up to 10) the length stays within
+ * 1e-5 * (1 + length) of the double result, and samples within 1e-4 of the
+ * double path.  Near ties
+ * between words and near-infeasible words may pick a different word than
+ * the double solver, of practically the same length.
+ *
+ * @param path  - the resultant path
+ * @param q0    - a configuration specified as an array of x, y, theta
+ * @param q1    - a configuration specified as an array of x, y, theta
+ * @param rho   - turning radius of the vehicle (forward velocity divided by maximum angular velocity)
+ * @return      - non-zero on error
+ */
+int dubins_shortest_path_f(DubinsPathF* path, float q0[3], float q1[3], float rho);
+
+/**
+ * Single precision variant of dubins_path
+ *
+ * @param path     - the resultant path
+ * @param q0       - a configuration specified as an array of x, y, theta
+ * @param q1       - a configuration specified as an array of x, y, theta
+ * @param rho      - turning radius of the vehicle (forward velocity divided by maximum angular velocity)
+ * @param pathType - the specific path type to use
+ * @return         - non-zero on error
+ */
+int dubins_path_f(DubinsPathF* path, float q0[3], float q1[3], float rho, DubinsPathType pathType);
+
+/**
+ * Single precision variant of dubins_shortest_path_many
+ *
+ * @param paths    - caller-owned array of n resultant paths
+ * @param q0s      - 3 * n values, the start configurations
+ * @param q1s      - 3 * n values, the goal configurations
+ * @param rho      - turning radius of the vehicle (forward velocity divided by maximum angular velocity)
+ * @param errcodes - optional caller-owned array of n per-pair error codes, may be NULL
+ * @param n        - the number of pairs
+ * @return         - zero if every pair was solved, otherwise the error code of the first failing pair
+ */
+int dubins_shortest_path_many_f(DubinsPathF* paths, const float* q0s, const float* q1s, float rho,
+                                int* errcodes, size_t n);
+
+/**
+ * Calculate the length of an initialised single precision path
+ *
+ * @param path - the path to find the length of
+ */
+float dubins_path_length_f(DubinsPathF* path);
+
+/**
+ * Single precision variant of dubins_path_sample
+ *
+ * @param path - an initialised path
+ * @param t    - a length measure, where 0 <= t <= dubins_path_length_f(path)
+ * @param q    - the configuration result
+ * @returns    - non-zero if 't' is not in the correct range
+ */
+int dubins_path_sample_f(DubinsPathF* path, float t, float q[3]);
+
 
 #endif /* DUBINS_H */
 
@@ -0,0 +1,600 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef DUBINS_HPP
+#define DUBINS_HPP
+
+/*
+ * Header-only C++17 front end to the solver.
+ *
+ * Everything here is a template over the floating point type, and the single
+ * word solvers are also templates over the DubinsPathType, so a caller that
+ * knows its word at compile time gets a fully inlined solve with no switch or
+ * table lookup.  In double precision every result is bit-for-bit the value
+ * src/dubins.c computes, provided both are built without floating point
+ * contraction (-ffp-contract=off, or a target without FMA).
+ *
+ * The turning radius is either a runtime value or a fixed_radius, which folds
+ * 1/rho into a compile time constant.  Multiplying by the folded inverse is
+ * exact only when rho is a power of two, so that is the case in which fixed
+ * radius results stay bit-compatible with the C library.
+ */
+
+#include <cmath>
+
+extern "C" {
+#include "dubins.h"
+}
+
+namespace dubins {
+
+enum class segment : unsigned char
+{
+    left     = 0,
+    straight = 1,
+    right    = 2
+};
+
+/* The segment types for each of the path types, matching DIRDATA */
+constexpr segment segments[6][3] = {
+    { segment::left,  segment::straight, segment::left  },
+    { segment::left,  segment::straight, segment::right },
+    { segment::right, segment::straight, segment::left  },
+    { segment::right, segment::straight, segment::right },
+    { segment::right, segment::left,     segment::right },
+    { segment::left,  segment::right,    segment::left  }
+};
+
+template <DubinsPathType W>
+struct word_traits
+{
+    static_assert(W >= LSL && W <= LRL, "not a Dubins word");
+    static constexpr segment first  = segments[W][0];
+    static constexpr segment second = segments[W][1];
+    static constexpr segment third  = segments[W][2];
+    /* CCC words are the ones that can fail the acos domain test */
+    static constexpr bool ccc = (second != segment::straight);
+};
+
+/* Word sets, bit i stands for DubinsPathType i */
+constexpr unsigned word_bit(DubinsPathType w) { return 1u << w; }
+constexpr unsigned all_words = 0x3fu;
+
+template <typename T>
+constexpr T pi = T(3.14159265358979323846);
+
+/**
+ * Floating point modulus suitable for rings
+ */
+template <typename T>
+inline T fmodr(T x, T y)
+{
+    return x - y*std::floor(x/y);
+}
+
+template <typename T>
+inline T mod2pi(T theta)
+{
+    return fmodr(theta, T(2 * pi<double>));
+}
+
+/**
+ * A turning radius only known at runtime
+ */
+template <typename T>
+struct runtime_radius
+{
+    T rho;
+
+    constexpr T value() const { return rho; }
+    constexpr bool valid() const { return rho > T(0); }
+    /* divide a length by the radius */
+    constexpr T normalise(T length) const { return length / rho; }
+};
+
+/**
+ * A turning radius of Num / Den fixed at compile time
+ *
+ * Normalising multiplies by the folded inverse instead of dividing.
+ */
+template <typename T, long Num, long Den = 1>
+struct fixed_radius
+{
+    static_assert(Num > 0 && Den > 0, "the turning radius must be positive");
+    static constexpr T rho     = T(Num) / T(Den);
+    static constexpr T inverse = T(Den) / T(Num);
+
+    constexpr T value() const { return rho; }
+    constexpr bool valid() const { return true; }
+    constexpr T normalise(T length) const { return length * inverse; }
+};
+
+template <typename T>
+struct intermediate
+{
+    T alpha;
+    T beta;
+    T d;
+    T sa;
+    T sb;
+    T ca;
+    T cb;
+    T c_ab;
+    T d_sq;
+};
+
+/**
+ * A path, laid out like DubinsPath when T is double
+ */
+template <typename T>
+struct path
+{
+    /* the initial configuration */
+    T qi[3];
+    /* the lengths of the three segments */
+    T param[3];
+    /* model forward velocity / model angular velocity */
+    T rho;
+    /* the path type described */
+    DubinsPathType type;
+
+    T length() const
+    {
+        T length = param[0];
+        length += param[1];
+        length += param[2];
+        return length * rho;
+    }
+};
+
+inline DubinsPath to_c(const path<double>& p)
+{
+    DubinsPath out;
+    int i;
+    for(i = 0; i < 3; i++) {
+        out.qi[i] = p.qi[i];
+        out.param[i] = p.param[i];
+    }
+    out.rho = p.rho;
+    out.type = p.type;
+    return out;
+}
+
+inline path<double> from_c(const DubinsPath& p)
+{
+    path<double> out;
+    int i;
+    for(i = 0; i < 3; i++) {
+        out.qi[i] = p.qi[i];
+        out.param[i] = p.param[i];
+    }
+    out.rho = p.rho;
+    out.type = p.type;
+    return out;
+}
+
+template <typename T, typename Radius>
+inline int intermediate_results(intermediate<T>& in, const T q0[3], const T q1[3], const Radius& radius)
+{
+    T dx, dy, D, d, theta, alpha, beta;
+    if(!radius.valid()) {
+        return EDUBBADRHO;
+    }
+
+    dx = q1[0] - q0[0];
+    dy = q1[1] - q0[1];
+    D = std::sqrt( dx * dx + dy * dy );
+    d = radius.normalise(D);
+    theta = 0;
+
+    /* test required to prevent domain errors if dx=0 and dy=0 */
+    if(d > 0) {
+        theta = mod2pi(std::atan2( dy, dx ));
+    }
+    alpha = mod2pi(q0[2] - theta);
+    beta  = mod2pi(q1[2] - theta);
+
+    in.alpha = alpha;
+    in.beta  = beta;
+    in.d     = d;
+    in.sa    = std::sin(alpha);
+    in.sb    = std::sin(beta);
+    in.ca    = std::cos(alpha);
+    in.cb    = std::cos(beta);
+    in.c_ab  = std::cos(alpha - beta);
+    in.d_sq  = d * d;
+    return EDUBOK;
+}
+
+template <typename T>
+inline int intermediate_results(intermediate<T>& in, const T q0[3], const T q1[3], T rho)
+{
+    return intermediate_results(in, q0, q1, runtime_radius<T>{ rho });
+}
+
+/**
+ * Solve a single word, the expressions mirror dubins_LSL .. dubins_LRL
+ *
+ * @return - EDUBNOPATH if the word cannot connect the configurations
+ */
+template <DubinsPathType W, typename T>
+inline int word(const intermediate<T>& in, T out[3])
+{
+    static_assert(W >= LSL && W <= LRL, "not a Dubins word");
+    if constexpr(W == LSL) {
+        T tmp0 = in.d + in.sa - in.sb;
+        T p_sq = T(2) + in.d_sq - (T(2)*in.c_ab) + (T(2) * in.d * (in.sa - in.sb));
+        if(p_sq >= 0) {
+            T tmp1 = std::atan2( (in.cb - in.ca), tmp0 );
+            out[0] = mod2pi(tmp1 - in.alpha);
+            out[1] = std::sqrt(p_sq);
+            out[2] = mod2pi(in.beta - tmp1);
+            return EDUBOK;
+        }
+    }
+    else if constexpr(W == RSR) {
+        T tmp0 = in.d - in.sa + in.sb;
+        T p_sq = T(2) + in.d_sq - (T(2) * in.c_ab) + (T(2) * in.d * (in.sb - in.sa));
+        if(p_sq >= 0) {
+            T tmp1 = std::atan2( (in.ca - in.cb), tmp0 );
+            out[0] = mod2pi(in.alpha - tmp1);
+            out[1] = std::sqrt(p_sq);
+            out[2] = mod2pi(tmp1 - in.beta);
+            return EDUBOK;
+        }
+    }
+    else if constexpr(W == LSR) {
+        T p_sq = T(-2) + (in.d_sq) + (T(2) * in.c_ab) + (T(2) * in.d * (in.sa + in.sb));
+        if(p_sq >= 0) {
+            T p    = std::sqrt(p_sq);
+            T tmp0 = std::atan2( (-in.ca - in.cb), (in.d + in.sa + in.sb) ) - std::atan2(T(-2), p);
+            out[0] = mod2pi(tmp0 - in.alpha);
+            out[1] = p;
+            out[2] = mod2pi(tmp0 - mod2pi(in.beta));
+            return EDUBOK;
+        }
+    }
+    else if constexpr(W == RSL) {
+        T p_sq = T(-2) + in.d_sq + (T(2) * in.c_ab) - (T(2) * in.d * (in.sa + in.sb));
+        if(p_sq >= 0) {
+            T p    = std::sqrt(p_sq);
+            T tmp0 = std::atan2( (in.ca + in.cb), (in.d - in.sa - in.sb) ) - std::atan2(T(2), p);
+            out[0] = mod2pi(in.alpha - tmp0);
+            out[1] = p;
+            out[2] = mod2pi(in.beta - tmp0);
+            return EDUBOK;
+        }
+    }
+    else if constexpr(W == RLR) {
+        T tmp0 = (T(6) - in.d_sq + T(2)*in.c_ab + T(2)*in.d*(in.sa - in.sb)) / T(8);
+        T phi  = std::atan2( in.ca - in.cb, in.d - in.sa + in.sb );
+        if(std::fabs(tmp0) <= 1) {
+            T p = mod2pi(T(2 * pi<double>) - std::acos(tmp0) );
+            T t = mod2pi(in.alpha - phi + mod2pi(p/T(2)));
+            out[0] = t;
+            out[1] = p;
+            out[2] = mod2pi(in.alpha - in.beta - t + mod2pi(p));
+            return EDUBOK;
+        }
+    }
+    else {
+        T tmp0 = (T(6) - in.d_sq + T(2)*in.c_ab + T(2)*in.d*(in.sb - in.sa)) / T(8);
+        T phi  = std::atan2( in.ca - in.cb, in.d + in.sa - in.sb );
+        if(std::fabs(tmp0) <= 1) {
+            T p = mod2pi( T(2 * pi<double>) - std::acos( tmp0) );
+            T t = mod2pi(-in.alpha - phi + p/T(2));
+            out[0] = t;
+            out[1] = p;
+            out[2] = mod2pi(mod2pi(in.beta) - in.alpha - t + mod2pi(p));
+            return EDUBOK;
+        }
+    }
+    return EDUBNOPATH;
+}
+
+/**
+ * Solve a word chosen at runtime
+ */
+template <typename T>
+inline int word(const intermediate<T>& in, DubinsPathType pathType, T out[3])
+{
+    switch(pathType)
+    {
+    case LSL:
+        return word<LSL>(in, out);
+    case LSR:
+        return word<LSR>(in, out);
+    case RSL:
+        return word<RSL>(in, out);
+    case RSR:
+        return word<RSR>(in, out);
+    case RLR:
+        return word<RLR>(in, out);
+    case LRL:
+        return word<LRL>(in, out);
+    }
+    return EDUBNOPATH;
+}
+
+namespace detail {
+
+/* angles closer than this to a quadrant boundary are not classified */
+template <typename T>
+constexpr T quadrant_margin = T(1e-6);
+
+template <typename T>
+inline int quadrant(T angle)
+{
+    T step = pi<T> / 2;
+    int q = (int)std::floor(angle / step);
+    T r = angle - T(q) * step;
+    if(q < 0 || q > 3 || r < quadrant_margin<T> || step - r < quadrant_margin<T>) {
+        return -1;
+    }
+    return q;
+}
+
+constexpr unsigned W_LSL = 1u << LSL;
+constexpr unsigned W_LSR = 1u << LSR;
+constexpr unsigned W_RSL = 1u << RSL;
+constexpr unsigned W_RSR = 1u << RSR;
+constexpr unsigned csc_words = W_LSL | W_LSR | W_RSL | W_RSR;
+
+/* Long path candidates, the table of dubins.c */
+constexpr unsigned long_path_words[4][4] = DUBINS_LONG_PATH_WORDS;
+
+template <int I, typename T>
+inline void scan_word(const intermediate<T>& in, unsigned words, path<T>& out,
+                      T& best_cost, bool& found)
+{
+    constexpr DubinsPathType W = (DubinsPathType)I;
+    T params[3];
+    T cost;
+    if((words & word_bit(W)) != 0 && word<W>(in, params) == EDUBOK) {
+        cost = params[0] + params[1] + params[2];
+        if(cost < best_cost) {
+            found = true;
+            best_cost = cost;
+            out.param[0] = params[0];
+            out.param[1] = params[1];
+            out.param[2] = params[2];
+            out.type = W;
+        }
+    }
+}
+
+template <segment S, typename T>
+inline void segment_end(T t, const T qi[3], T qt[3])
+{
+    T st = std::sin(qi[2]);
+    T ct = std::cos(qi[2]);
+    if constexpr(S == segment::left) {
+        qt[0] = +std::sin(qi[2]+t) - st;
+        qt[1] = -std::cos(qi[2]+t) + ct;
+        qt[2] = t;
+    }
+    else if constexpr(S == segment::right) {
+        qt[0] = -std::sin(qi[2]-t) + st;
+        qt[1] = +std::cos(qi[2]-t) - ct;
+        qt[2] = -t;
+    }
+    else {
+        qt[0] = ct * t;
+        qt[1] = st * t;
+        qt[2] = T(0);
+    }
+    qt[0] += qi[0];
+    qt[1] += qi[1];
+    qt[2] += qi[2];
+}
+
+} /* namespace detail */
+
+/**
+ * The words that can be optimal for these intermediate results
+ *
+ * Same classification as dubins_candidate_words.
+ */
+template <typename T>
+inline unsigned candidate_words(const intermediate<T>& in)
+{
+    int qa, qb;
+    if(in.d < T(4)) {
+        return all_words;
+    }
+    qa = detail::quadrant(in.alpha);
+    qb = detail::quadrant(in.beta);
+    if(qa < 0 || qb < 0) {
+        return detail::csc_words;
+    }
+    return detail::long_path_words[qa][qb];
+}
+
+/**
+ * Find the shortest path over the given word set
+ *
+ * Words are tried in DubinsPathType order and only a strictly shorter word
+ * replaces the current best, as in dubins_shortest_path.
+ */
+template <typename T>
+inline int shortest_path(path<T>& out, const intermediate<T>& in, unsigned words)
+{
+    T best_cost = T(INFINITY);
+    bool found = false;
+    detail::scan_word<LSL>(in, words, out, best_cost, found);
+    detail::scan_word<LSR>(in, words, out, best_cost, found);
+    detail::scan_word<RSL>(in, words, out, best_cost, found);
+    detail::scan_word<RSR>(in, words, out, best_cost, found);
+    detail::scan_word<RLR>(in, words, out, best_cost, found);
+    detail::scan_word<LRL>(in, words, out, best_cost, found);
+    return found ? EDUBOK : EDUBNOPATH;
+}
+
+/**
+ * Generate the shortest path between two configurations
+ *
+ * @param out    - the resultant path
+ * @param q0     - a configuration specified as an array of x, y, theta
+ * @param q1     - a configuration specified as an array of x, y, theta
+ * @param radius - a runtime_radius, a fixed_radius or a plain turning radius
+ * @return       - non-zero on error
+ */
+template <typename T, typename Radius>
+inline int shortest_path(path<T>& out, const T q0[3], const T q1[3], const Radius& radius)
+{
+    intermediate<T> in;
+    int errcode = intermediate_results(in, q0, q1, radius);
+    if(errcode != EDUBOK) {
+        return errcode;
+    }
+    out.qi[0] = q0[0];
+    out.qi[1] = q0[1];
+    out.qi[2] = q0[2];
+    out.rho = radius.value();
+    return shortest_path(out, in, candidate_words(in));
+}
+
+template <typename T>
+inline int shortest_path(path<T>& out, const T q0[3], const T q1[3], T rho)
+{
+    return shortest_path(out, q0, q1, runtime_radius<T>{ rho });
+}
+
+/**
+ * Generate a path with the word W between two configurations
+ *
+ * @return - EDUBNOPATH if W cannot connect the configurations
+ */
+template <DubinsPathType W, typename T, typename Radius>
+inline int solve(path<T>& out, const T q0[3], const T q1[3], const Radius& radius)
+{
+    intermediate<T> in;
+    T params[3];
+    int errcode = intermediate_results(in, q0, q1, radius);
+    if(errcode == EDUBOK) {
+        errcode = word<W>(in, params);
+        if(errcode == EDUBOK) {
+            out.param[0] = params[0];
+            out.param[1] = params[1];
+            out.param[2] = params[2];
+            out.qi[0] = q0[0];
+            out.qi[1] = q0[1];
+            out.qi[2] = q0[2];
+            out.rho = radius.value();
+            out.type = W;
+        }
+    }
+    return errcode;
+}
+
+template <DubinsPathType W, typename T>
+inline int solve(path<T>& out, const T q0[3], const T q1[3], T rho)
+{
+    return solve<W>(out, q0, q1, runtime_radius<T>{ rho });
+}
+
+/**
+ * Calculate the configuration along a path of the word W
+ *
+ * @param p - a path where p.type == W
+ * @param t - a length measure, where 0 <= t <= p.length()
+ * @param q - the configuration result
+ * @return  - non-zero if 't' is not in the correct range
+ */
+template <DubinsPathType W, typename T, typename Radius>
+inline int sample(const path<T>& p, T t, T q[3], const Radius& radius)
+{
+    typedef word_traits<W> traits;
+    /* tprime is the normalised variant of the parameter t */
+    T tprime = radius.normalise(t);
+    T qi[3];
+    T q1[3];
+    T q2[3];
+    T p1, p2;
+
+    if(t < 0 || t > p.length()) {
+        return EDUBPARAM;
+    }
+
+    qi[0] = T(0);
+    qi[1] = T(0);
+    qi[2] = p.qi[2];
+
+    p1 = p.param[0];
+    p2 = p.param[1];
+    detail::segment_end<traits::first>(p1, qi, q1);
+    detail::segment_end<traits::second>(p2, q1, q2);
+    if(tprime < p1) {
+        detail::segment_end<traits::first>(tprime, qi, q);
+    }
+    else if(tprime < (p1+p2)) {
+        detail::segment_end<traits::second>(tprime-p1, q1, q);
+    }
+    else {
+        detail::segment_end<traits::third>(tprime-p1-p2, q2, q);
+    }
+
+    /* scale the target configuration, translate back to the original starting point */
+    q[0] = q[0] * radius.value() + p.qi[0];
+    q[1] = q[1] * radius.value() + p.qi[1];
+    q[2] = mod2pi(q[2]);
+    return EDUBOK;
+}
+
+template <DubinsPathType W, typename T>
+inline int sample(const path<T>& p, T t, T q[3])
+{
+    return sample<W>(p, t, q, runtime_radius<T>{ p.rho });
+}
+
+/**
+ * Calculate the configuration along a path whose word is only known at runtime
+ */
+template <typename T, typename Radius>
+inline int sample(const path<T>& p, T t, T q[3], const Radius& radius)
+{
+    switch(p.type)
+    {
+    case LSL:
+        return sample<LSL>(p, t, q, radius);
+    case LSR:
+        return sample<LSR>(p, t, q, radius);
+    case RSL:
+        return sample<RSL>(p, t, q, radius);
+    case RSR:
+        return sample<RSR>(p, t, q, radius);
+    case RLR:
+        return sample<RLR>(p, t, q, radius);
+    case LRL:
+        return sample<LRL>(p, t, q, radius);
+    }
+    return EDUBPARAM;
+}
+
+template <typename T>
+inline int sample(const path<T>& p, T t, T q[3])
+{
+    return sample(p, t, q, runtime_radius<T>{ p.rho });
+}
+
+} /* namespace dubins */
+
+#endif /* DUBINS_HPP */
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef DUBINS_CACHE_H
+#define DUBINS_CACHE_H
+
+#include "dubins.h"
+
+#include <stdint.h>
+
+/**
+ * A bounded, thread-safe memo of solved paths
+ *
+ * Pairs are keyed by their configurations, rounded down to a grid of the
+ * given tolerance (with headings taken modulo 2pi first) when it is non-zero,
+ * plus the exact turning radius and the requested word.  Entries live in
+ * sets of 8 slots and each set evicts with the CLOCK algorithm.  Any thread
+ * may look up and insert at the same time; lookups take no locks, and an
+ * insertion that races another writer on the same slot is simply dropped.
+ */
+typedef struct DubinsPathCache DubinsPathCache;
+
+/**
+ * Counters of a cache since it was created or last cleared
+ */
+typedef struct
+{
+    /* lookups answered from the cache */
+    uint64_t hits;
+    /* lookups that called the solver */
+    uint64_t misses;
+    /* results stored after a miss */
+    uint64_t insertions;
+    /* insertions that replaced another result */
+    uint64_t evictions;
+} DubinsPathCacheStats;
+
+/**
+ * Create an empty cache
+ *
+ * With a tolerance of zero only bit-identical configurations share an entry.
+ * Otherwise every pair whose coordinates fall in the same tolerance cell is
+ * given the path solved for the first of them, with its start replaced by
+ * the caller's q0.
+ *
+ * @param capacity  - the number of entries, rounded up to a power of two of at least 8
+ * @param tolerance - the quantisation step for x, y and theta, or zero
+ * @return          - the new cache, or NULL if the parameters are invalid or allocation fails
+ */
+DubinsPathCache* dubins_path_cache_create(size_t capacity, double tolerance);
+
+/**
+ * Release a cache
+ *
+ * @param cache - the cache to release, may be NULL
+ */
+void dubins_path_cache_destroy(DubinsPathCache* cache);
+
+/**
+ * Drop every entry and reset the counters
+ *
+ * Unlike the lookups this must not run alongside any other use of the cache.
+ *
+ * @param cache - the cache to clear
+ */
+void dubins_path_cache_clear(DubinsPathCache* cache);
+
+/**
+ * dubins_shortest_path through a cache
+ *
+ * @param cache - the cache to consult and fill
+ * @param path  - the resultant path
+ * @param q0    - a configuration specified as an array of x, y, theta
+ * @param q1    - a configuration specified as an array of x, y, theta
+ * @param rho   - turning radius of the vehicle (forward velocity divided by maximum angular velocity)
+ * @return      - non-zero on error, as dubins_shortest_path would report
+ */
+int dubins_shortest_path_cached(DubinsPathCache* cache, DubinsPath* path,
+                                double q0[3], double q1[3], double rho);
+
+/**
+ * dubins_path through a cache
+ *
+ * @param cache    - the cache to consult and fill
+ * @param path     - the resultant path
+ * @param q0       - a configuration specified as an array of x, y, theta
+ * @param q1       - a configuration specified as an array of x, y, theta
+ * @param rho      - turning radius of the vehicle (forward velocity divided by maximum angular velocity)
+ * @param pathType - the specific path type to use
+ * @return         - non-zero on error, as dubins_path would report
+ */
+int dubins_path_cached(DubinsPathCache* cache, DubinsPath* path,
+                       double q0[3], double q1[3], double rho, DubinsPathType pathType);
+
+/**
+ * Read the counters of a cache
+ *
+ * The counters are updated atomically but read one at a time, so a snapshot
+ * taken while other threads use the cache need not be consistent.
+ *
+ * @param cache - the cache to inspect
+ * @param stats - receives the counters
+ */
+void dubins_path_cache_stats(const DubinsPathCache* cache, DubinsPathCacheStats* stats);
+
+#endif /* DUBINS_CACHE_H */
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef DUBINS_COLLISION_H
+#define DUBINS_COLLISION_H
+
+#include "dubins.h"
+
+/**
+ * A solid disc
+ */
+typedef struct
+{
+    double x;
+    double y;
+    double r;
+} DubinsCircle;
+
+/**
+ * A solid axis-aligned box
+ */
+typedef struct
+{
+    double x_min;
+    double y_min;
+    double x_max;
+    double y_max;
+} DubinsBox;
+
+/**
+ * A solid simple polygon, with its vertices in either winding order
+ */
+typedef struct
+{
+    /* 2 * n values, vertex i is (xy[2i], xy[2i + 1]) */
+    const double* xy;
+    size_t n;
+} DubinsPolygon;
+
+/**
+ * A set of obstacles, any of the arrays may be NULL when its count is zero
+ */
+typedef struct
+{
+    const DubinsCircle* circles;
+    size_t n_circles;
+    const DubinsBox* boxes;
+    size_t n_boxes;
+    const DubinsPolygon* polygons;
+    size_t n_polygons;
+} DubinsObstacles;
+
+typedef enum
+{
+    DUBINS_OBSTACLE_CIRCLE  = 0,
+    DUBINS_OBSTACLE_BOX     = 1,
+    DUBINS_OBSTACLE_POLYGON = 2
+} DubinsObstacleKind;
+
+/**
+ * Where dubins_path_collides found a collision
+ */
+typedef struct
+{
+    /* the segment of the path, 0 to 2 */
+    int segment;
+    /* the obstacle hit, an index into the array of its kind */
+    DubinsObstacleKind kind;
+    size_t index;
+} DubinsCollision;
+
+/**
+ * Check a path against a set of obstacles
+ *
+ * Each segment is tested exactly, as an arc or a line segment, against
+ * every obstacle, so thin obstacles cannot slip between samples.  The
+ * segments are tested in order and the search stops at the first hit, so
+ * the reported segment is the first one that collides.  Touching an
+ * obstacle counts as a collision.
+ *
+ * @param path      - an initialised path
+ * @param obstacles - the obstacles to test against
+ * @param hit       - optional, where the first collision was found
+ * @return          - 1 if the path collides with an obstacle, zero otherwise
+ */
+int dubins_path_collides(DubinsPath* path, const DubinsObstacles* obstacles, DubinsCollision* hit);
+
+/**
+ * The axis-aligned bounding box of one segment of a path
+ *
+ * Computed from the segment's end points and, for arcs, the extreme points
+ * of the turning circle that the arc sweeps past, so the box is tight.
+ *
+ * @param path - an initialised path
+ * @param i    - the segment, 0 to 2
+ * @param box  - the resultant box
+ * @return     - EDUBPARAM if i is not a segment
+ */
+int dubins_segment_bounds(DubinsPath* path, int i, DubinsBox* box);
+
+/**
+ * The tight axis-aligned bounding box of a path
+ *
+ * @param path - an initialised path
+ * @param box  - the resultant box
+ */
+void dubins_path_bounds(DubinsPath* path, DubinsBox* box);
+
+/**
+ * The bounding boxes of many paths, for building spatial indices
+ *
+ * @param paths - n initialised paths
+ * @param n     - the number of paths
+ * @param boxes - caller-owned array of n resultant boxes
+ */
+void dubins_path_bounds_batch(const DubinsPath* paths, size_t n, DubinsBox* boxes);
+
+/**
+ * A circle enclosing a path
+ *
+ * The circle is centred on the bounding box, with the smallest radius that
+ * reaches every point of the path from there.
+ *
+ * @param path   - an initialised path
+ * @param circle - the resultant circle
+ */
+void dubins_path_bounding_circle(DubinsPath* path, DubinsCircle* circle);
+
+#endif /* DUBINS_COLLISION_H */
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef DUBINS_FIXED_H
+#define DUBINS_FIXED_H
+
+#include "dubins.h"
+
+#include <stdint.h>
+
+/**
+ * Integer-only sampling of solved paths, for targets without an FPU
+ *
+ * Distances and coordinates are Q16.16 fixed point (value * 65536 in an
+ * int32_t, so within +-32768 units with a resolution of 1.5e-5), and
+ * headings are binary angles (a uint32_t where 2^32 is a full turn).
+ * Sines and cosines come from a 30-step CORDIC in Q2.30, so every sample
+ * takes the same number of integer operations and nothing needs libm.
+ *
+ * Compared with dubins_path_sample on the same path, a sample t along the
+ * path is within 4 * 2^-16 + 2^-24 * (rho + t) in x and y, and within
+ * 2^-16 / rho + 2^-26 radians in heading.  Most of that is the rounding of
+ * the segment lengths to Q16.16 on conversion; headings do not drift from
+ * one segment to the next, as each segment keeps the exact heading.
+ */
+
+/**
+ * A configuration in fixed point
+ */
+typedef struct
+{
+    /* position, Q16.16 */
+    int32_t x;
+    int32_t y;
+    /* heading, 2^32 is a full turn */
+    uint32_t theta;
+} DubinsFixedConfig;
+
+/**
+ * A path converted for integer sampling, see dubins_path_to_fixed
+ *
+ * All members are private to the sampler
+ */
+typedef struct
+{
+    /* start configuration of each segment, and the sine and cosine of its heading in Q2.30 */
+    DubinsFixedConfig start[3];
+    int32_t sin_start[3];
+    int32_t cos_start[3];
+    /* segment lengths, Q16.16 */
+    int32_t length[3];
+    /* 0 for a left turn, 1 for a straight and 2 for a right turn */
+    uint8_t segment[3];
+    /* turning radius, Q16.16 */
+    int32_t rho;
+    /* heading change over a Q16.16 distance d is (d * turn_mul) >> turn_shift */
+    uint32_t turn_mul;
+    uint32_t turn_shift;
+} DubinsFixedPath;
+
+/**
+ * Convert a solved path for integer sampling
+ *
+ * This is the only function of the fixed point module that uses floating
+ * point, so it is best run before the path is sent to the target.
+ *
+ * @param path  - an initialised path
+ * @param fixed - the converted path
+ * @return      - EDUBPARAM unless rho is at least 2^-16 and |x| and |y| of the
+ *                start plus the path length are below 32767
+ */
+int dubins_path_to_fixed(const DubinsPath* path, DubinsFixedPath* fixed);
+
+/**
+ * The total length of a converted path
+ *
+ * @param path - a converted path
+ * @return     - the length, Q16.16
+ */
+int32_t dubins_fixed_path_length(const DubinsFixedPath* path);
+
+/**
+ * Find the configuration a given distance along a converted path
+ *
+ * @param path - a converted path
+ * @param t    - the distance, Q16.16, where 0 <= t <= dubins_fixed_path_length(path)
+ * @param q    - the configuration result
+ * @return     - EDUBPARAM if t is out of range
+ */
+int dubins_fixed_path_sample(const DubinsFixedPath* path, int32_t t, DubinsFixedConfig* q);
+
+/**
+ * Write fixed-step samples of a converted path into a caller-owned array
+ *
+ * Sample k is taken at the distance k * step, with the same offset and cap
+ * conventions as dubins_path_sample_into.
+ *
+ * @param path   - a converted path
+ * @param step   - the distance between samples, Q16.16, must be positive
+ * @param qs     - at least cap configurations
+ * @param cap    - the capacity of qs
+ * @param offset - the index of the first sample to write
+ * @return       - the number of samples written, zero if step is not positive
+ */
+size_t dubins_fixed_path_sample_into(const DubinsFixedPath* path, int32_t step,
+                                     DubinsFixedConfig* qs, size_t cap, size_t offset);
+
+/**
+ * Sine and cosine of a binary angle by CORDIC
+ *
+ * Both results are Q2.30 and within 2^-25 of the exact values.
+ *
+ * @param angle - the angle, 2^32 is a full turn
+ * @param s     - the sine result
+ * @param c     - the cosine result
+ */
+void dubins_fixed_sincos(uint32_t angle, int32_t* s, int32_t* c);
+
+#endif /* DUBINS_FIXED_H */
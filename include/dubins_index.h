@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef DUBINS_INDEX_H
+#define DUBINS_INDEX_H
+
+#include "dubins.h"
+
+/**
+ * A growing set of configurations that answers nearest neighbour queries
+ * under the shortest path length
+ *
+ * Configurations are bucketed on a uniform grid over (x, y).  The straight
+ * line distance between two positions is a lower bound on the length of any
+ * path between them, so whole cells can be discarded before the exact solver
+ * is called on the configurations that remain.
+ */
+typedef struct DubinsIndex DubinsIndex;
+
+/**
+ * The direction in which index queries measure paths
+ */
+typedef enum
+{
+    /* paths from the query configuration to the indexed ones */
+    DUBINS_INDEX_FROM_QUERY = 0,
+    /* paths from the indexed configurations to the query */
+    DUBINS_INDEX_TO_QUERY = 1
+} DubinsIndexDirection;
+
+/**
+ * Create an empty index
+ *
+ * @param rho       - turning radius of the vehicle used for every query
+ * @param cell_size - edge length of the grid cells, or zero for 4 * rho
+ * @return          - the new index, or NULL if the parameters are invalid or allocation fails
+ */
+DubinsIndex* dubins_index_create(double rho, double cell_size);
+
+/**
+ * Release an index
+ *
+ * @param index - the index to release, may be NULL
+ */
+void dubins_index_destroy(DubinsIndex* index);
+
+/**
+ * Add a configuration
+ *
+ * Configurations are numbered in the order they are inserted, starting at
+ * zero, and inserting never renumbers existing ones.
+ *
+ * @param index - the index to add to
+ * @param q     - a configuration specified as an array of x, y, theta
+ * @param id    - optional, the number given to the configuration
+ * @return      - EDUBNOMEM if the index could not grow
+ */
+int dubins_index_insert(DubinsIndex* index, const double q[3], size_t* id);
+
+/**
+ * The number of configurations in an index
+ *
+ * @param index - an index
+ * @return      - the number of inserted configurations
+ */
+size_t dubins_index_size(const DubinsIndex* index);
+
+/**
+ * Look up an inserted configuration
+ *
+ * @param index - an index
+ * @param id    - a number returned by dubins_index_insert
+ * @return      - the configuration as an array of x, y, theta, or NULL if id is out of range
+ */
+const double* dubins_index_config(const DubinsIndex* index, size_t id);
+
+/**
+ * Find the k configurations with the shortest paths to or from q
+ *
+ * Results are written in increasing order of length, ties broken by the
+ * lower id.
+ *
+ * @param index     - an index
+ * @param q         - the query configuration
+ * @param direction - whether paths start or end at q
+ * @param k         - the number of neighbours wanted
+ * @param ids       - receives up to k ids
+ * @param lengths   - receives the path length to each of the ids
+ * @param n_found   - receives min(k, number of configurations)
+ * @return          - non-zero on error
+ */
+int dubins_index_knn(const DubinsIndex* index, double q[3], DubinsIndexDirection direction,
+                     size_t k, size_t* ids, double* lengths, size_t* n_found);
+
+/**
+ * Find every configuration whose path to or from q is no longer than radius
+ *
+ * Results are written in no particular order.  When lengths is NULL,
+ * configurations close enough that every pair must be within radius are
+ * accepted without calling the solver.
+ *
+ * @param index     - an index
+ * @param q         - the query configuration
+ * @param direction - whether paths start or end at q
+ * @param radius    - the largest path length accepted
+ * @param ids       - receives up to capacity ids
+ * @param lengths   - optional, receives the path length to each of the ids
+ * @param capacity  - the number of entries ids (and lengths) can hold
+ * @param n_found   - receives the number of matches, which may exceed capacity
+ * @return          - non-zero on error
+ */
+int dubins_index_radius(const DubinsIndex* index, double q[3], DubinsIndexDirection direction,
+                        double radius, size_t* ids, double* lengths, size_t capacity, size_t* n_found);
+
+#endif /* DUBINS_INDEX_H */
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef DUBINS_LUT_H
+#define DUBINS_LUT_H
+
+#include "dubins.h"
+
+/**
+ * Precomputed grid of shortest path costs over the normalised (alpha, beta, d) space
+ *
+ * The grid stores, at every vertex, the normalised cost minus d (which varies
+ * much less than the cost itself) and the optimal word.  Alpha and beta are
+ * periodic with n_alpha and n_beta vertices over [0, 2pi), d has n_d vertices
+ * over [0, d_max].  For every cell the build also records an error estimate:
+ * four times the largest error of the interpolated cost found on a 3x3x3
+ * sub-sampling of that cell.  This is a sampled estimate rather than a proven
+ * bound.  The cost jumps where the optimal word changes, so cells whose
+ * corners and sub-samples do not all share one word record an infinite error
+ * instead, and queries that fall in them are solved exactly.
+ *
+ * All members are read-only; use the functions below to create and release
+ * tables.
+ */
+typedef struct
+{
+    /* number of grid vertices along each axis */
+    unsigned n_alpha;
+    unsigned n_beta;
+    unsigned n_d;
+    /* the largest normalised distance covered by the grid */
+    double d_max;
+    /* the largest finite cell error of the whole table, normalised */
+    double max_error;
+    /* normalised cost minus d, per vertex */
+    const float* residual;
+    /* normalised interpolation error estimate, per cell, INFINITY where the word changes */
+    const float* cell_error;
+    /* optimal DubinsPathType, per vertex */
+    const unsigned char* type;
+
+    /* storage backing the arrays */
+    void* storage;
+    size_t storage_size;
+    void* storage_handle;
+    int mapped;
+} DubinsLut;
+
+/**
+ * Build a table by solving every grid vertex
+ *
+ * @param lut     - the table to initialise, release it with dubins_lut_free
+ * @param n_alpha - number of vertices along alpha, at least 1
+ * @param n_beta  - number of vertices along beta, at least 1
+ * @param n_d     - number of vertices along d, at least 2
+ * @param d_max   - the largest normalised distance the grid covers
+ * @return        - non-zero on error
+ */
+int dubins_lut_build(DubinsLut* lut, unsigned n_alpha, unsigned n_beta, unsigned n_d, double d_max);
+
+/**
+ * Write a table to a file that dubins_lut_map can map back
+ *
+ * The file is a little-endian header followed by the 64-byte aligned vertex
+ * and cell arrays, so it can be used in place without parsing.
+ *
+ * @param lut      - an initialised table
+ * @param filename - the file to create or overwrite
+ * @return         - non-zero on error
+ */
+int dubins_lut_save(const DubinsLut* lut, const char* filename);
+
+/**
+ * Map a table written by dubins_lut_save into memory without copying it
+ *
+ * @param lut      - the table to initialise, release it with dubins_lut_free
+ * @param filename - the file to map
+ * @return         - EDUBIO if the file cannot be read, EDUBFORMAT if it is not a valid table
+ */
+int dubins_lut_map(DubinsLut* lut, const char* filename);
+
+/**
+ * Release the storage of a built or mapped table
+ *
+ * @param lut - the table to release
+ */
+void dubins_lut_free(DubinsLut* lut);
+
+/**
+ * Estimate the shortest path length by trilinear interpolation
+ *
+ * Pairs whose normalised distance exceeds d_max, or that fall in a cell where
+ * the optimal word changes, are solved exactly and report an error of zero.
+ *
+ * @param lut    - an initialised table
+ * @param length - the estimated length
+ * @param error  - optional, the sampled error estimate of the length
+ * @param type   - optional, the optimal word at the nearest grid vertex, or the exact word
+ * @param q0     - a configuration specified as an array of x, y, theta
+ * @param q1     - a configuration specified as an array of x, y, theta
+ * @param rho    - turning radius of the vehicle (forward velocity divided by maximum angular velocity)
+ * @return       - non-zero on error
+ */
+int dubins_lut_estimate(const DubinsLut* lut, double* length, double* error, DubinsPathType* type,
+                        double q0[3], double q1[3], double rho);
+
+#endif /* DUBINS_LUT_H */
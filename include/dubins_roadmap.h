@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#ifndef DUBINS_ROADMAP_H
+#define DUBINS_ROADMAP_H
+
+#include "dubins.h"
+
+/**
+ * How the edges of a roadmap file are stored
+ */
+typedef enum
+{
+    /* one DubinsPath per edge, usable in place by dubins_path_sample */
+    DUBINS_ROADMAP_PATHS  = 0,
+    /* one DubinsPackedPath per edge, against the roadmap's own nodes */
+    DUBINS_ROADMAP_PACKED = 1
+} DubinsRoadmapFormat;
+
+/**
+ * A directed graph of precomputed paths, mapped from a file
+ *
+ * The edges leaving node i are edge_index[i] to edge_index[i + 1] - 1, edge
+ * e ends at node edge_target[e] and is described by paths[e] or packed[e],
+ * depending on the format.  All arrays point into the mapped file.
+ *
+ * All members are read-only; use the functions below to create and release
+ * roadmaps.
+ */
+typedef struct
+{
+    DubinsRoadmapFormat format;
+    size_t n_nodes;
+    size_t n_edges;
+    /* turning radius of every edge */
+    double rho;
+    /* 3 * n_nodes values, the node configurations */
+    const double* nodes;
+    /* n_nodes + 1 offsets into the edge arrays */
+    const uint64_t* edge_index;
+    /* n_edges node indices, the end of each edge */
+    const uint32_t* edge_target;
+    /* n_edges paths, NULL unless format is DUBINS_ROADMAP_PATHS */
+    const DubinsPath* paths;
+    /* n_edges packed paths, NULL unless format is DUBINS_ROADMAP_PACKED */
+    const DubinsPackedPath* packed;
+    /* the nodes, as the table the packed edges refer to */
+    DubinsNodeTable node_table;
+
+    /* storage backing the arrays */
+    void* storage;
+    size_t storage_size;
+    void* storage_handle;
+} DubinsRoadmap;
+
+/**
+ * Write a roadmap to a file that dubins_roadmap_map can map back
+ *
+ * The file is a little-endian header followed by the 64-byte aligned node,
+ * index, target and edge arrays.  Edges must be sorted by their start node.
+ * The packed format keeps only the segment lengths and word of each path,
+ * taking the start configuration from the node table, so paths[e] should
+ * start at node sources[e].
+ *
+ * @param filename - the file to create or overwrite
+ * @param format   - how to store the edges
+ * @param nodes    - 3 * n_nodes values, the node configurations
+ * @param n_nodes  - the number of nodes
+ * @param rho      - turning radius of every path
+ * @param sources  - n_edges node indices in ascending order, the start of each edge
+ * @param targets  - n_edges node indices, the end of each edge
+ * @param paths    - n_edges paths
+ * @param n_edges  - the number of edges
+ * @return         - EDUBPARAM if the edges are not sorted or refer to missing nodes, EDUBIO if the file cannot be written
+ */
+int dubins_roadmap_save(const char* filename, DubinsRoadmapFormat format,
+                        const double* nodes, size_t n_nodes, double rho,
+                        const uint32_t* sources, const uint32_t* targets,
+                        const DubinsPath* paths, size_t n_edges);
+
+/**
+ * Map a roadmap written by dubins_roadmap_save into memory without copying it
+ *
+ * Only the header and the ends of the index are checked, so the cost does
+ * not grow with the size of the roadmap.
+ *
+ * @param roadmap  - the roadmap to initialise, release it with dubins_roadmap_free
+ * @param filename - the file to map
+ * @return         - EDUBIO if the file cannot be read, EDUBFORMAT if it is not a valid roadmap
+ */
+int dubins_roadmap_map(DubinsRoadmap* roadmap, const char* filename);
+
+/**
+ * Release a mapped roadmap
+ *
+ * @param roadmap - the roadmap to release
+ */
+void dubins_roadmap_free(DubinsRoadmap* roadmap);
+
+/**
+ * The path of an edge
+ *
+ * Paths stored in full are copied out of the mapping, packed ones are
+ * unpacked against the roadmap's nodes.
+ *
+ * @param roadmap - a mapped roadmap
+ * @param edge    - the edge, below n_edges
+ * @param path    - the resultant path
+ * @return        - EDUBPARAM if the edge does not exist
+ */
+int dubins_roadmap_edge_path(const DubinsRoadmap* roadmap, size_t edge, DubinsPath* path);
+
+/**
+ * The length of an edge
+ *
+ * @param roadmap - a mapped roadmap
+ * @param edge    - the edge, below n_edges
+ * @return        - the length, INFINITY if the edge does not exist
+ */
+double dubins_roadmap_edge_length(const DubinsRoadmap* roadmap, size_t edge);
+
+/**
+ * Calculate the configuration along an edge, as dubins_path_sample
+ *
+ * @param roadmap - a mapped roadmap
+ * @param edge    - the edge, below n_edges
+ * @param t       - a length measure, where 0 <= t <= dubins_roadmap_edge_length(roadmap, edge)
+ * @param q       - the configuration result
+ * @return        - non-zero if the edge or 't' is out of range
+ */
+int dubins_roadmap_edge_sample(const DubinsRoadmap* roadmap, size_t edge, double t, double q[3]);
+
+#endif /* DUBINS_ROADMAP_H */
@@ -19,23 +19,9 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
  * THE SOFTWARE.
  */
-#ifdef WIN32
-#define _USE_MATH_DEFINES
-#endif
-
 //#include <stdio.h>
-#include <math.h>
-#include <emscripten.h>
-#include "dubins.h"
-
-#define EPSILON (10e-10)
-
-typedef enum 
-{
-    L_SEG = 0,
-    S_SEG = 1,
-    R_SEG = 2
-} SegmentType;
+#include <string.h>
+#include "dubins_internal.h"
 
 /* The segment types for each of the Path types */
 const SegmentType DIRDATA[][3] = {
@@ -47,23 +33,6 @@ const SegmentType DIRDATA[][3] = {
     { L_SEG, R_SEG, L_SEG }
 };
 
-typedef struct 
-{
-    double alpha;
-    double beta;
-    double d;
-    double sa;
-    double sb;
-    double ca;
-    double cb;
-    double c_ab;
-    double d_sq;
-} DubinsIntermediateResults;
-
-
-int dubins_word(DubinsIntermediateResults* in, DubinsPathType pathType, double out[3]);
-int dubins_intermediate_results(DubinsIntermediateResults* in, double q0[3], double q1[3], double rho);
-
 /**
  * Floating point modulus suitable for rings
  *
@@ -79,30 +48,57 @@ double mod2pi( double theta )
     return fmodr( theta, 2 * M_PI );
 }
 
-EMSCRIPTEN_KEEPALIVE
-int dubins_shortest_path(DubinsPath* path, double q0[3], double q1[3], double rho)
+/* words that can be optimal when d >= 4; below d = 4 every word is a candidate */
+#define W_LSL DUBINS_WORD(LSL)
+#define W_LSR DUBINS_WORD(LSR)
+#define W_RSL DUBINS_WORD(RSL)
+#define W_RSR DUBINS_WORD(RSR)
+static const unsigned LONG_PATH_WORDS[4][4] = DUBINS_LONG_PATH_WORDS;
+#define CSC_WORDS (W_LSL | W_LSR | W_RSL | W_RSR)
+
+/* angles closer than this to a quadrant boundary are not classified */
+#define QUADRANT_MARGIN (1e-6)
+
+static int quadrant(double angle)
 {
-    int i, errcode;
-    DubinsIntermediateResults in;
+    double step = M_PI / 2;
+    int q = (int)floor(angle / step);
+    double r = angle - q * step;
+    if(q < 0 || q > 3 || r < QUADRANT_MARGIN || step - r < QUADRANT_MARGIN) {
+        return -1;
+    }
+    return q;
+}
+
+unsigned dubins_candidate_words(DubinsIntermediateResults* in)
+{
+    int qa, qb;
+    if(in->d < 4.0) {
+        return DUBINS_ALL_WORDS;
+    }
+    /* CCC words are never optimal at this distance */
+    qa = quadrant(in->alpha);
+    qb = quadrant(in->beta);
+    if(qa < 0 || qb < 0) {
+        return CSC_WORDS;
+    }
+    return LONG_PATH_WORDS[qa][qb];
+}
+
+static int scan_words(DubinsPath* path, DubinsIntermediateResults* in, unsigned words)
+{
+    int i;
     double params[3];
     double cost;
     double best_cost = INFINITY;
     int best_word = -1;
-    errcode = dubins_intermediate_results(&in, q0, q1, rho);
-    if(errcode != EDUBOK) {
-        return errcode;
-    }
-
-
-    path->qi[0] = q0[0];
-    path->qi[1] = q0[1];
-    path->qi[2] = q0[2];
-    path->rho = rho;
  
     for( i = 0; i < 6; i++ ) {
         DubinsPathType pathType = (DubinsPathType)i;
-        errcode = dubins_word(&in, pathType, params);
-        if(errcode == EDUBOK) {
+        if((words & DUBINS_WORD(i)) == 0) {
+            DUBINS_STAT_INC(words_pruned);
+        }
+        else if(dubins_word(in, pathType, params) == EDUBOK) {
             cost = params[0] + params[1] + params[2];
             if(cost < best_cost) {
                 best_word = i;
@@ -117,9 +113,367 @@ int dubins_shortest_path(DubinsPath* path, double q0[3], double q1[3], double rh
     if(best_word == -1) {
         return EDUBNOPATH;
     }
+    DUBINS_STAT_INC(wins[best_word]);
     return EDUBOK;
 }
 
+int dubins_scan_words(DubinsPath* path, DubinsIntermediateResults* in, unsigned words)
+{
+    return scan_words(path, in, words);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_shortest_path(DubinsPath* path, double q0[3], double q1[3], double rho)
+{
+    return dubins_shortest_path_scan(path, q0, q1, rho, DUBINS_SCAN_CLASSIFIED);
+}
+
+int dubins_shortest_path_scan(DubinsPath* path, double q0[3], double q1[3], double rho, DubinsScanMode mode)
+{
+    int errcode, check;
+    DubinsIntermediateResults in;
+    DubinsPath classified;
+    errcode = dubins_intermediate_results(&in, q0, q1, rho);
+    if(errcode != EDUBOK) {
+        return errcode;
+    }
+
+    path->qi[0] = q0[0];
+    path->qi[1] = q0[1];
+    path->qi[2] = q0[2];
+    path->rho = rho;
+
+    if(mode == DUBINS_SCAN_CLASSIFIED) {
+        return scan_words(path, &in, dubins_candidate_words(&in));
+    }
+    errcode = scan_words(path, &in, DUBINS_ALL_WORDS);
+    if(mode == DUBINS_SCAN_VERIFY) {
+        check = scan_words(&classified, &in, dubins_candidate_words(&in));
+        if(check != errcode) {
+            return EDUBVERIFY;
+        }
+        if(errcode == EDUBOK && (classified.type != path->type 
+                                 || classified.param[0] != path->param[0]
+                                 || classified.param[1] != path->param[1]
+                                 || classified.param[2] != path->param[2])) {
+            return EDUBVERIFY;
+        }
+    }
+    return errcode;
+}
+
+void dubins_intermediate_block(DubinsIntermediateBlock* blk, const DubinsBatchInput* in,
+                               size_t offset, size_t n)
+{
+    size_t i;
+    double dx, dy, rho, theta;
+
+    /* the same sequence of operations as dubins_intermediate_results, one field at a time */
+    for( i = 0; i < n; i++ ) {
+        rho = (in->rho != NULL) ? in->rho[offset + i] : in->rho_shared;
+        dx = in->x1[offset + i] - in->x0[offset + i];
+        dy = in->y1[offset + i] - in->y0[offset + i];
+        blk->d[i] = sqrt( dx * dx + dy * dy ) / rho;
+        blk->errcode[i] = (rho <= 0.0) ? EDUBBADRHO : EDUBOK;
+
+        theta = 0;
+        if(blk->d[i] > 0) {
+            theta = mod2pi(atan2( dy, dx ));
+        }
+        blk->alpha[i] = mod2pi(in->th0[offset + i] - theta);
+        blk->beta[i]  = mod2pi(in->th1[offset + i] - theta);
+    }
+    for( i = 0; i < n; i++ ) {
+        blk->sa[i] = sin(blk->alpha[i]);
+        blk->sb[i] = sin(blk->beta[i]);
+    }
+    for( i = 0; i < n; i++ ) {
+        blk->ca[i] = cos(blk->alpha[i]);
+        blk->cb[i] = cos(blk->beta[i]);
+    }
+    for( i = 0; i < n; i++ ) {
+        blk->c_ab[i] = cos(blk->alpha[i] - blk->beta[i]);
+        blk->d_sq[i] = blk->d[i] * blk->d[i];
+    }
+    dubins_intermediate_block_pad(blk, n);
+}
+
+void dubins_intermediate_block_pad(DubinsIntermediateBlock* blk, size_t n)
+{
+    size_t i;
+    for( i = n; i % DUBINS_SIMD_MAX_LANES != 0; i++ ) {
+        blk->alpha[i] = blk->beta[i] = blk->d[i] = blk->d_sq[i] = 0.0;
+        blk->sa[i] = blk->sb[i] = blk->c_ab[i] = 0.0;
+        blk->ca[i] = blk->cb[i] = 1.0;
+        blk->errcode[i] = EDUBPARAM;
+    }
+}
+
+void dubins_words_block_scalar(const DubinsIntermediateBlock* blk, size_t n, unsigned words, DubinsBlockResult* res)
+{
+    size_t i;
+    int w;
+    double params[3];
+    double cost;
+    DubinsIntermediateResults in;
+
+    for( i = 0; i < n; i++ ) {
+        res->cost[i] = INFINITY;
+        res->word[i] = -1;
+        if(blk->errcode[i] != EDUBOK) {
+            continue;
+        }
+        in.alpha = blk->alpha[i];
+        in.beta  = blk->beta[i];
+        in.d     = blk->d[i];
+        in.sa    = blk->sa[i];
+        in.sb    = blk->sb[i];
+        in.ca    = blk->ca[i];
+        in.cb    = blk->cb[i];
+        in.c_ab  = blk->c_ab[i];
+        in.d_sq  = blk->d_sq[i];
+        for( w = 0; w < 6; w++ ) {
+            if((words & DUBINS_WORD(w)) && dubins_word(&in, (DubinsPathType)w, params) == EDUBOK) {
+                cost = params[0] + params[1] + params[2];
+                if(cost < res->cost[i]) {
+                    res->cost[i] = cost;
+                    res->word[i] = w;
+                    res->param[0][i] = params[0];
+                    res->param[1][i] = params[1];
+                    res->param[2][i] = params[2];
+                }
+            }
+        }
+    }
+}
+
+int dubins_block_store(DubinsIntermediateBlock* blk, DubinsBlockResult* res, size_t n,
+                       const double* rho, double rho_shared, DubinsBatchOutput* out, size_t offset)
+{
+    size_t i;
+    int errcode, first_error = EDUBOK;
+    double r;
+
+    for( i = 0; i < n; i++ ) {
+        errcode = blk->errcode[i];
+        if(errcode == EDUBOK && res->word[i] == -1) {
+            errcode = EDUBNOPATH;
+        }
+        if(errcode == EDUBOK) {
+            DUBINS_STAT_INC(wins[res->word[i]]);
+        }
+        else {
+            blk->errcode[i] = errcode;
+            res->word[i] = LSL;
+            res->param[0][i] = res->param[1][i] = res->param[2][i] = 0.0;
+            if(first_error == EDUBOK) {
+                first_error = errcode;
+            }
+        }
+        if(out->errcode != NULL) {
+            out->errcode[offset + i] = errcode;
+        }
+    }
+    if(out->length != NULL) {
+        for( i = 0; i < n; i++ ) {
+            r = (rho != NULL) ? rho[i] : rho_shared;
+            out->length[offset + i] = (blk->errcode[i] == EDUBOK) ? res->cost[i] * r : INFINITY;
+        }
+    }
+    if(out->type != NULL) {
+        for( i = 0; i < n; i++ ) {
+            out->type[offset + i] = (DubinsPathType)res->word[i];
+        }
+    }
+    for( i = 0; i < 3; i++ ) {
+        if(out->param[i] != NULL) {
+            memcpy(out->param[i] + offset, res->param[i], n * sizeof(double));
+        }
+    }
+    return first_error;
+}
+
+static int batch_solve(const DubinsBatchInput* in, DubinsBatchOutput* out, size_t n, unsigned words)
+{
+    DubinsIntermediateBlock blk;
+    DubinsBlockResult res;
+    size_t offset, count;
+    int errcode, first_error = EDUBOK;
+
+    for( offset = 0; offset < n; offset += count ) {
+        count = n - offset;
+        if(count > DUBINS_BLOCK_SIZE) {
+            count = DUBINS_BLOCK_SIZE;
+        }
+        dubins_intermediate_block(&blk, in, offset, count);
+        dubins_words_block(&blk, count, words, &res);
+        errcode = dubins_block_store(&blk, &res, count, (in->rho != NULL) ? in->rho + offset : NULL,
+                                     in->rho_shared, out, offset);
+        if(first_error == EDUBOK) {
+            first_error = errcode;
+        }
+    }
+    return first_error;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_shortest_path_batch(const DubinsBatchInput* in, DubinsBatchOutput* out, size_t n)
+{
+    return batch_solve(in, out, n, DUBINS_ALL_WORDS);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_path_batch(const DubinsBatchInput* in, DubinsBatchOutput* out, size_t n, DubinsPathType pathType)
+{
+    if((int)pathType < 0 || (int)pathType > LRL) {
+        return EDUBPARAM;
+    }
+    return batch_solve(in, out, n, DUBINS_WORD(pathType));
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_shortest_path_many(DubinsPath* paths, const double* q0s, const double* q1s, double rho,
+                              int* errcodes, size_t n)
+{
+    double q[6][DUBINS_BLOCK_SIZE];
+    double param[3][DUBINS_BLOCK_SIZE];
+    DubinsPathType type[DUBINS_BLOCK_SIZE];
+    int errcode[DUBINS_BLOCK_SIZE];
+    DubinsBatchInput in;
+    DubinsBatchOutput out;
+    size_t offset, count, i;
+    int j, err, first_error = EDUBOK;
+
+    in.x0 = q[0];
+    in.y0 = q[1];
+    in.th0 = q[2];
+    in.x1 = q[3];
+    in.y1 = q[4];
+    in.th1 = q[5];
+    in.rho = NULL;
+    in.rho_shared = rho;
+    out.length = NULL;
+    out.type = type;
+    out.param[0] = param[0];
+    out.param[1] = param[1];
+    out.param[2] = param[2];
+    out.errcode = errcode;
+
+    for( offset = 0; offset < n; offset += count ) {
+        count = n - offset;
+        if(count > DUBINS_BLOCK_SIZE) {
+            count = DUBINS_BLOCK_SIZE;
+        }
+        for( i = 0; i < count; i++ ) {
+            for( j = 0; j < 3; j++ ) {
+                q[j][i]     = q0s[3 * (offset + i) + j];
+                q[3 + j][i] = q1s[3 * (offset + i) + j];
+            }
+        }
+        err = batch_solve(&in, &out, count, DUBINS_ALL_WORDS);
+        if(first_error == EDUBOK) {
+            first_error = err;
+        }
+        for( i = 0; i < count; i++ ) {
+            DubinsPath* path = &paths[offset + i];
+            for( j = 0; j < 3; j++ ) {
+                path->qi[j] = q[j][i];
+                path->param[j] = param[j][i];
+            }
+            path->rho = rho;
+            path->type = type[i];
+            if(errcodes != NULL) {
+                errcodes[offset + i] = errcode[i];
+            }
+        }
+    }
+    return first_error;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_shortest_length(double* length, double q0[3], double q1[3], double rho)
+{
+    DubinsIntermediateResults in;
+    double cost;
+    int errcode = dubins_intermediate_results(&in, q0, q1, rho);
+    if(errcode != EDUBOK) {
+        return errcode;
+    }
+    cost = dubins_shortest_cost(&in);
+    if(cost == INFINITY) {
+        return EDUBNOPATH;
+    }
+    *length = cost * rho;
+    return EDUBOK;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_shortest_length_batch(const DubinsBatchInput* in, double* lengths, int* errcodes, size_t n)
+{
+    DubinsIntermediateBlock blk;
+    DubinsBlockResult res;
+    DubinsIntermediateResults ir;
+    size_t offset, count, i;
+    int errcode, first_error = EDUBOK;
+    int vectorised = (dubins_simd_level() != DUBINS_SIMD_NONE);
+    unsigned words;
+    double rho, cost;
+
+    for( offset = 0; offset < n; offset += count ) {
+        count = n - offset;
+        if(count > DUBINS_BLOCK_SIZE) {
+            count = DUBINS_BLOCK_SIZE;
+        }
+        dubins_intermediate_block(&blk, in, offset, count);
+        if(vectorised) {
+            /* the block runs every word any of its problems may need */
+            words = 0;
+            for( i = 0; i < count && words != DUBINS_ALL_WORDS; i++ ) {
+                if(blk.errcode[i] == EDUBOK) {
+                    ir.alpha = blk.alpha[i];
+                    ir.beta  = blk.beta[i];
+                    ir.d     = blk.d[i];
+                    words |= dubins_candidate_words(&ir);
+                }
+            }
+            dubins_words_block(&blk, count, words, &res);
+        }
+        for( i = 0; i < count; i++ ) {
+            errcode = blk.errcode[i];
+            cost = INFINITY;
+            if(errcode == EDUBOK) {
+                if(vectorised) {
+                    cost = res.cost[i];
+                }
+                else {
+                    ir.alpha = blk.alpha[i];
+                    ir.beta  = blk.beta[i];
+                    ir.d     = blk.d[i];
+                    ir.sa    = blk.sa[i];
+                    ir.sb    = blk.sb[i];
+                    ir.ca    = blk.ca[i];
+                    ir.cb    = blk.cb[i];
+                    ir.c_ab  = blk.c_ab[i];
+                    ir.d_sq  = blk.d_sq[i];
+                    cost = dubins_shortest_cost(&ir);
+                }
+                if(cost == INFINITY) {
+                    errcode = EDUBNOPATH;
+                }
+            }
+            if(errcode != EDUBOK && first_error == EDUBOK) {
+                first_error = errcode;
+            }
+            rho = (in->rho != NULL) ? in->rho[offset + i] : in->rho_shared;
+            lengths[offset + i] = (errcode == EDUBOK) ? cost * rho : INFINITY;
+            if(errcodes != NULL) {
+                errcodes[offset + i] = errcode;
+            }
+        }
+    }
+    return first_error;
+}
+
 int dubins_path(DubinsPath* path, double q0[3], double q1[3], double rho, DubinsPathType pathType)
 {
     int errcode;
@@ -251,24 +605,194 @@ int dubins_path_sample( DubinsPath* path, double t, double *q )
     return EDUBOK;
 }
 
+/* samples between direct evaluations of the arc direction */
+#define SAMPLER_ANCHOR (64)
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_path_sampler_init(DubinsPathSampler* sampler, DubinsPath* path, double stepSize)
+{
+    const SegmentType* types = DIRDATA[path->type];
+    double h = stepSize / path->rho;
+    int i;
+
+    if( !(stepSize > 0) ) {
+        return EDUBPARAM;
+    }
+    sampler->path   = *path;
+    sampler->step   = stepSize;
+    sampler->length = dubins_path_length(path);
+    sampler->origin = 0.0;
+    sampler->index  = 0;
+    sampler->t      = 0.0;
+
+    sampler->qs[0][0] = 0.0;
+    sampler->qs[0][1] = 0.0;
+    sampler->qs[0][2] = path->qi[2];
+    dubins_segment( path->param[0], sampler->qs[0], sampler->qs[1], types[0] );
+    dubins_segment( path->param[1], sampler->qs[1], sampler->qs[2], types[1] );
+    for( i = 0; i < 3; i++ ) {
+        sampler->sin_s[i] = sin(sampler->qs[i][2]);
+        sampler->cos_s[i] = cos(sampler->qs[i][2]);
+    }
+    sampler->start[0] = 0.0;
+    sampler->start[1] = path->param[0];
+    sampler->start[2] = path->param[0] + path->param[1];
+
+    sampler->rc = cos(h);
+    sampler->rs = sin(h);
+    sampler->segment = -1;
+    sampler->since_anchor = 0;
+    return EDUBOK;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_path_sampler_next(DubinsPathSampler* sampler, double q[3], double* t)
+{
+    double tprime, u, phi, cu;
+    int seg;
+    SegmentType type;
+    const double* qs;
+
+    /* k * step rather than a running sum, so resuming at any index agrees with one pass */
+    sampler->t = sampler->origin + sampler->index * sampler->step;
+    if( sampler->t >= sampler->length ) {
+        return EDUBPARAM;
+    }
+
+    /* the same segment choice as dubins_path_sample */
+    tprime = sampler->t / sampler->path.rho;
+    if( tprime < sampler->start[1] ) {
+        seg = 0;
+    }
+    else if( tprime < sampler->start[2] ) {
+        seg = 1;
+    }
+    else {
+        seg = 2;
+    }
+    type = DIRDATA[sampler->path.type][seg];
+    qs = sampler->qs[seg];
+    u = tprime - sampler->start[seg];
+    phi = qs[2];
+    if( type == L_SEG ) {
+        phi += u;
+    }
+    else if( type == R_SEG ) {
+        phi -= u;
+    }
+
+    if( type != S_SEG ) {
+        if( seg != sampler->segment || sampler->since_anchor == SAMPLER_ANCHOR ) {
+            sampler->cu = cos(phi);
+            sampler->su = sin(phi);
+            sampler->since_anchor = 0;
+        }
+        else {
+            /* rotate the previous direction by one step, clockwise on right turns */
+            cu = sampler->cu;
+            if( type == L_SEG ) {
+                sampler->cu = cu * sampler->rc - sampler->su * sampler->rs;
+                sampler->su = sampler->su * sampler->rc + cu * sampler->rs;
+            }
+            else {
+                sampler->cu = cu * sampler->rc + sampler->su * sampler->rs;
+                sampler->su = sampler->su * sampler->rc - cu * sampler->rs;
+            }
+        }
+        sampler->since_anchor++;
+    }
+    sampler->segment = seg;
+
+    if( type == L_SEG ) {
+        q[0] = qs[0] + sampler->su - sampler->sin_s[seg];
+        q[1] = qs[1] - sampler->cu + sampler->cos_s[seg];
+    }
+    else if( type == R_SEG ) {
+        q[0] = qs[0] - sampler->su + sampler->sin_s[seg];
+        q[1] = qs[1] + sampler->cu - sampler->cos_s[seg];
+    }
+    else {
+        q[0] = qs[0] + sampler->cos_s[seg] * u;
+        q[1] = qs[1] + sampler->sin_s[seg] * u;
+    }
+    q[0] = q[0] * sampler->path.rho + sampler->path.qi[0];
+    q[1] = q[1] * sampler->path.rho + sampler->path.qi[1];
+    q[2] = mod2pi(phi);
+
+    if( t != NULL ) {
+        *t = sampler->t;
+    }
+    sampler->index++;
+    return EDUBOK;
+}
+
 int dubins_path_sample_many(DubinsPath* path, double stepSize, 
                             DubinsPathSamplingCallback cb, void* user_data)
 {
     int retcode;
     double q[3];
-    double x = 0.0;
-    double length = dubins_path_length(path);
-    while( x <  length ) {
-        dubins_path_sample( path, x, q );
+    double x;
+    DubinsPathSampler sampler;
+    retcode = dubins_path_sampler_init( &sampler, path, stepSize );
+    if( retcode != EDUBOK ) {
+        return retcode;
+    }
+    while( dubins_path_sampler_next( &sampler, q, &x ) == EDUBOK ) {
         retcode = cb(q, x, user_data);
         if( retcode != 0 ) {
             return retcode;
         }
-        x += stepSize;
     }
     return 0;
 }
 
+EMSCRIPTEN_KEEPALIVE
+size_t dubins_path_sample_into(DubinsPath* path, double stepSize,
+                               double* xs, double* ys, double* ths, double* ts,
+                               size_t cap, size_t offset)
+{
+    DubinsPathSampler sampler;
+    double q[3];
+    size_t n = 0;
+    if( dubins_path_sampler_init( &sampler, path, stepSize ) != EDUBOK ) {
+        return 0;
+    }
+    sampler.index = offset;
+    for( ; n < cap; n++ ) {
+        if( dubins_path_sampler_next( &sampler, q, (ts != NULL) ? &ts[n] : NULL ) != EDUBOK ) {
+            break;
+        }
+        if( xs != NULL ) {
+            xs[n] = q[0];
+        }
+        if( ys != NULL ) {
+            ys[n] = q[1];
+        }
+        if( ths != NULL ) {
+            ths[n] = q[2];
+        }
+    }
+    return n;
+}
+
+EMSCRIPTEN_KEEPALIVE
+size_t dubins_path_sample_into_interleaved(DubinsPath* path, double stepSize,
+                                           double* qs, double* ts, size_t cap, size_t offset)
+{
+    DubinsPathSampler sampler;
+    size_t n = 0;
+    if( dubins_path_sampler_init( &sampler, path, stepSize ) != EDUBOK ) {
+        return 0;
+    }
+    sampler.index = offset;
+    for( ; n < cap; n++ ) {
+        if( dubins_path_sampler_next( &sampler, qs + 3 * n, (ts != NULL) ? &ts[n] : NULL ) != EDUBOK ) {
+            break;
+        }
+    }
+    return n;
+}
+
 /**
  * Convenience function to identify the endpoint of a path
  *
@@ -313,7 +837,151 @@ int dubins_extract_subpath( DubinsPath* path, double t, DubinsPath* newpath )
     return 0;
 }
 
-int dubins_intermediate_results(DubinsIntermediateResults* in, double q0[3], double q1[3], double rho)
+EMSCRIPTEN_KEEPALIVE
+int dubins_extract_window( DubinsPath* path, double t0, double t1, DubinsPath* newpath )
+{
+    double s0 = t0 / path->rho;
+    double s1 = t1 / path->rho;
+    double begin = 0;
+    double end, lo, hi, qi[3];
+    int i;
+
+    if( t0 < 0 || t1 < t0 || t1 > dubins_path_length(path) ) {
+        return EDUBPARAM;
+    }
+
+    /* the start of the window, from the same segment endpoints as sampling */
+    dubins_path_sample( path, t0, qi );
+
+    /* the part of every segment inside the window; segments before it shrink to zero */
+    for( i = 0; i < 3; i++ ) {
+        end = begin + path->param[i];
+        lo = fmax( begin, s0 );
+        hi = fmin( end, s1 );
+        newpath->param[i] = (hi > lo) ? hi - lo : 0.0;
+        begin = end;
+    }
+    newpath->qi[0] = qi[0];
+    newpath->qi[1] = qi[1];
+    newpath->qi[2] = qi[2];
+    newpath->rho   = path->rho;
+    newpath->type  = path->type;
+    return EDUBOK;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_extract_suffix( DubinsPath* path, double t, DubinsPath* newpath )
+{
+    return dubins_extract_window( path, t, dubins_path_length(path), newpath );
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_extract_windows( DubinsPath* paths, const double* t0s, const double* t1s,
+                            DubinsPath* newpaths, int* errcodes, size_t n )
+{
+    size_t i;
+    int err, first_error = EDUBOK;
+    for( i = 0; i < n; i++ ) {
+        err = dubins_extract_window( &paths[i], t0s[i], t1s[i], &newpaths[i] );
+        if( errcodes != NULL ) {
+            errcodes[i] = err;
+        }
+        if( err != EDUBOK && first_error == EDUBOK ) {
+            first_error = err;
+        }
+    }
+    return first_error;
+}
+
+/* append a segment to a list of segments, merging it with a previous one of the same kind */
+static int splice_push( SegmentType* kinds, double* lengths, int n, SegmentType kind, double length )
+{
+    if( length <= 0 ) {
+        return n;
+    }
+    if( n > 0 && kinds[n - 1] == kind ) {
+        lengths[n - 1] += length;
+        return n;
+    }
+    kinds[n] = kind;
+    lengths[n] = length;
+    return n + 1;
+}
+
+/* fit a list of segments into a word, leaving the unused segments of the word empty */
+static int splice_fit( const SegmentType* kinds, const double* lengths, int n, DubinsPathType type,
+                       double param[3] )
+{
+    int i, j = 0;
+    for( i = 0; i < 3; i++ ) {
+        if( j < n && DIRDATA[type][i] == kinds[j] ) {
+            param[i] = lengths[j++];
+        }
+        else {
+            param[i] = 0.0;
+        }
+    }
+    return j == n;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_path_splice( DubinsPath* first, DubinsPath* second, DubinsPath* newpath )
+{
+    SegmentType kinds[6];
+    double lengths[6];
+    double end[3], param[3], tol, dtheta;
+    DubinsPathType type;
+    int i, n = 0;
+
+    if( first->rho != second->rho ) {
+        return EDUBPARAM;
+    }
+    dubins_path_sample( first, dubins_path_length(first), end );
+    tol = 1e-9 * (first->rho + dubins_path_length(first) + dubins_path_length(second));
+    dtheta = mod2pi( end[2] - second->qi[2] );
+    if( fabs( end[0] - second->qi[0] ) > tol || fabs( end[1] - second->qi[1] ) > tol
+        || fmin( dtheta, 2 * M_PI - dtheta ) > 1e-9 ) {
+        return EDUBPARAM;
+    }
+
+    for( i = 0; i < 3; i++ ) {
+        n = splice_push( kinds, lengths, n, DIRDATA[first->type][i], first->param[i] );
+    }
+    for( i = 0; i < 3; i++ ) {
+        n = splice_push( kinds, lengths, n, DIRDATA[second->type][i], second->param[i] );
+    }
+    if( n > 3 ) {
+        return EDUBNOPATH;
+    }
+
+    /* prefer the words of the pieces, so windows of one path splice back to its word */
+    type = first->type;
+    if( !splice_fit( kinds, lengths, n, type, param ) ) {
+        type = second->type;
+        if( !splice_fit( kinds, lengths, n, type, param ) ) {
+            for( type = LSL; type <= LRL; type = (DubinsPathType)(type + 1) ) {
+                if( splice_fit( kinds, lengths, n, type, param ) ) {
+                    break;
+                }
+            }
+            if( type > LRL ) {
+                return EDUBNOPATH;
+            }
+        }
+    }
+
+    newpath->qi[0] = first->qi[0];
+    newpath->qi[1] = first->qi[1];
+    newpath->qi[2] = first->qi[2];
+    newpath->param[0] = param[0];
+    newpath->param[1] = param[1];
+    newpath->param[2] = param[2];
+    newpath->rho  = first->rho;
+    newpath->type = type;
+    return EDUBOK;
+}
+
+static int intermediate_results(DubinsIntermediateResults* in, double q0[3], double q1[3], double rho)
 {
     double dx, dy, D, d, theta, alpha, beta;
     if( rho <= 0.0 ) {
@@ -346,6 +1014,20 @@ int dubins_intermediate_results(DubinsIntermediateResults* in, double q0[3], dou
     return EDUBOK;
 }
 
+int dubins_intermediate_results(DubinsIntermediateResults* in, double q0[3], double q1[3], double rho)
+{
+#ifdef DUBINS_ENABLE_STATS
+    DubinsStats* stats = dubins_stats_local();
+    uint64_t start = DUBINS_STATS_CLOCK();
+    int errcode = intermediate_results(in, q0, q1, rho);
+    stats->intermediate_ticks += DUBINS_STATS_CLOCK() - start;
+    stats->intermediate_calls++;
+    return errcode;
+#else
+    return intermediate_results(in, q0, q1, rho);
+#endif
+}
+
 int dubins_LSL(DubinsIntermediateResults* in, double out[3]) 
 {
     double tmp0, tmp1, p_sq;
@@ -439,6 +1121,10 @@ int dubins_LRL(DubinsIntermediateResults* in, double out[3])
 int dubins_word(DubinsIntermediateResults* in, DubinsPathType pathType, double out[3]) 
 {
     int result;
+#ifdef DUBINS_ENABLE_STATS
+    DubinsStats* stats = dubins_stats_local();
+    uint64_t start = DUBINS_STATS_CLOCK();
+#endif
     switch(pathType)
     {
     case LSL:
@@ -462,5 +1148,161 @@ int dubins_word(DubinsIntermediateResults* in, DubinsPathType pathType, double o
     default:
         result = EDUBNOPATH;
     }
+#ifdef DUBINS_ENABLE_STATS
+    stats->word_ticks += DUBINS_STATS_CLOCK() - start;
+    if((int)pathType >= 0 && (int)pathType < 6) {
+        stats->word_calls[pathType]++;
+        if(result == EDUBNOPATH) {
+            stats->word_nopath[pathType]++;
+            if(pathType == RLR || pathType == LRL) {
+                stats->acos_rejects++;
+            }
+            else {
+                stats->p_sq_rejects++;
+            }
+        }
+    }
+#endif
     return result;
 }
+
+/*
+ * Length-only variants of the word solvers
+ *
+ * Each one returns the same value as summing the params of the full solver,
+ * but skips the writes and the mod2pi calls whose arguments are already in
+ * [0, 2pi).  The feasibility tests are left to the caller.
+ */
+static double dubins_LSL_cost(DubinsIntermediateResults* in, double p_sq)
+{
+    double tmp1 = atan2( (in->cb - in->ca), in->d + in->sa - in->sb );
+    return mod2pi(tmp1 - in->alpha) + sqrt(p_sq) + mod2pi(in->beta - tmp1);
+}
+
+static double dubins_RSR_cost(DubinsIntermediateResults* in, double p_sq)
+{
+    double tmp1 = atan2( (in->ca - in->cb), in->d - in->sa + in->sb );
+    return mod2pi(in->alpha - tmp1) + sqrt(p_sq) + mod2pi(tmp1 - in->beta);
+}
+
+static double dubins_LSR_cost(DubinsIntermediateResults* in, double p_sq)
+{
+    double p    = sqrt(p_sq);
+    double tmp0 = atan2( (-in->ca - in->cb), (in->d + in->sa + in->sb) ) - atan2(-2.0, p);
+    return mod2pi(tmp0 - in->alpha) + p + mod2pi(tmp0 - in->beta);
+}
+
+static double dubins_RSL_cost(DubinsIntermediateResults* in, double p_sq)
+{
+    double p    = sqrt(p_sq);
+    double tmp0 = atan2( (in->ca + in->cb), (in->d - in->sa - in->sb) ) - atan2(2.0, p);
+    return mod2pi(in->alpha - tmp0) + p + mod2pi(in->beta - tmp0);
+}
+
+static double dubins_RLR_cost(DubinsIntermediateResults* in, double tmp0)
+{
+    double phi = atan2( in->ca - in->cb, in->d - in->sa + in->sb );
+    double p   = mod2pi((2*M_PI) - acos(tmp0) );
+    double t   = mod2pi(in->alpha - phi + p/2.);
+    return t + p + mod2pi(in->alpha - in->beta - t + p);
+}
+
+static double dubins_LRL_cost(DubinsIntermediateResults* in, double tmp0)
+{
+    double phi = atan2( in->ca - in->cb, in->d + in->sa - in->sb );
+    double p   = mod2pi( 2*M_PI - acos( tmp0) );
+    double t   = mod2pi(-in->alpha - phi + p/2.);
+    return t + p + mod2pi(in->beta - in->alpha - t + p);
+}
+
+double dubins_shortest_cost(DubinsIntermediateResults* in)
+{
+    int i, j, w;
+    int order[6];
+    double bound[6];
+    double feasible[6];
+    double best = INFINITY;
+    double cost, tmp;
+    unsigned words = dubins_candidate_words(in);
+#ifdef DUBINS_ENABLE_STATS
+    int best_word = -1;
+#endif
+
+    /* 
+     * Cheap lower bounds: the straight segment of a CSC word, and the middle
+     * arc of a CCC word which is never shorter than pi.  Both come from the
+     * feasibility tests, so no trigonometry is needed to rank the words.
+     */
+    feasible[LSL] = 2 + in->d_sq - (2*in->c_ab) + (2 * in->d * (in->sa - in->sb));
+    feasible[RSR] = 2 + in->d_sq - (2 * in->c_ab) + (2 * in->d * (in->sb - in->sa));
+    feasible[LSR] = -2 + (in->d_sq) + (2 * in->c_ab) + (2 * in->d * (in->sa + in->sb));
+    feasible[RSL] = -2 + in->d_sq + (2 * in->c_ab) - (2 * in->d * (in->sa + in->sb));
+    feasible[RLR] = (6. - in->d_sq + 2*in->c_ab + 2*in->d*(in->sa - in->sb)) / 8.;
+    feasible[LRL] = (6. - in->d_sq + 2*in->c_ab + 2*in->d*(in->sb - in->sa)) / 8.;
+    for( w = 0; w < 6; w++ ) {
+        if((words & DUBINS_WORD(w)) == 0) {
+            bound[w] = INFINITY;
+            DUBINS_STAT_INC(words_pruned);
+        }
+        else if(w == RLR || w == LRL) {
+            bound[w] = (fabs(feasible[w]) <= 1) ? M_PI : INFINITY;
+            if(bound[w] == INFINITY) {
+                DUBINS_STAT_INC(acos_rejects);
+            }
+        }
+        else {
+            bound[w] = (feasible[w] >= 0) ? sqrt(feasible[w]) : INFINITY;
+            if(bound[w] == INFINITY) {
+                DUBINS_STAT_INC(p_sq_rejects);
+            }
+        }
+    }
+
+    /* insertion sort of the six words by their bound */
+    for( i = 0; i < 6; i++ ) {
+        for( j = i; j > 0 && bound[order[j-1]] > bound[i]; j-- ) {
+            order[j] = order[j-1];
+        }
+        order[j] = i;
+    }
+
+    for( i = 0; i < 6; i++ ) {
+        w = order[i];
+        if(bound[w] >= best) {
+            break;
+        }
+        tmp = feasible[w];
+        switch(w)
+        {
+        case LSL:
+            cost = dubins_LSL_cost(in, tmp);
+            break;
+        case LSR:
+            cost = dubins_LSR_cost(in, tmp);
+            break;
+        case RSL:
+            cost = dubins_RSL_cost(in, tmp);
+            break;
+        case RSR:
+            cost = dubins_RSR_cost(in, tmp);
+            break;
+        case RLR:
+            cost = dubins_RLR_cost(in, tmp);
+            break;
+        default:
+            cost = dubins_LRL_cost(in, tmp);
+        }
+        if(cost < best) {
+            best = cost;
+#ifdef DUBINS_ENABLE_STATS
+            best_word = w;
+#endif
+        }
+    }
+#ifdef DUBINS_ENABLE_STATS
+    if(best_word >= 0) {
+        dubins_stats_local()->wins[best_word]++;
+    }
+#endif
+    return best;
+}
@@ -5,16 +5,31 @@
 /**
  * Memory helpers, because webassembly only has fundamental type conversion
  */
-function _arrayToHeap(typedArray) {
-    var numBytes = typedArray.length * typedArray.BYTES_PER_ELEMENT;
+function _heapAlloc(numBytes) {
     var ptr = Module._malloc(numBytes);
-    var heapBytes = new Uint8Array(Module.HEAPU8.buffer, ptr, numBytes);
-    heapBytes.set(new Uint8Array(typedArray.buffer));
-    return heapBytes;
+    if (ptr === 0) throw new RangeError('cannot allocate ' + numBytes + ' bytes of WASM memory');
+    return ptr;
 }
 
-function _freeArray(heapBytes) {
-    Module._free(heapBytes.byteOffset);
+/**
+ * Persistent scratch regions of the WASM heap, allocated on first use and
+ * grown on demand, so sampling and batch solving never allocate per call
+ */
+const _configScratch = { ptr: 0, bytes: 0 }
+const _sampleScratch = { ptr: 0, bytes: 0 }
+const _sampleManyScratch = { ptr: 0, bytes: 0 }
+const _pathArrayScratch = { ptr: 0, bytes: 0 }
+const _batchScratch = { ptr: 0, bytes: 0 }
+
+function _scratchBuffer(scratch, numBytes) {
+    if (numBytes > scratch.bytes) {
+        let bytes = Math.max(numBytes, 2 * scratch.bytes)
+        let ptr = _heapAlloc(bytes)
+        if (scratch.ptr) Module._free(scratch.ptr)
+        scratch.ptr = ptr
+        scratch.bytes = bytes
+    }
+    return scratch.ptr
 }
 
 /**
@@ -60,16 +75,28 @@ const EDUBPARAM = 2   // Path parameterisitation error
 const EDUBBADRHO = 3   // the rho value is invalid
 const EDUBNOPATH = 4   // no connection between configurations with this word
 
+/**
+ * Layout of the C DubinsPath struct on the (little-endian, wasm32) heap
+ */
+const DUBINS_PATH_QI = 0
+const DUBINS_PATH_PARAM = 24
+const DUBINS_PATH_RHO = 48
+const DUBINS_PATH_TYPE = 56
+const DUBINS_PATH_SIZE = 64
+
 /**
  * Single dubins path 'struct'
+ *
+ * Without arguments the path owns a heap allocation that release() frees,
+ * otherwise it is a view of a slot owned by someone else (see DubinsPathArray)
  */
 class DubinsPath {
-    constructor() {
-        let byteSize = getSizeOf(this.typedef());
+    constructor(ptr) {
+        this._owned = (ptr === undefined)
+        if (this._owned) ptr = _heapAlloc(DUBINS_PATH_SIZE)
 
-        this._heap_ptr = Module._malloc(byteSize);
-        this._heap = new Uint8Array(Module.HEAPU8.buffer, this._heap_ptr, byteSize)
-        this._view = new DataView(this._heap.buffer, this._heap.byteOffset)
+        this._heap = new Uint8Array(Module.HEAPU8.buffer, ptr, DUBINS_PATH_SIZE)
+        this._view = new DataView(this._heap.buffer, this._heap.byteOffset, DUBINS_PATH_SIZE)
     }
 
     /**
@@ -85,19 +112,113 @@ class DubinsPath {
         ])
     }
 
+    get qi() {
+        return [0, 1, 2].map(i => this._view.getFloat64(DUBINS_PATH_QI + 8 * i, true))
+    }
+
+    get param() {
+        return [0, 1, 2].map(i => this._view.getFloat64(DUBINS_PATH_PARAM + 8 * i, true))
+    }
+
+    get rho() {
+        return this._view.getFloat64(DUBINS_PATH_RHO, true)
+    }
+
     get type() {
-        return this._view.getInt32(getOffsetOf(this.typedef(), 'type'), false)
+        return this._view.getInt32(DUBINS_PATH_TYPE, true)
     }
     set type(v) {
-        this._view.setInt32(getOffsetOf(this.typedef(), 'type'), v)
+        this._view.setInt32(DUBINS_PATH_TYPE, v, true)
     }
 
     get length() {
         return Module['path_length'](this)
     }
+
+    /**
+     * Free the heap allocation of a path created with new DubinsPath()
+     */
+    release() {
+        if (this._owned && this._heap) Module._free(this._heap.byteOffset)
+        this._heap = null
+        this._view = null
+    }
 }
 Module['DubinsPath'] = DubinsPath
 
+/**
+ * Fixed-capacity pool of paths in one contiguous heap region
+ *
+ * Paths are handed out in order and stay valid until reset() (which recycles
+ * every slot) or release() (which frees the region).
+ */
+class DubinsPathArray {
+    constructor(capacity) {
+        this.capacity = capacity
+        this.count = 0
+        this._ptr = _heapAlloc(capacity * DUBINS_PATH_SIZE)
+    }
+
+    /**
+     * A view of path i of the pool
+     */
+    get(i) {
+        if (i < 0 || i >= this.count) throw new RangeError('DubinsPathArray index out of range')
+        return new DubinsPath(this._ptr + i * DUBINS_PATH_SIZE)
+    }
+
+    /**
+     * Take the next free slot of the pool
+     */
+    alloc() {
+        if (this.count >= this.capacity) throw new RangeError('DubinsPathArray is full')
+        return new DubinsPath(this._ptr + (this.count++) * DUBINS_PATH_SIZE)
+    }
+
+    /**
+     * Solve n paths into the next n slots in one WASM call.
+     * returns an Int32Array of the error code of each path
+     *
+     * @param starts - Float64Array of n interleaved [x, y, theta] start configurations
+     * @param ends   - Float64Array of n interleaved [x, y, theta] goal configurations
+     * @param rho    - turning radius of the vehicle
+     */
+    shortest_path_many(starts, ends, rho) {
+        let n = Math.floor(starts.length / 3)
+        if (ends.length < 3 * n) throw new RangeError('ends holds fewer configurations than starts')
+        if (this.count + n > this.capacity) throw new RangeError('DubinsPathArray is full')
+
+        let configBytes = 3 * n * Float64Array.BYTES_PER_ELEMENT
+        let ptr = _scratchBuffer(_pathArrayScratch, 2 * configBytes + n * Int32Array.BYTES_PER_ELEMENT)
+        Module.HEAPF64.set(starts.subarray(0, 3 * n), ptr / 8)
+        Module.HEAPF64.set(ends.subarray(0, 3 * n), (ptr + configBytes) / 8)
+
+        let errPtr = ptr + 2 * configBytes
+        Module._dubins_shortest_path_many(this._ptr + this.count * DUBINS_PATH_SIZE,
+                                          ptr, ptr + configBytes, rho, errPtr, n)
+        this.count += n
+        return Module.HEAP32.slice(errPtr / 4, errPtr / 4 + n)
+    }
+
+    /**
+     * Recycle every slot, views handed out before are invalidated
+     */
+    reset() {
+        this.count = 0
+    }
+
+    /**
+     * Free the heap region of the pool
+     */
+    release() {
+        if (this._ptr) Module._free(this._ptr)
+        this._ptr = 0
+        this.capacity = 0
+        this.count = 0
+    }
+}
+Module['DubinsPathArray'] = DubinsPathArray
+
 /*
 * @param startPoint    - a configuration specified as an array of x, y, theta
 * @param endPoint      - a configuration specified as an array of x, y, theta
@@ -105,19 +226,17 @@ Module['DubinsPath'] = DubinsPath
 * @return path  - the resultant path
 */
 Module['shortest_path'] = function (startPoint, endPoint, rho) {
-    let _startP = Float64Array.from(startPoint);
-    let _endP = Float64Array.from(endPoint);
-
-    let startHeap = _arrayToHeap(_startP)
-    let endHeap = _arrayToHeap(_endP)
+    let ptr = _scratchBuffer(_configScratch, 6 * Float64Array.BYTES_PER_ELEMENT)
+    Module.HEAPF64.set(Float64Array.from(startPoint).subarray(0, 3), ptr / 8)
+    Module.HEAPF64.set(Float64Array.from(endPoint).subarray(0, 3), ptr / 8 + 3)
 
     let path = new DubinsPath()
 
-    let ret = Module.ccall('dubins_shortest_path', 'number', ['number', 'array', 'array', 'number'],
-        [path._heap.byteOffset, startHeap, endHeap, rho]);
-    
+    let ret = Module._dubins_shortest_path(path._heap.byteOffset, ptr, ptr + 24, rho)
+
     if(ret === EDUBOK) return path;
-    else               return ret;
+    path.release()
+    return ret;
 }
 
 Module['path_length'] = function (path) {
@@ -130,14 +249,143 @@ Module['path_length'] = function (path) {
  * returns array of: [posX,posY, angle]
  */
 Module['sample'] = function (path, t) {
+    let ptr = _scratchBuffer(_sampleScratch, 3 * Float64Array.BYTES_PER_ELEMENT)
+    Module._dubins_path_sample(path._heap.byteOffset, t, ptr)
+
+    /* copy out of the heap, the scratch is reused by the next call */
+    return Module.HEAPF64.slice(ptr / 8, ptr / 8 + 3)
+}
+
+/**
+ * Number of samples of a path of this length, taken where k * step < length
+ * as dubins_path_sampler_next does, so the count agrees with the C side
+ */
+function _sampleCount(length, step) {
+    let k = Math.ceil(length / step)
+    while (k > 0 && (k - 1) * step >= length) k--
+    while (k * step < length) k++
+    return k
+}
+
+/**
+ * Sample a path at a fixed step in a single WASM call.
+ * returns a Float64Array of interleaved [posX, posY, angle] triples
+ *
+ * @param path   - the path to sample
+ * @param step   - the distance along the path between samples
+ * @param into   - optional Float64Array that receives the samples, when
+ *                 omitted the result is a view of a reused heap buffer that is
+ *                 only valid until the next call to sampleMany
+ * @param offset - optional index of the first sample, taken at offset * step
+ */
+Module['sampleMany'] = function (path, step, into, offset = 0) {
+    if (!(step > 0)) return new Float64Array(0)
+
+    let capacity = Math.max(0, _sampleCount(path.length, step) - offset)
+    if (into) capacity = Math.min(capacity, Math.floor(into.length / 3))
+    let ptr = _scratchBuffer(_sampleManyScratch, 3 * capacity * Float64Array.BYTES_PER_ELEMENT)
+    let n = Module._dubins_path_sample_into_interleaved(path._heap.byteOffset, step, ptr, 0, capacity, offset)
+
+    let samples = new Float64Array(Module.HEAPF64.buffer, ptr, 3 * n)
+    if (!into) return samples
+    into.set(samples)
+    return into.subarray(0, 3 * n)
+}
+
+/**
+ * Thread pool shared by the batch wrappers, created on first use.  The
+ * scalar module has no threads and its pool solves on the calling thread.
+ */
+let _threadPool = 0
+function _pool() {
+    if (!_threadPool) _threadPool = Module._dubins_thread_pool_create(0)
+    return _threadPool
+}
+
+/**
+ * Copy n interleaved [x, y, theta] configurations into the x, y and theta
+ * heap arrays at ptr, ptr + 8n and ptr + 16n
+ */
+function _deinterleave(configs, n, ptr) {
+    let heap = Module.HEAPF64
+    let base = ptr / 8
+    for (let i = 0; i < n; i++) {
+        heap[base + i] = configs[3 * i]
+        heap[base + n + i] = configs[3 * i + 1]
+        heap[base + 2 * n + i] = configs[3 * i + 2]
+    }
+}
+
+/**
+ * Shortest paths between pairs of configurations, solved in blocks by the
+ * vector kernels and spread over the thread pool where the module has one.
+ * returns { length: Float64Array, type: Int32Array, errcode: Int32Array }
+ *
+ * @param starts - Float64Array of n interleaved [x, y, theta] start configurations
+ * @param ends   - Float64Array of n interleaved [x, y, theta] goal configurations
+ * @param rho    - turning radius of the vehicle
+ */
+Module['shortest_path_batch'] = function (starts, ends, rho) {
+    let n = Math.floor(starts.length / 3)
+    if (ends.length < 3 * n) throw new RangeError('ends holds fewer configurations than starts')
+
+    /* inputs, lengths, types, error codes, then the DubinsBatchInput and DubinsBatchOutput structs */
+    let inPtr = _scratchBuffer(_batchScratch, 64 * n + 80)
+    let lengthPtr = inPtr + 48 * n
+    let typePtr = lengthPtr + 8 * n
+    let errPtr = typePtr + 4 * n
+    let structPtr = (errPtr + 4 * n + 7) & ~7
+    _deinterleave(starts, n, inPtr)
+    _deinterleave(ends, n, inPtr + 24 * n)
 
-    /* Allocate, call, read back and free memory */
-    let sampleHeap = _arrayToHeap(Float64Array.from([0, 0, 0]))
-    let res = Module.ccall('dubins_path_sample', 'number', ['number', 'number', 'number'],
-                            [path._heap.byteOffset, t, sampleHeap.byteOffset])
+    let u32 = Module.HEAPU32
+    for (let i = 0; i < 6; i++) u32[structPtr / 4 + i] = inPtr + 8 * n * i
+    u32[structPtr / 4 + 6] = 0
+    Module.HEAPF64[structPtr / 8 + 4] = rho
 
-    let what = new Float64Array(sampleHeap.buffer, sampleHeap.byteOffset, 3)
-    _freeArray(sampleHeap)
+    let outPtr = structPtr + 40
+    u32[outPtr / 4] = lengthPtr
+    u32[outPtr / 4 + 1] = typePtr
+    u32[outPtr / 4 + 2] = u32[outPtr / 4 + 3] = u32[outPtr / 4 + 4] = 0
+    u32[outPtr / 4 + 5] = errPtr
 
-    return what
-}
\ No newline at end of file
+    Module._dubins_shortest_path_batch_parallel(structPtr, outPtr, n, _pool())
+    return {
+        length: Module.HEAPF64.slice(lengthPtr / 8, lengthPtr / 8 + n),
+        type: Module.HEAP32.slice(typePtr / 4, typePtr / 4 + n),
+        errcode: Module.HEAP32.slice(errPtr / 4, errPtr / 4 + n),
+    }
+}
+
+/**
+ * Row-major matrix of shortest path lengths from every start to every goal.
+ * returns a Float64Array of n_from * n_to lengths, Infinity where unsolvable
+ *
+ * @param from - Float64Array of n_from interleaved [x, y, theta] start configurations
+ * @param to   - Float64Array of n_to interleaved [x, y, theta] goal configurations
+ * @param rho  - turning radius of the vehicle
+ */
+Module['distance_matrix'] = function (from, to, rho) {
+    let nFrom = Math.floor(from.length / 3)
+    let nTo = Math.floor(to.length / 3)
+
+    /* configurations, lengths, then two DubinsConfigSet structs and a DubinsBatchOutput */
+    let fromPtr = _scratchBuffer(_batchScratch, 24 * (nFrom + nTo) + 8 * nFrom * nTo + 64)
+    let toPtr = fromPtr + 24 * nFrom
+    let lengthPtr = toPtr + 24 * nTo
+    let structPtr = lengthPtr + 8 * nFrom * nTo
+    _deinterleave(from, nFrom, fromPtr)
+    _deinterleave(to, nTo, toPtr)
+
+    let u32 = Module.HEAPU32
+    for (let i = 0; i < 3; i++) {
+        u32[structPtr / 4 + i] = fromPtr + 8 * nFrom * i
+        u32[structPtr / 4 + 3 + i] = toPtr + 8 * nTo * i
+    }
+    let outPtr = structPtr + 24
+    u32[outPtr / 4] = lengthPtr
+    for (let i = 1; i < 6; i++) u32[outPtr / 4 + i] = 0
+
+    Module._dubins_distance_matrix_parallel(structPtr, nFrom, structPtr + 12, nTo, rho, outPtr, _pool())
+    return Module.HEAPF64.slice(lengthPtr / 8, lengthPtr / 8 + nFrom * nTo)
+}
@@ -0,0 +1,218 @@
+/**
+ * Asynchronous batch API
+ *
+ * Spreads shortest path batches over a pool of workers, each hosting its
+ * own instance of the WASM module, so large batches never block the calling
+ * thread.  Uses worker_threads under Node and Web Workers in browsers.
+ *
+ *     let pool = DubinsAsync.createPool({ workers: 4 })
+ *     let result = await pool.solveBatch(starts, ends, rho, { onChunk })
+ *     pool.terminate()
+ *
+ * Browsers can load this file with a plain <script> tag, which defines a
+ * DubinsAsync global, and need no bundler: the pool starts dubins_worker.js as
+ * a classic Web Worker, which loads dubins.js with importScripts.
+ *
+ *     let pool = DubinsAsync.createPool({ workerUrl: 'dist/dubins_worker.js' })
+ *
+ * Every chunk of the inputs is copied once into a buffer of its own, which
+ * is transferred to the worker, and the results come back in transferred
+ * buffers.  Inputs that live in a SharedArrayBuffer are not copied at all.
+ */
+
+const isNode = typeof window === 'undefined' && typeof self === 'undefined'
+
+const DEFAULT_CHUNK_SIZE = 16384
+
+function defaultWorkerCount() {
+    if (isNode) return Math.max(1, require('os').cpus().length)
+    return (typeof navigator !== 'undefined' && navigator.hardwareConcurrency) || 4
+}
+
+/**
+ * Pool of workers fed from one queue of chunks
+ *
+ * @param options.workers       - number of workers, defaults to the number of cores
+ * @param options.chunkSize     - pairs per chunk, defaults to 16384
+ * @param options.workerUrl     - URL or path of dubins_worker.js, defaults to the one beside this file under Node
+ * @param options.module        - the module the workers load, dubins_loader.js under Node and dubins.js in browsers
+ * @param options.wasm          - optional, where the workers find the .wasm file of the module
+ * @param options.moduleOptions - options for the module factory, which must survive structured cloning
+ */
+class DubinsWorkerPool {
+    constructor(options = {}) {
+        this.chunkSize = options.chunkSize || DEFAULT_CHUNK_SIZE
+        this._init = { module: options.module, wasm: options.wasm, options: options.moduleOptions }
+        this._workerUrl = options.workerUrl ||
+            (isNode ? require('path').join(__dirname, 'dubins_worker.js') : 'dubins_worker.js')
+        this._queue = []
+        this._nextId = 0
+        this._workers = []
+        let count = options.workers || defaultWorkerCount()
+        for (let i = 0; i < count; i++) this._workers.push(this._spawn())
+    }
+
+    _spawn() {
+        let record = { worker: null, task: null, stopped: false }
+        let onMessage = (message) => this._finish(record, message)
+        let onError = (e) => {
+            /* the worker is gone: fail its chunk, and replace it only if it
+             * got as far as solving, so a module that cannot load fails fast */
+            if (record.stopped) return
+            let error = new Error(String(e && e.message || e))
+            let task = record.task
+            record.stopped = true
+            record.task = null
+            record.worker.terminate()
+            this._workers = this._workers.filter((r) => r !== record)
+            if (task) {
+                task.reject(error)
+                this._workers.push(this._spawn())
+            }
+            if (!this._workers.length) this._rejectQueue(error)
+            this._dispatch()
+        }
+        if (isNode) {
+            let { Worker } = require('worker_threads')
+            record.worker = new Worker(this._workerUrl)
+            record.worker.on('message', onMessage)
+            record.worker.on('error', onError)
+            /* emscripten exits the thread when the module aborts */
+            record.worker.on('exit', (code) => onError('worker exited with code ' + code))
+            /* an idle pool does not keep the process alive */
+            record.worker.unref()
+        } else {
+            record.worker = new Worker(this._workerUrl)
+            record.worker.onmessage = (e) => onMessage(e.data)
+            record.worker.onerror = onError
+        }
+        record.worker.postMessage({ init: this._init })
+        return record
+    }
+
+    _finish(record, message) {
+        let task = record.task
+        if (!task) return
+        record.task = null
+        if (isNode) record.worker.unref()
+        if (message.error !== undefined) task.reject(new Error(message.error))
+        else task.resolve(message.result)
+        this._dispatch()
+    }
+
+    _dispatch() {
+        for (let record of this._workers) {
+            if (!this._queue.length) return
+            if (record.task) continue
+            record.task = this._queue.shift()
+            if (isNode) record.worker.ref()
+            record.worker.postMessage(record.task.message, record.task.transfer)
+        }
+    }
+
+    _rejectQueue(error) {
+        for (let task of this._queue) task.reject(error)
+        this._queue = []
+    }
+
+    _run(message, transfer) {
+        if (!this._workers.length) return Promise.reject(new Error('DubinsWorkerPool has no workers'))
+        return new Promise((resolve, reject) => {
+            message.id = this._nextId++
+            this._queue.push({ message, transfer, resolve, reject })
+            this._dispatch()
+        })
+    }
+
+    /**
+     * Shortest paths between pairs of configurations, solved in chunks by the
+     * workers.  Resolves to { length: Float64Array, type: Int32Array,
+     * errcode: Int32Array }, laid out as shortest_path_batch returns them.
+     *
+     * @param starts          - Float64Array of n interleaved [x, y, theta] start configurations
+     * @param ends            - Float64Array of n interleaved [x, y, theta] goal configurations
+     * @param rho             - turning radius of the vehicle
+     * @param options.onChunk - optional, called with { begin, length, type, errcode } as each
+     *                          chunk arrives, in the order the chunks finish
+     * @param options.chunkSize - optional, pairs per chunk for this batch
+     */
+    solveBatch(starts, ends, rho, options = {}) {
+        if (!ArrayBuffer.isView(starts)) starts = Float64Array.from(starts)
+        if (!ArrayBuffer.isView(ends)) ends = Float64Array.from(ends)
+        let n = Math.floor(starts.length / 3)
+        if (ends.length < 3 * n) {
+            return Promise.reject(new RangeError('ends holds fewer configurations than starts'))
+        }
+
+        let result = {
+            length: new Float64Array(n),
+            type: new Int32Array(n),
+            errcode: new Int32Array(n),
+        }
+        let chunkSize = options.chunkSize || this.chunkSize
+        let chunks = []
+        for (let begin = 0; begin < n; begin += chunkSize) {
+            let count = Math.min(chunkSize, n - begin)
+            let transfer = []
+            let message = {
+                starts: chunkOf(starts, begin, count, transfer),
+                ends: chunkOf(ends, begin, count, transfer),
+                rho: rho,
+            }
+            chunks.push(this._run(message, transfer).then((chunk) => {
+                result.length.set(chunk.length, begin)
+                result.type.set(chunk.type, begin)
+                result.errcode.set(chunk.errcode, begin)
+                if (options.onChunk) {
+                    options.onChunk({ begin, length: chunk.length, type: chunk.type, errcode: chunk.errcode })
+                }
+            }))
+        }
+        return Promise.all(chunks).then(() => result)
+    }
+
+    /**
+     * Stop every worker, chunks still queued are rejected
+     */
+    terminate() {
+        this._rejectQueue(new Error('DubinsWorkerPool terminated'))
+        for (let record of this._workers) {
+            if (record.task) record.task.reject(new Error('DubinsWorkerPool terminated'))
+            record.task = null
+            record.stopped = true
+            record.worker.terminate()
+        }
+        this._workers = []
+    }
+}
+
+/**
+ * The configurations of a chunk, as a view of shared memory or as a copy
+ * whose buffer is added to the transfer list
+ */
+function chunkOf(configs, begin, count, transfer) {
+    if (typeof SharedArrayBuffer !== 'undefined' && configs.buffer instanceof SharedArrayBuffer) {
+        return configs.subarray(3 * begin, 3 * (begin + count))
+    }
+    let copy = configs.slice(3 * begin, 3 * (begin + count))
+    transfer.push(copy.buffer)
+    return copy
+}
+
+let _defaultPool = null
+
+function createPool(options) {
+    return new DubinsWorkerPool(options)
+}
+
+/**
+ * solveBatch on a pool shared by every caller, created on first use
+ */
+function solveBatch(starts, ends, rho, options) {
+    if (!_defaultPool) _defaultPool = new DubinsWorkerPool()
+    return _defaultPool.solveBatch(starts, ends, rho, options)
+}
+
+/* CommonJS under Node and bundlers, a DubinsAsync global when loaded by a <script> tag */
+if (typeof module === 'object' && module.exports) module.exports = { DubinsWorkerPool, createPool, solveBatch }
+else self.DubinsAsync = { DubinsWorkerPool, createPool, solveBatch }
@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Memo of solved paths.
+ *
+ * Every slot is guarded by a sequence lock: a writer claims the slot by
+ * moving its counter from even to odd with a compare-and-swap, fills it and
+ * releases it with the next even value.  Readers copy a slot without
+ * writing anything but its reference bit, and discard the copy if the
+ * counter was odd or changed while they read.  A counter of zero marks a
+ * slot that has never been written.
+ */
+#include "dubins_cache.h"
+#include "dubins_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#define cache_fence()        MemoryBarrier()
+#define cache_claim(p, o, n) (InterlockedCompareExchange((volatile LONG*)(p), (LONG)(n), (LONG)(o)) == (LONG)(o))
+#define cache_count(p)       InterlockedIncrement64((volatile LONG64*)(p))
+#else
+#define cache_fence()        __sync_synchronize()
+#define cache_claim(p, o, n) __sync_bool_compare_and_swap(p, o, n)
+#define cache_count(p)       __sync_fetch_and_add(p, 1)
+#endif
+
+/* slots per set, a power of two */
+#define CACHE_WAYS (8)
+
+/* six coordinates, the turning radius and the word */
+#define CACHE_KEY_WORDS (8)
+
+/* the word recorded for dubins_shortest_path lookups */
+#define CACHE_SHORTEST (6)
+
+/* quantised coordinates beyond this do not fit the key and bypass the cache */
+#define CACHE_QUANT_LIMIT (4.0e18)
+
+typedef struct
+{
+    volatile unsigned long seq;
+    volatile unsigned char referenced;
+    int errcode;
+    uint64_t key[CACHE_KEY_WORDS];
+    DubinsPath path;
+} DubinsCacheSlot;
+
+struct DubinsPathCache
+{
+    DubinsCacheSlot* slots;
+    /* the CLOCK hand of each set */
+    volatile unsigned char* hands;
+    size_t n_sets;
+    double tolerance;
+
+    volatile uint64_t hits;
+    volatile uint64_t misses;
+    volatile uint64_t insertions;
+    volatile uint64_t evictions;
+};
+
+static uint64_t double_bits(double v)
+{
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    return bits;
+}
+
+/* zero when the pair cannot be represented, as far outside the quantisation range */
+static int make_key(const DubinsPathCache* cache, uint64_t key[CACHE_KEY_WORDS],
+                    const double q0[3], const double q1[3], double rho, unsigned word)
+{
+    double v, c;
+    int i;
+    for( i = 0; i < 6; i++ ) {
+        v = (i < 3) ? q0[i] : q1[i - 3];
+        if(cache->tolerance == 0.0) {
+            key[i] = double_bits(v);
+            continue;
+        }
+        if(i % 3 == 2) {
+            v = mod2pi(v);
+        }
+        c = floor(v / cache->tolerance);
+        if(!(c > -CACHE_QUANT_LIMIT && c < CACHE_QUANT_LIMIT)) {
+            return 0;
+        }
+        key[i] = (uint64_t)(int64_t)c;
+    }
+    key[6] = double_bits(rho);
+    key[7] = word;
+    return 1;
+}
+
+static size_t key_set(const DubinsPathCache* cache, const uint64_t key[CACHE_KEY_WORDS])
+{
+    const uint64_t golden = ((uint64_t)0x9E3779B9u << 32) | 0x7F4A7C15u;
+    uint64_t h = 0;
+    int i;
+    for( i = 0; i < CACHE_KEY_WORDS; i++ ) {
+        h = (h ^ key[i]) * golden;
+        h ^= h >> 32;
+    }
+    return (size_t)(h & (uint64_t)(cache->n_sets - 1));
+}
+
+static int lookup(DubinsPathCache* cache, const uint64_t key[CACHE_KEY_WORDS],
+                  DubinsPath* path, int* errcode)
+{
+    DubinsCacheSlot* set = &cache->slots[key_set(cache, key) * CACHE_WAYS];
+    DubinsCacheSlot* slot;
+    DubinsPath copy;
+    unsigned long seq;
+    int i, match, err = EDUBOK;
+
+    for( i = 0; i < CACHE_WAYS; i++ ) {
+        slot = &set[i];
+        seq = slot->seq;
+        if(seq == 0 || (seq & 1)) {
+            continue;
+        }
+        cache_fence();
+        match = memcmp(slot->key, key, sizeof(slot->key)) == 0;
+        if(match) {
+            copy = slot->path;
+            err = slot->errcode;
+        }
+        cache_fence();
+        if(match && slot->seq == seq) {
+            slot->referenced = 1;
+            *path = copy;
+            *errcode = err;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void store(DubinsPathCache* cache, const uint64_t key[CACHE_KEY_WORDS],
+                  const DubinsPath* path, int errcode)
+{
+    size_t set_index = key_set(cache, key);
+    DubinsCacheSlot* set = &cache->slots[set_index * CACHE_WAYS];
+    DubinsCacheSlot* victim = NULL;
+    DubinsCacheSlot* slot;
+    unsigned hand = cache->hands[set_index];
+    unsigned long seq;
+    int i;
+
+    for( i = 0; i < CACHE_WAYS && victim == NULL; i++ ) {
+        if(set[i].seq == 0) {
+            victim = &set[i];
+        }
+    }
+    /* sweep the hand, clearing reference bits, until an unreferenced slot turns up */
+    for( i = 0; i < 2 * CACHE_WAYS && victim == NULL; i++ ) {
+        slot = &set[(hand + i) & (CACHE_WAYS - 1)];
+        if(!slot->referenced) {
+            victim = slot;
+        }
+        slot->referenced = 0;
+    }
+    if(victim == NULL) {
+        victim = &set[hand & (CACHE_WAYS - 1)];
+    }
+    cache->hands[set_index] = (unsigned char)((victim - set + 1) & (CACHE_WAYS - 1));
+
+    seq = victim->seq;
+    if((seq & 1) || !cache_claim(&victim->seq, seq, seq + 1)) {
+        return;
+    }
+    memcpy(victim->key, key, sizeof(victim->key));
+    victim->path = *path;
+    victim->errcode = errcode;
+    victim->referenced = 0;
+    cache_fence();
+    victim->seq = (seq + 2 != 0) ? seq + 2 : 2;
+
+    cache_count(&cache->insertions);
+    if(seq != 0) {
+        cache_count(&cache->evictions);
+    }
+}
+
+static int cached_solve(DubinsPathCache* cache, DubinsPath* path,
+                        double q0[3], double q1[3], double rho, unsigned word)
+{
+    uint64_t key[CACHE_KEY_WORDS];
+    DubinsPath solved;
+    int errcode;
+
+    if(!make_key(cache, key, q0, q1, rho, word)) {
+        cache_count(&cache->misses);
+        return (word == CACHE_SHORTEST) ? dubins_shortest_path(path, q0, q1, rho)
+                                        : dubins_path(path, q0, q1, rho, (DubinsPathType)word);
+    }
+    if(lookup(cache, key, path, &errcode)) {
+        cache_count(&cache->hits);
+        if(cache->tolerance != 0.0) {
+            path->qi[0] = q0[0];
+            path->qi[1] = q0[1];
+            path->qi[2] = q0[2];
+        }
+        return errcode;
+    }
+
+    cache_count(&cache->misses);
+    memset(&solved, 0, sizeof(solved));
+    errcode = (word == CACHE_SHORTEST) ? dubins_shortest_path(&solved, q0, q1, rho)
+                                       : dubins_path(&solved, q0, q1, rho, (DubinsPathType)word);
+    if(errcode != EDUBOK) {
+        memset(&solved, 0, sizeof(solved));
+    }
+    store(cache, key, &solved, errcode);
+    *path = solved;
+    return errcode;
+}
+
+EMSCRIPTEN_KEEPALIVE
+DubinsPathCache* dubins_path_cache_create(size_t capacity, double tolerance)
+{
+    DubinsPathCache* cache;
+    size_t n_sets = 1;
+    if(!(tolerance >= 0.0) || tolerance == INFINITY) {
+        return NULL;
+    }
+    while(n_sets * CACHE_WAYS < capacity) {
+        if(n_sets > (size_t)-1 / (2 * CACHE_WAYS * sizeof(DubinsCacheSlot))) {
+            return NULL;
+        }
+        n_sets *= 2;
+    }
+    cache = (DubinsPathCache*)calloc(1, sizeof(DubinsPathCache));
+    if(cache == NULL) {
+        return NULL;
+    }
+    cache->slots = (DubinsCacheSlot*)calloc(n_sets * CACHE_WAYS, sizeof(DubinsCacheSlot));
+    cache->hands = (volatile unsigned char*)calloc(n_sets, 1);
+    if(cache->slots == NULL || cache->hands == NULL) {
+        dubins_path_cache_destroy(cache);
+        return NULL;
+    }
+    cache->n_sets = n_sets;
+    cache->tolerance = tolerance;
+    return cache;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void dubins_path_cache_destroy(DubinsPathCache* cache)
+{
+    if(cache == NULL) {
+        return;
+    }
+    free(cache->slots);
+    free((void*)cache->hands);
+    free(cache);
+}
+
+EMSCRIPTEN_KEEPALIVE
+void dubins_path_cache_clear(DubinsPathCache* cache)
+{
+    memset(cache->slots, 0, cache->n_sets * CACHE_WAYS * sizeof(DubinsCacheSlot));
+    memset((void*)cache->hands, 0, cache->n_sets);
+    cache->hits = 0;
+    cache->misses = 0;
+    cache->insertions = 0;
+    cache->evictions = 0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_shortest_path_cached(DubinsPathCache* cache, DubinsPath* path,
+                                double q0[3], double q1[3], double rho)
+{
+    return cached_solve(cache, path, q0, q1, rho, CACHE_SHORTEST);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_path_cached(DubinsPathCache* cache, DubinsPath* path,
+                       double q0[3], double q1[3], double rho, DubinsPathType pathType)
+{
+    if((int)pathType < LSL || (int)pathType > LRL) {
+        return dubins_path(path, q0, q1, rho, pathType);
+    }
+    return cached_solve(cache, path, q0, q1, rho, (unsigned)pathType);
+}
+
+EMSCRIPTEN_KEEPALIVE
+void dubins_path_cache_stats(const DubinsPathCache* cache, DubinsPathCacheStats* stats)
+{
+    stats->hits = cache->hits;
+    stats->misses = cache->misses;
+    stats->insertions = cache->insertions;
+    stats->evictions = cache->evictions;
+}
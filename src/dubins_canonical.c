@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Canonical relative poses.
+ *
+ * A pair is solved from (alpha, beta, d) alone, so rewriting those after a
+ * reflection and rebuilding the sines and cosines from them gives the solve
+ * of the reflected pair.  Pairs that need no reflection rebuild exactly the
+ * intermediate results dubins_shortest_path uses.
+ */
+#include "dubins_internal.h"
+
+static void canonical_results(DubinsIntermediateResults* in, const DubinsCanonicalPair* pair)
+{
+    in->alpha = pair->alpha;
+    in->beta  = pair->beta;
+    in->d     = pair->d;
+    in->sa    = sin(pair->alpha);
+    in->sb    = sin(pair->beta);
+    in->ca    = cos(pair->alpha);
+    in->cb    = cos(pair->beta);
+    in->c_ab  = cos(pair->alpha - pair->beta);
+    in->d_sq  = pair->d * pair->d;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_canonicalize(DubinsCanonicalPair* pair, double q0[3], double q1[3], double rho)
+{
+    DubinsIntermediateResults in;
+    int errcode = dubins_intermediate_results(&in, q0, q1, rho);
+    if(errcode != EDUBOK) {
+        return errcode;
+    }
+    pair->d = in.d;
+    pair->mirrored = in.alpha > M_PI || ((in.alpha == 0 || in.alpha == M_PI) && in.beta > M_PI);
+    if(pair->mirrored) {
+        pair->alpha = (in.alpha > 0) ? 2 * M_PI - in.alpha : 0;
+        pair->beta  = (in.beta > 0) ? 2 * M_PI - in.beta : 0;
+    }
+    else {
+        pair->alpha = in.alpha;
+        pair->beta  = in.beta;
+    }
+    return EDUBOK;
+}
+
+EMSCRIPTEN_KEEPALIVE
+DubinsPathType dubins_mirror_type(DubinsPathType pathType)
+{
+    switch(pathType) {
+    case LSL: return RSR;
+    case RSR: return LSL;
+    case LSR: return RSL;
+    case RSL: return LSR;
+    case RLR: return LRL;
+    case LRL: return RLR;
+    }
+    return pathType;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_canonical_shortest(const DubinsCanonicalPair* pair, DubinsPathType* type, double param[3])
+{
+    DubinsIntermediateResults in;
+    DubinsPath path;
+    int errcode;
+
+    canonical_results(&in, pair);
+    errcode = dubins_scan_words(&path, &in, dubins_candidate_words(&in));
+    if(errcode != EDUBOK) {
+        return errcode;
+    }
+    *type = path.type;
+    param[0] = path.param[0];
+    param[1] = path.param[1];
+    param[2] = path.param[2];
+    return EDUBOK;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_canonical_word(const DubinsCanonicalPair* pair, DubinsPathType pathType, double param[3])
+{
+    DubinsIntermediateResults in;
+    canonical_results(&in, pair);
+    return dubins_word(&in, pathType, param);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_canonical_attach(DubinsPath* path, const DubinsCanonicalPair* pair, DubinsPathType type,
+                            const double param[3], double q0[3], double rho)
+{
+    if(rho <= 0.0) {
+        return EDUBBADRHO;
+    }
+    if((int)type < LSL || (int)type > LRL) {
+        return EDUBPARAM;
+    }
+    path->qi[0] = q0[0];
+    path->qi[1] = q0[1];
+    path->qi[2] = q0[2];
+    path->param[0] = param[0];
+    path->param[1] = param[1];
+    path->param[2] = param[2];
+    path->rho = rho;
+    path->type = pair->mirrored ? dubins_mirror_type(type) : type;
+    return EDUBOK;
+}
@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Exact tests of path segments against solid obstacles, and their bounds.
+ *
+ * A segment that is connected meets a solid shape exactly when one of its
+ * ends lies inside the shape or it crosses the boundary, so every test here
+ * reduces to a point-in-shape test plus arc or segment intersections with
+ * the boundary edges.
+ */
+#include "dubins_internal.h"
+#include "dubins_collision.h"
+
+/* one segment of a path, in world coordinates */
+typedef struct
+{
+    int arc;
+    /* the start and end points */
+    double x0, y0, x1, y1;
+    /* arcs only, the circle, the angle of the start on it and the signed sweep */
+    double cx, cy, r, a0, sweep;
+} PathPiece;
+
+static void make_piece(PathPiece* p, const DubinsPath* path, const double qs[3], double param, SegmentType type)
+{
+    double qe[3], qn[3];
+    double h = qs[2];
+    qn[0] = qs[0];
+    qn[1] = qs[1];
+    qn[2] = qs[2];
+    dubins_segment(param, qn, qe, type);
+    p->x0 = qs[0] * path->rho + path->qi[0];
+    p->y0 = qs[1] * path->rho + path->qi[1];
+    p->x1 = qe[0] * path->rho + path->qi[0];
+    p->y1 = qe[1] * path->rho + path->qi[1];
+    p->arc = (type != S_SEG);
+    if(type == L_SEG) {
+        p->cx = p->x0 - path->rho * sin(h);
+        p->cy = p->y0 + path->rho * cos(h);
+        p->a0 = h - M_PI / 2;
+        p->sweep = param;
+    }
+    else if(type == R_SEG) {
+        p->cx = p->x0 + path->rho * sin(h);
+        p->cy = p->y0 - path->rho * cos(h);
+        p->a0 = h + M_PI / 2;
+        p->sweep = -param;
+    }
+    p->r = path->rho;
+}
+
+/* whether the direction `angle` from the centre is covered by the arc */
+static int arc_covers(const PathPiece* p, double angle)
+{
+    if(p->sweep >= 0) {
+        return mod2pi(angle - p->a0) <= p->sweep;
+    }
+    return mod2pi(p->a0 - angle) <= -p->sweep;
+}
+
+static double point_segment_dist_sq(double px, double py, double ax, double ay, double bx, double by)
+{
+    double dx = bx - ax, dy = by - ay;
+    double len_sq = dx * dx + dy * dy;
+    double u = 0.0;
+    if(len_sq > 0.0) {
+        u = ((px - ax) * dx + (py - ay) * dy) / len_sq;
+        u = (u < 0.0) ? 0.0 : (u > 1.0) ? 1.0 : u;
+    }
+    dx = ax + u * dx - px;
+    dy = ay + u * dy - py;
+    return dx * dx + dy * dy;
+}
+
+static double cross(double ax, double ay, double bx, double by, double cx, double cy)
+{
+    return (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+}
+
+static int on_segment(double ax, double ay, double bx, double by, double px, double py)
+{
+    return fmin(ax, bx) <= px && px <= fmax(ax, bx) && fmin(ay, by) <= py && py <= fmax(ay, by);
+}
+
+/* whether segments ab and cd share a point */
+static int segments_meet(double ax, double ay, double bx, double by,
+                         double cx, double cy, double dx, double dy)
+{
+    double d1 = cross(cx, cy, dx, dy, ax, ay);
+    double d2 = cross(cx, cy, dx, dy, bx, by);
+    double d3 = cross(ax, ay, bx, by, cx, cy);
+    double d4 = cross(ax, ay, bx, by, dx, dy);
+    if(((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) && ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0))) {
+        return 1;
+    }
+    return (d1 == 0 && on_segment(cx, cy, dx, dy, ax, ay))
+        || (d2 == 0 && on_segment(cx, cy, dx, dy, bx, by))
+        || (d3 == 0 && on_segment(ax, ay, bx, by, cx, cy))
+        || (d4 == 0 && on_segment(ax, ay, bx, by, dx, dy));
+}
+
+/* whether the arc shares a point with segment ab */
+static int arc_meets_segment(const PathPiece* p, double ax, double ay, double bx, double by)
+{
+    double dx = bx - ax, dy = by - ay;
+    double fx = ax - p->cx, fy = ay - p->cy;
+    double a = dx * dx + dy * dy;
+    double b = 2 * (fx * dx + fy * dy);
+    double c = fx * fx + fy * fy - p->r * p->r;
+    double disc, root, u;
+    int k;
+    if(a == 0.0) {
+        return c == 0.0 && arc_covers(p, atan2(fy, fx));
+    }
+    disc = b * b - 4 * a * c;
+    if(disc < 0) {
+        return 0;
+    }
+    root = sqrt(disc);
+    for( k = -1; k <= 1; k += 2 ) {
+        u = (-b + k * root) / (2 * a);
+        if(u >= 0.0 && u <= 1.0 && arc_covers(p, atan2(fy + u * dy, fx + u * dx))) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int piece_meets_edge(const PathPiece* p, double ax, double ay, double bx, double by)
+{
+    if(p->arc) {
+        return arc_meets_segment(p, ax, ay, bx, by);
+    }
+    return segments_meet(p->x0, p->y0, p->x1, p->y1, ax, ay, bx, by);
+}
+
+static int hits_circle(const PathPiece* p, const DubinsCircle* c)
+{
+    double r_sq = c->r * c->r;
+    double dx, dy, dist;
+    if(!p->arc) {
+        return point_segment_dist_sq(c->x, c->y, p->x0, p->y0, p->x1, p->y1) <= r_sq;
+    }
+    dx = p->x0 - c->x;
+    dy = p->y0 - c->y;
+    if(dx * dx + dy * dy <= r_sq) {
+        return 1;
+    }
+    dx = p->x1 - c->x;
+    dy = p->y1 - c->y;
+    if(dx * dx + dy * dy <= r_sq) {
+        return 1;
+    }
+    /* otherwise the closest point is inside the arc, on the ray from the centre through c */
+    dx = c->x - p->cx;
+    dy = c->y - p->cy;
+    dist = sqrt(dx * dx + dy * dy);
+    if(dist == 0.0) {
+        return p->r <= c->r;
+    }
+    return fabs(dist - p->r) <= c->r && arc_covers(p, atan2(dy, dx));
+}
+
+static int inside_box(const DubinsBox* b, double x, double y)
+{
+    return b->x_min <= x && x <= b->x_max && b->y_min <= y && y <= b->y_max;
+}
+
+static int hits_box(const PathPiece* p, const DubinsBox* b)
+{
+    if(inside_box(b, p->x0, p->y0) || inside_box(b, p->x1, p->y1)) {
+        return 1;
+    }
+    if(!p->arc && (fmax(p->x0, p->x1) < b->x_min || fmin(p->x0, p->x1) > b->x_max
+                   || fmax(p->y0, p->y1) < b->y_min || fmin(p->y0, p->y1) > b->y_max)) {
+        return 0;
+    }
+    return piece_meets_edge(p, b->x_min, b->y_min, b->x_max, b->y_min)
+        || piece_meets_edge(p, b->x_max, b->y_min, b->x_max, b->y_max)
+        || piece_meets_edge(p, b->x_max, b->y_max, b->x_min, b->y_max)
+        || piece_meets_edge(p, b->x_min, b->y_max, b->x_min, b->y_min);
+}
+
+/* even-odd rule */
+static int inside_polygon(const DubinsPolygon* poly, double x, double y)
+{
+    size_t i, j;
+    int inside = 0;
+    const double* v = poly->xy;
+    for( i = 0, j = poly->n - 1; i < poly->n; j = i++ ) {
+        if(((v[2*i+1] > y) != (v[2*j+1] > y))
+           && (x < (v[2*j] - v[2*i]) * (y - v[2*i+1]) / (v[2*j+1] - v[2*i+1]) + v[2*i])) {
+            inside = !inside;
+        }
+    }
+    return inside;
+}
+
+static int hits_polygon(const PathPiece* p, const DubinsPolygon* poly)
+{
+    size_t i, j;
+    const double* v = poly->xy;
+    if(poly->n == 0) {
+        return 0;
+    }
+    if(inside_polygon(poly, p->x0, p->y0) || inside_polygon(poly, p->x1, p->y1)) {
+        return 1;
+    }
+    for( i = 0, j = poly->n - 1; i < poly->n; j = i++ ) {
+        if(piece_meets_edge(p, v[2*j], v[2*j+1], v[2*i], v[2*i+1])) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int report(DubinsCollision* hit, int segment, DubinsObstacleKind kind, size_t index)
+{
+    if(hit != NULL) {
+        hit->segment = segment;
+        hit->kind = kind;
+        hit->index = index;
+    }
+    return 1;
+}
+
+static void grow_box(DubinsBox* b, double x, double y)
+{
+    b->x_min = fmin(b->x_min, x);
+    b->y_min = fmin(b->y_min, y);
+    b->x_max = fmax(b->x_max, x);
+    b->y_max = fmax(b->y_max, y);
+}
+
+static void piece_bounds(const PathPiece* p, DubinsBox* b)
+{
+    int k;
+    b->x_min = b->x_max = p->x0;
+    b->y_min = b->y_max = p->y0;
+    grow_box(b, p->x1, p->y1);
+    if(p->arc) {
+        /* the extreme points of the circle that the arc passes */
+        for( k = 0; k < 4; k++ ) {
+            if(arc_covers(p, k * M_PI / 2)) {
+                grow_box(b, p->cx + p->r * ((k == 0) - (k == 2)), p->cy + p->r * ((k == 1) - (k == 3)));
+            }
+        }
+    }
+}
+
+/* the largest distance from (x, y) to a point of the segment */
+static double piece_farthest(const PathPiece* p, double x, double y)
+{
+    double d = fmax(hypot(p->x0 - x, p->y0 - y), hypot(p->x1 - x, p->y1 - y));
+    double dx, dy;
+    if(p->arc) {
+        dx = p->cx - x;
+        dy = p->cy - y;
+        /* the circle point opposite (x, y) is the farthest, if the arc passes it */
+        if(arc_covers(p, atan2(dy, dx))) {
+            d = fmax(d, hypot(dx, dy) + p->r);
+        }
+    }
+    return d;
+}
+
+/* the three segments of a path */
+static void path_pieces(const DubinsPath* path, PathPiece pieces[3])
+{
+    const SegmentType* types = DIRDATA[path->type];
+    double qs[3][3];
+    int s;
+
+    /* the segment starts in normalised coordinates, as in dubins_path_sample */
+    qs[0][0] = 0.0;
+    qs[0][1] = 0.0;
+    qs[0][2] = path->qi[2];
+    dubins_segment( path->param[0], qs[0], qs[1], types[0] );
+    dubins_segment( path->param[1], qs[1], qs[2], types[1] );
+    for( s = 0; s < 3; s++ ) {
+        make_piece(&pieces[s], path, qs[s], path->param[s], types[s]);
+    }
+}
+
+int dubins_segment_bounds(DubinsPath* path, int i, DubinsBox* box)
+{
+    PathPiece pieces[3];
+    if( (i < 0) || (i > 2) ) {
+        return EDUBPARAM;
+    }
+    path_pieces(path, pieces);
+    piece_bounds(&pieces[i], box);
+    return EDUBOK;
+}
+
+static void bounds(const DubinsPath* path, DubinsBox* box)
+{
+    PathPiece pieces[3];
+    DubinsBox b;
+    int s;
+    path_pieces(path, pieces);
+    piece_bounds(&pieces[0], box);
+    for( s = 1; s < 3; s++ ) {
+        piece_bounds(&pieces[s], &b);
+        grow_box(box, b.x_min, b.y_min);
+        grow_box(box, b.x_max, b.y_max);
+    }
+}
+
+void dubins_path_bounds(DubinsPath* path, DubinsBox* box)
+{
+    bounds(path, box);
+}
+
+void dubins_path_bounds_batch(const DubinsPath* paths, size_t n, DubinsBox* boxes)
+{
+    size_t i;
+    for( i = 0; i < n; i++ ) {
+        bounds(&paths[i], &boxes[i]);
+    }
+}
+
+void dubins_path_bounding_circle(DubinsPath* path, DubinsCircle* circle)
+{
+    PathPiece pieces[3];
+    DubinsBox box;
+    int s;
+    path_pieces(path, pieces);
+    bounds(path, &box);
+    circle->x = (box.x_min + box.x_max) / 2;
+    circle->y = (box.y_min + box.y_max) / 2;
+    circle->r = 0.0;
+    for( s = 0; s < 3; s++ ) {
+        circle->r = fmax(circle->r, piece_farthest(&pieces[s], circle->x, circle->y));
+    }
+}
+
+int dubins_path_collides(DubinsPath* path, const DubinsObstacles* obstacles, DubinsCollision* hit)
+{
+    PathPiece pieces[3];
+    const PathPiece* piece;
+    size_t i;
+    int s;
+
+    path_pieces(path, pieces);
+    for( s = 0; s < 3; s++ ) {
+        piece = &pieces[s];
+        for( i = 0; i < obstacles->n_circles; i++ ) {
+            if(hits_circle(piece, &obstacles->circles[i])) {
+                return report(hit, s, DUBINS_OBSTACLE_CIRCLE, i);
+            }
+        }
+        for( i = 0; i < obstacles->n_boxes; i++ ) {
+            if(hits_box(piece, &obstacles->boxes[i])) {
+                return report(hit, s, DUBINS_OBSTACLE_BOX, i);
+            }
+        }
+        for( i = 0; i < obstacles->n_polygons; i++ ) {
+            if(hits_polygon(piece, &obstacles->polygons[i])) {
+                return report(hit, s, DUBINS_OBSTACLE_POLYGON, i);
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Integer-only sampling of solved paths.
+ *
+ * Nothing here may call libm or use floating point outside
+ * dubins_path_to_fixed, so the sampler links on targets without an FPU or
+ * a maths library.
+ */
+#include "dubins_fixed.h"
+
+#define FIXED_ONE 65536.0
+#define FIXED_LIMIT 32767.0
+#define FIXED_TWO_PI 6.283185307179586476925286766559
+
+/* segment kinds, in the L, S, R order of the words */
+#define FIXED_L 0
+#define FIXED_S 1
+#define FIXED_R 2
+
+/* the CORDIC gain for 30 steps, Q2.30 */
+#define CORDIC_GAIN 652032874
+
+/* atan(2^-i) as binary angles */
+static const int32_t CORDIC_ATAN[30] = {
+    536870912, 316933406, 167458907, 85004756, 42667331, 21354465, 10679838, 5340245,
+    2670163, 1335087, 667544, 333772, 166886, 83443, 41722, 20861,
+    10430, 5215, 2608, 1304, 652, 326, 163, 81,
+    41, 20, 10, 5, 3, 1
+};
+
+/* the segments of each word, kept here so the sampler needs nothing from dubins.c */
+static const uint8_t FIXED_WORDS[6][3] = {
+    { FIXED_L, FIXED_S, FIXED_L },
+    { FIXED_L, FIXED_S, FIXED_R },
+    { FIXED_R, FIXED_S, FIXED_L },
+    { FIXED_R, FIXED_S, FIXED_R },
+    { FIXED_R, FIXED_L, FIXED_R },
+    { FIXED_L, FIXED_R, FIXED_L }
+};
+
+void dubins_fixed_sincos(uint32_t angle, int32_t* s, int32_t* c)
+{
+    /* reduce to [-pi/4, pi/4) around the nearest quadrant */
+    uint32_t quadrant = ((angle + 0x20000000u) >> 30) & 3u;
+    int32_t z = (int32_t)(angle - (quadrant << 30));
+    int32_t x = CORDIC_GAIN;
+    int32_t y = 0;
+    int32_t t;
+    int i;
+
+    for(i = 0; i < 30; i++) {
+        if(z >= 0) {
+            t = x - (y >> i);
+            y = y + (x >> i);
+            z -= CORDIC_ATAN[i];
+        }
+        else {
+            t = x + (y >> i);
+            y = y - (x >> i);
+            z += CORDIC_ATAN[i];
+        }
+        x = t;
+    }
+
+    switch(quadrant) {
+    case 0:
+        *s = y;
+        *c = x;
+        break;
+    case 1:
+        *s = x;
+        *c = -y;
+        break;
+    case 2:
+        *s = -y;
+        *c = -x;
+        break;
+    default:
+        *s = -x;
+        *c = y;
+        break;
+    }
+}
+
+/* a * b >> 30, rounded, where the result fits Q16.16 */
+static int32_t fixed_mul30(int64_t a, int64_t b)
+{
+    return (int32_t)((a * b + ((int64_t)1 << 29)) >> 30);
+}
+
+/* the configuration a distance d into segment i */
+static void fixed_segment(const DubinsFixedPath* path, int i, int32_t d, DubinsFixedConfig* q)
+{
+    const DubinsFixedConfig* q0 = &path->start[i];
+    uint32_t turn;
+    int32_t s, c;
+
+    if(path->segment[i] == FIXED_S) {
+        q->x = q0->x + fixed_mul30(d, path->cos_start[i]);
+        q->y = q0->y + fixed_mul30(d, path->sin_start[i]);
+        q->theta = q0->theta;
+        return;
+    }
+
+    turn = (uint32_t)(((uint64_t)(uint32_t)d * path->turn_mul
+                       + ((uint64_t)1 << (path->turn_shift - 1))) >> path->turn_shift);
+    if(path->segment[i] == FIXED_L) {
+        q->theta = q0->theta + turn;
+        dubins_fixed_sincos(q->theta, &s, &c);
+        q->x = q0->x + fixed_mul30(path->rho, (int64_t)s - path->sin_start[i]);
+        q->y = q0->y + fixed_mul30(path->rho, (int64_t)path->cos_start[i] - c);
+    }
+    else {
+        q->theta = q0->theta - turn;
+        dubins_fixed_sincos(q->theta, &s, &c);
+        q->x = q0->x + fixed_mul30(path->rho, (int64_t)path->sin_start[i] - s);
+        q->y = q0->y + fixed_mul30(path->rho, (int64_t)c - path->cos_start[i]);
+    }
+}
+
+static int finite_value(double v)
+{
+    return v - v == 0.0;
+}
+
+static int32_t fixed_round(double v)
+{
+    return (int32_t)(v < 0 ? v - 0.5 : v + 0.5);
+}
+
+/* the binary angle of a heading in radians, |theta| < 2^52 */
+static uint32_t fixed_angle(double theta)
+{
+    double turns = theta / FIXED_TWO_PI;
+    turns -= (double)(int64_t)turns;
+    if(turns < 0) {
+        turns += 1.0;
+    }
+    /* a fraction that rounds up to a full turn wraps to zero */
+    return (uint32_t)(uint64_t)(turns * 4294967296.0 + 0.5);
+}
+
+int dubins_path_to_fixed(const DubinsPath* path, DubinsFixedPath* fixed)
+{
+    double rho = path->rho;
+    double total = (path->param[0] + path->param[1] + path->param[2]) * rho;
+    double heading = path->qi[2];
+    double start = 0;
+    double turn_rate;
+    int32_t offset = 0;
+    int32_t next;
+    int i;
+    int dir;
+
+    if(!finite_value(rho) || !finite_value(total) || !finite_value(heading)
+       || (int)path->type < LSL || (int)path->type > LRL
+       || rho * FIXED_ONE < 1.0 || rho > FIXED_LIMIT || total < 0
+       || heading > 4e15 || heading < -4e15
+       || !finite_value(path->qi[0]) || !finite_value(path->qi[1])
+       || (path->qi[0] < 0 ? -path->qi[0] : path->qi[0]) + total >= FIXED_LIMIT
+       || (path->qi[1] < 0 ? -path->qi[1] : path->qi[1]) + total >= FIXED_LIMIT) {
+        return EDUBPARAM;
+    }
+
+    fixed->rho = fixed_round(rho * FIXED_ONE);
+
+    /* the heading changes by 2^16 / (2 pi rho) binary angle units per Q16.16 unit
+     * of distance, held as a 32-bit mantissa and a shift */
+    turn_rate = FIXED_ONE / (FIXED_TWO_PI * rho);
+    fixed->turn_shift = 0;
+    while(turn_rate < 2147483648.0) {
+        turn_rate *= 2.0;
+        fixed->turn_shift++;
+    }
+    if(turn_rate + 0.5 >= 4294967296.0) {
+        /* rounds up to 2^32, which does not fit the mantissa */
+        fixed->turn_mul = 2147483648u;
+        fixed->turn_shift--;
+    }
+    else {
+        fixed->turn_mul = (uint32_t)(turn_rate + 0.5);
+    }
+
+    fixed->start[0].x = fixed_round(path->qi[0] * FIXED_ONE);
+    fixed->start[0].y = fixed_round(path->qi[1] * FIXED_ONE);
+    for(i = 0; i < 3; i++) {
+        fixed->segment[i] = FIXED_WORDS[path->type][i];
+        dir = fixed->segment[i] == FIXED_L ? 1 : (fixed->segment[i] == FIXED_R ? -1 : 0);
+
+        /* the exact heading of the segment extended back to where the rounded
+         * offset starts it, so length rounding never turns into a heading error */
+        fixed->start[i].theta = fixed_angle(heading + dir * (offset / FIXED_ONE - start) / rho);
+        dubins_fixed_sincos(fixed->start[i].theta, &fixed->sin_start[i], &fixed->cos_start[i]);
+
+        start += path->param[i] * rho;
+        heading += dir * path->param[i];
+        next = fixed_round(start * FIXED_ONE);
+        fixed->length[i] = next - offset;
+        offset = next;
+        if(i < 2) {
+            fixed_segment(fixed, i, fixed->length[i], &fixed->start[i + 1]);
+        }
+    }
+    return EDUBOK;
+}
+
+int32_t dubins_fixed_path_length(const DubinsFixedPath* path)
+{
+    return path->length[0] + path->length[1] + path->length[2];
+}
+
+int dubins_fixed_path_sample(const DubinsFixedPath* path, int32_t t, DubinsFixedConfig* q)
+{
+    if(t < 0 || t > dubins_fixed_path_length(path)) {
+        return EDUBPARAM;
+    }
+    if(t < path->length[0]) {
+        fixed_segment(path, 0, t, q);
+    }
+    else if(t - path->length[0] < path->length[1]) {
+        fixed_segment(path, 1, t - path->length[0], q);
+    }
+    else {
+        fixed_segment(path, 2, t - path->length[0] - path->length[1], q);
+    }
+    return EDUBOK;
+}
+
+size_t dubins_fixed_path_sample_into(const DubinsFixedPath* path, int32_t step,
+                                     DubinsFixedConfig* qs, size_t cap, size_t offset)
+{
+    int32_t length = dubins_fixed_path_length(path);
+    uint64_t t;
+    size_t n;
+
+    /* past the end whatever the step, which also keeps offset * step in range */
+    if(step <= 0 || offset >= (size_t)length) {
+        return 0;
+    }
+    t = (uint64_t)offset * (uint32_t)step;
+    for(n = 0; n < cap && t < (uint64_t)length; n++, t += (uint32_t)step) {
+        dubins_fixed_path_sample(path, (int32_t)t, &qs[n]);
+    }
+    return n;
+}
@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Single precision variants of the scalar solver and sampler.
+ *
+ * The expressions follow src/dubins.c term for term, evaluated in float with
+ * the float libm functions.  The shortest path scan uses the same word
+ * classification as the double solver, with margins wide enough to absorb
+ * the float rounding of alpha, beta and d.
+ */
+#include "dubins_internal.h"
+
+#define TWO_PI_F ((float)(2 * M_PI))
+
+static float mod2pif( float theta )
+{
+    return theta - TWO_PI_F*floorf(theta/TWO_PI_F);
+}
+
+int dubins_intermediate_results_f(DubinsIntermediateResultsF* in, float q0[3], float q1[3], float rho)
+{
+    float dx, dy, D, d, theta, alpha, beta;
+    if( rho <= 0.0f ) {
+        return EDUBBADRHO;
+    }
+
+    dx = q1[0] - q0[0];
+    dy = q1[1] - q0[1];
+    D = sqrtf( dx * dx + dy * dy );
+    d = D / rho;
+    theta = 0;
+
+    /* test required to prevent domain errors if dx=0 and dy=0 */
+    if(d > 0) {
+        theta = mod2pif(atan2f( dy, dx ));
+    }
+    alpha = mod2pif(q0[2] - theta);
+    beta  = mod2pif(q1[2] - theta);
+
+    in->alpha = alpha;
+    in->beta  = beta;
+    in->d     = d;
+    in->sa    = sinf(alpha);
+    in->sb    = sinf(beta);
+    in->ca    = cosf(alpha);
+    in->cb    = cosf(beta);
+    in->c_ab  = cosf(alpha - beta);
+    in->d_sq  = d * d;
+
+    return EDUBOK;
+}
+
+static int dubins_LSL_f(DubinsIntermediateResultsF* in, float out[3])
+{
+    float tmp0 = in->d + in->sa - in->sb;
+    float p_sq = 2 + in->d_sq - (2*in->c_ab) + (2 * in->d * (in->sa - in->sb));
+    if(p_sq >= 0) {
+        float tmp1 = atan2f( (in->cb - in->ca), tmp0 );
+        out[0] = mod2pif(tmp1 - in->alpha);
+        out[1] = sqrtf(p_sq);
+        out[2] = mod2pif(in->beta - tmp1);
+        return EDUBOK;
+    }
+    return EDUBNOPATH;
+}
+
+static int dubins_RSR_f(DubinsIntermediateResultsF* in, float out[3])
+{
+    float tmp0 = in->d - in->sa + in->sb;
+    float p_sq = 2 + in->d_sq - (2 * in->c_ab) + (2 * in->d * (in->sb - in->sa));
+    if( p_sq >= 0 ) {
+        float tmp1 = atan2f( (in->ca - in->cb), tmp0 );
+        out[0] = mod2pif(in->alpha - tmp1);
+        out[1] = sqrtf(p_sq);
+        out[2] = mod2pif(tmp1 -in->beta);
+        return EDUBOK;
+    }
+    return EDUBNOPATH;
+}
+
+static int dubins_LSR_f(DubinsIntermediateResultsF* in, float out[3])
+{
+    float p_sq = -2 + (in->d_sq) + (2 * in->c_ab) + (2 * in->d * (in->sa + in->sb));
+    if( p_sq >= 0 ) {
+        float p    = sqrtf(p_sq);
+        float tmp0 = atan2f( (-in->ca - in->cb), (in->d + in->sa + in->sb) ) - atan2f(-2.0f, p);
+        out[0] = mod2pif(tmp0 - in->alpha);
+        out[1] = p;
+        out[2] = mod2pif(tmp0 - mod2pif(in->beta));
+        return EDUBOK;
+    }
+    return EDUBNOPATH;
+}
+
+static int dubins_RSL_f(DubinsIntermediateResultsF* in, float out[3])
+{
+    float p_sq = -2 + in->d_sq + (2 * in->c_ab) - (2 * in->d * (in->sa + in->sb));
+    if( p_sq >= 0 ) {
+        float p    = sqrtf(p_sq);
+        float tmp0 = atan2f( (in->ca + in->cb), (in->d - in->sa - in->sb) ) - atan2f(2.0f, p);
+        out[0] = mod2pif(in->alpha - tmp0);
+        out[1] = p;
+        out[2] = mod2pif(in->beta - tmp0);
+        return EDUBOK;
+    }
+    return EDUBNOPATH;
+}
+
+static int dubins_RLR_f(DubinsIntermediateResultsF* in, float out[3])
+{
+    float tmp0 = (6.f - in->d_sq + 2*in->c_ab + 2*in->d*(in->sa - in->sb)) / 8.f;
+    float phi  = atan2f( in->ca - in->cb, in->d - in->sa + in->sb );
+    if( fabsf(tmp0) <= 1) {
+        float p = mod2pif(TWO_PI_F - acosf(tmp0) );
+        float t = mod2pif(in->alpha - phi + mod2pif(p/2.f));
+        out[0] = t;
+        out[1] = p;
+        out[2] = mod2pif(in->alpha - in->beta - t + mod2pif(p));
+        return EDUBOK;
+    }
+    return EDUBNOPATH;
+}
+
+static int dubins_LRL_f(DubinsIntermediateResultsF* in, float out[3])
+{
+    float tmp0 = (6.f - in->d_sq + 2*in->c_ab + 2*in->d*(in->sb - in->sa)) / 8.f;
+    float phi = atan2f( in->ca - in->cb, in->d + in->sa - in->sb );
+    if( fabsf(tmp0) <= 1) {
+        float p = mod2pif( TWO_PI_F - acosf( tmp0) );
+        float t = mod2pif(-in->alpha - phi + p/2.f);
+        out[0] = t;
+        out[1] = p;
+        out[2] = mod2pif(mod2pif(in->beta) - in->alpha -t + mod2pif(p));
+        return EDUBOK;
+    }
+    return EDUBNOPATH;
+}
+
+int dubins_word_f(DubinsIntermediateResultsF* in, DubinsPathType pathType, float out[3])
+{
+    switch(pathType)
+    {
+    case LSL:
+        return dubins_LSL_f(in, out);
+    case RSL:
+        return dubins_RSL_f(in, out);
+    case LSR:
+        return dubins_LSR_f(in, out);
+    case RSR:
+        return dubins_RSR_f(in, out);
+    case LRL:
+        return dubins_LRL_f(in, out);
+    case RLR:
+        return dubins_RLR_f(in, out);
+    default:
+        return EDUBNOPATH;
+    }
+}
+
+/* classification margins, well above the float error of alpha, beta and d */
+#define QUADRANT_MARGIN_F (1e-4f)
+#define LONG_PATH_MARGIN_F (1e-3f)
+
+static int near_quadrant_boundary(float angle)
+{
+    float step = (float)(M_PI / 2);
+    float r = angle - step*floorf(angle/step);
+    return r < QUADRANT_MARGIN_F || step - r < QUADRANT_MARGIN_F;
+}
+
+static unsigned candidate_words_f(DubinsIntermediateResultsF* in)
+{
+    DubinsIntermediateResults din;
+    if(in->d < 4.0f + LONG_PATH_MARGIN_F) {
+        return DUBINS_ALL_WORDS;
+    }
+    if(near_quadrant_boundary(in->alpha) || near_quadrant_boundary(in->beta)) {
+        return DUBINS_WORD(LSL) | DUBINS_WORD(LSR) | DUBINS_WORD(RSL) | DUBINS_WORD(RSR);
+    }
+    /* away from every boundary the double classification sees the same quadrants */
+    din.alpha = in->alpha;
+    din.beta = in->beta;
+    din.d = in->d;
+    return dubins_candidate_words(&din);
+}
+
+static int shortest_path_f(DubinsPathF* path, float q0[3], float q1[3], float rho)
+{
+    int i, errcode;
+    DubinsIntermediateResultsF in;
+    float params[3];
+    float cost;
+    float best_cost = INFINITY;
+    int best_word = -1;
+    unsigned words;
+
+    errcode = dubins_intermediate_results_f(&in, q0, q1, rho);
+    if(errcode != EDUBOK) {
+        return errcode;
+    }
+    words = candidate_words_f(&in);
+
+    path->qi[0] = q0[0];
+    path->qi[1] = q0[1];
+    path->qi[2] = q0[2];
+    path->rho = rho;
+
+    for( i = 0; i < 6; i++ ) {
+        DubinsPathType pathType = (DubinsPathType)i;
+        if((words & DUBINS_WORD(i)) != 0 && dubins_word_f(&in, pathType, params) == EDUBOK) {
+            cost = params[0] + params[1] + params[2];
+            if(cost < best_cost) {
+                best_word = i;
+                best_cost = cost;
+                path->param[0] = params[0];
+                path->param[1] = params[1];
+                path->param[2] = params[2];
+                path->type = pathType;
+            }
+        }
+    }
+    if(best_word == -1) {
+        return EDUBNOPATH;
+    }
+    return EDUBOK;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_shortest_path_f(DubinsPathF* path, float q0[3], float q1[3], float rho)
+{
+    return shortest_path_f(path, q0, q1, rho);
+}
+
+int dubins_path_f(DubinsPathF* path, float q0[3], float q1[3], float rho, DubinsPathType pathType)
+{
+    int errcode;
+    DubinsIntermediateResultsF in;
+    errcode = dubins_intermediate_results_f(&in, q0, q1, rho);
+    if(errcode == EDUBOK) {
+        float params[3];
+        errcode = dubins_word_f(&in, pathType, params);
+        if(errcode == EDUBOK) {
+            path->param[0] = params[0];
+            path->param[1] = params[1];
+            path->param[2] = params[2];
+            path->qi[0] = q0[0];
+            path->qi[1] = q0[1];
+            path->qi[2] = q0[2];
+            path->rho = rho;
+            path->type = pathType;
+        }
+    }
+    return errcode;
+}
+
+int dubins_shortest_path_many_f(DubinsPathF* paths, const float* q0s, const float* q1s, float rho,
+                                int* errcodes, size_t n)
+{
+    float q0[3], q1[3];
+    size_t i;
+    int j, err, first_error = EDUBOK;
+    for( i = 0; i < n; i++ ) {
+        DubinsPathF* path = &paths[i];
+        for( j = 0; j < 3; j++ ) {
+            q0[j] = q0s[3 * i + j];
+            q1[j] = q1s[3 * i + j];
+        }
+        err = shortest_path_f(path, q0, q1, rho);
+        if(err != EDUBOK) {
+            path->qi[0] = q0[0];
+            path->qi[1] = q0[1];
+            path->qi[2] = q0[2];
+            path->param[0] = 0;
+            path->param[1] = 0;
+            path->param[2] = 0;
+            path->rho = rho;
+            path->type = LSL;
+            if(first_error == EDUBOK) {
+                first_error = err;
+            }
+        }
+        if(errcodes != NULL) {
+            errcodes[i] = err;
+        }
+    }
+    return first_error;
+}
+
+EMSCRIPTEN_KEEPALIVE
+float dubins_path_length_f( DubinsPathF* path )
+{
+    float length = 0.f;
+    length += path->param[0];
+    length += path->param[1];
+    length += path->param[2];
+    length = length * path->rho;
+    return length;
+}
+
+static void dubins_segment_f( float t, float qi[3], float qt[3], SegmentType type)
+{
+    float st = sinf(qi[2]);
+    float ct = cosf(qi[2]);
+    if( type == L_SEG ) {
+        qt[0] = +sinf(qi[2]+t) - st;
+        qt[1] = -cosf(qi[2]+t) + ct;
+        qt[2] = t;
+    }
+    else if( type == R_SEG ) {
+        qt[0] = -sinf(qi[2]-t) + st;
+        qt[1] = +cosf(qi[2]-t) - ct;
+        qt[2] = -t;
+    }
+    else if( type == S_SEG ) {
+        qt[0] = ct * t;
+        qt[1] = st * t;
+        qt[2] = 0.0f;
+    }
+    qt[0] += qi[0];
+    qt[1] += qi[1];
+    qt[2] += qi[2];
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_path_sample_f( DubinsPathF* path, float t, float q[3] )
+{
+    /* tprime is the normalised variant of the parameter t */
+    float tprime = t / path->rho;
+    float qi[3]; /* The translated initial configuration */
+    float q1[3]; /* end-of segment 1 */
+    float q2[3]; /* end-of segment 2 */
+    const SegmentType* types = DIRDATA[path->type];
+    float p1, p2;
+
+    if( t < 0 || t > dubins_path_length_f(path) ) {
+        return EDUBPARAM;
+    }
+
+    /* initial configuration */
+    qi[0] = 0.0f;
+    qi[1] = 0.0f;
+    qi[2] = path->qi[2];
+
+    /* generate the target configuration */
+    p1 = path->param[0];
+    p2 = path->param[1];
+    dubins_segment_f( p1,      qi,    q1, types[0] );
+    dubins_segment_f( p2,      q1,    q2, types[1] );
+    if( tprime < p1 ) {
+        dubins_segment_f( tprime, qi, q, types[0] );
+    }
+    else if( tprime < (p1+p2) ) {
+        dubins_segment_f( tprime-p1, q1, q,  types[1] );
+    }
+    else {
+        dubins_segment_f( tprime-p1-p2, q2, q,  types[2] );
+    }
+
+    /* scale the target configuration, translate back to the original starting point */
+    q[0] = q[0] * path->rho + path->qi[0];
+    q[1] = q[1] * path->rho + path->qi[1];
+    q[2] = mod2pif(q[2]);
+
+    return EDUBOK;
+}
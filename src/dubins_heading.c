@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Shortest paths to a goal position over many goal headings.
+ *
+ * Everything that depends only on the start configuration and the goal
+ * position (d, theta, alpha and its sine and cosine) is computed once, and
+ * blocks of candidate headings go through the same block solver as the
+ * batch API.
+ */
+#include <string.h>
+#include "dubins_internal.h"
+
+typedef struct
+{
+    double d;
+    double theta;
+    double alpha;
+    double sa;
+    double ca;
+} HeadingShared;
+
+/* the heading-independent part of dubins_intermediate_results */
+static int heading_shared(HeadingShared* hs, double q0[3], double x1, double y1, double rho)
+{
+    double dx, dy;
+    if( rho <= 0.0 ) {
+        return EDUBBADRHO;
+    }
+    dx = x1 - q0[0];
+    dy = y1 - q0[1];
+    hs->d = sqrt( dx * dx + dy * dy ) / rho;
+    hs->theta = 0;
+    if(hs->d > 0) {
+        hs->theta = mod2pi(atan2( dy, dx ));
+    }
+    hs->alpha = mod2pi(q0[2] - hs->theta);
+    hs->sa = sin(hs->alpha);
+    hs->ca = cos(hs->alpha);
+    return EDUBOK;
+}
+
+/* fill a block for n goal headings, returning the union of their candidate words */
+static unsigned heading_block(DubinsIntermediateBlock* blk, const HeadingShared* hs,
+                              const double* headings, size_t n)
+{
+    DubinsIntermediateResults in;
+    unsigned words = 0;
+    size_t i;
+    for( i = 0; i < n; i++ ) {
+        blk->alpha[i] = hs->alpha;
+        blk->d[i] = hs->d;
+        blk->sa[i] = hs->sa;
+        blk->ca[i] = hs->ca;
+        blk->d_sq[i] = hs->d * hs->d;
+        blk->errcode[i] = EDUBOK;
+        blk->beta[i] = mod2pi(headings[i] - hs->theta);
+    }
+    for( i = 0; i < n; i++ ) {
+        blk->sb[i] = sin(blk->beta[i]);
+        blk->cb[i] = cos(blk->beta[i]);
+    }
+    for( i = 0; i < n; i++ ) {
+        blk->c_ab[i] = cos(blk->alpha[i] - blk->beta[i]);
+    }
+    in.alpha = hs->alpha;
+    in.d = hs->d;
+    for( i = 0; i < n && words != DUBINS_ALL_WORDS; i++ ) {
+        in.beta = blk->beta[i];
+        words |= dubins_candidate_words(&in);
+    }
+    dubins_intermediate_block_pad(blk, n);
+    return words;
+}
+
+/*
+ * Minimum over headings[0..n), or over n evenly spaced headings from
+ * range[0] to range[1] when headings is NULL
+ */
+static int shortest_over_headings(DubinsPath* path, double q0[3], double x1, double y1,
+                                  const double* headings, const double range[2], size_t n,
+                                  double rho, size_t* best_index)
+{
+    HeadingShared hs;
+    DubinsIntermediateBlock blk;
+    DubinsBlockResult res;
+    double block_headings[DUBINS_BLOCK_SIZE];
+    const double* h;
+    double best_cost = INFINITY;
+    size_t offset, count, i, best = 0;
+    unsigned words;
+    int errcode = heading_shared(&hs, q0, x1, y1, rho);
+    if(errcode != EDUBOK) {
+        return errcode;
+    }
+    if(n == 0) {
+        return EDUBPARAM;
+    }
+
+    for( offset = 0; offset < n; offset += count ) {
+        count = n - offset;
+        if(count > DUBINS_BLOCK_SIZE) {
+            count = DUBINS_BLOCK_SIZE;
+        }
+        if(headings != NULL) {
+            h = headings + offset;
+        }
+        else {
+            for( i = 0; i < count; i++ ) {
+                block_headings[i] = (n == 1) ? range[0]
+                    : range[0] + (range[1] - range[0]) * (double)(offset + i) / (double)(n - 1);
+            }
+            h = block_headings;
+        }
+        words = heading_block(&blk, &hs, h, count);
+        dubins_words_block(&blk, count, words, &res);
+        for( i = 0; i < count; i++ ) {
+            if(res.word[i] != -1 && res.cost[i] < best_cost) {
+                best_cost = res.cost[i];
+                best = offset + i;
+                path->param[0] = res.param[0][i];
+                path->param[1] = res.param[1][i];
+                path->param[2] = res.param[2][i];
+                path->type = (DubinsPathType)res.word[i];
+            }
+        }
+    }
+    if(best_cost == INFINITY) {
+        return EDUBNOPATH;
+    }
+    DUBINS_STAT_INC(wins[path->type]);
+    path->qi[0] = q0[0];
+    path->qi[1] = q0[1];
+    path->qi[2] = q0[2];
+    path->rho = rho;
+    if(best_index != NULL) {
+        *best_index = best;
+    }
+    return EDUBOK;
+}
+
+int dubins_shortest_path_headings(DubinsPath* path, double q0[3], double x1, double y1,
+                                  const double* headings, size_t n, double rho, size_t* best_index)
+{
+    return shortest_over_headings(path, q0, x1, y1, headings, NULL, n, rho, best_index);
+}
+
+int dubins_shortest_path_heading_range(DubinsPath* path, double q0[3], double x1, double y1,
+                                       double heading_min, double heading_max, size_t n, double rho,
+                                       double* best_heading)
+{
+    double range[2];
+    size_t best;
+    int errcode;
+    range[0] = heading_min;
+    range[1] = heading_max;
+    errcode = shortest_over_headings(path, q0, x1, y1, NULL, range, n, rho, &best);
+    if(errcode == EDUBOK && best_heading != NULL) {
+        *best_heading = (n == 1) ? heading_min
+            : heading_min + (heading_max - heading_min) * (double)best / (double)(n - 1);
+    }
+    return errcode;
+}
+
+/* keep the shorter of the current best and a candidate with normalised params t, u, v */
+static void keep_shorter(DubinsPath* path, double* best, DubinsPathType type, double t, double u, double v)
+{
+    double cost = t + u + v;
+    if(cost < *best) {
+        *best = cost;
+        path->type = type;
+        path->param[0] = t;
+        path->param[1] = u;
+        path->param[2] = v;
+    }
+}
+
+int dubins_shortest_path_free_heading(DubinsPath* path, double q0[3], double x1, double y1, double rho)
+{
+    double best = INFINITY;
+    double st, ct, cx, cy, vx, vy, r, phi, a0, beta, gamma, psi, c2x, c2y, omega;
+    int side, k;
+
+    if( rho <= 0.0 ) {
+        return EDUBBADRHO;
+    }
+    st = sin(q0[2]);
+    ct = cos(q0[2]);
+
+    /* side +1 starts with a left turn, side -1 with a right turn */
+    for( side = 1; side >= -1; side -= 2 ) {
+        /* the first turning circle, normalised to rho = 1 */
+        cx = (q0[0] - side * rho * st) / rho;
+        cy = (q0[1] + side * rho * ct) / rho;
+        vx = x1 / rho - cx;
+        vy = y1 / rho - cy;
+        r = sqrt(vx * vx + vy * vy);
+        phi = atan2(vy, vx);
+        /* angle of the start on the first circle */
+        a0 = q0[2] - side * M_PI / 2;
+
+        /* CS: leave the circle along the tangent through the goal */
+        if( r >= 1.0 ) {
+            beta = acos(1.0 / r);
+            psi = phi - side * beta;
+            keep_shorter(path, &best, (side > 0) ? LSL : RSR,
+                         mod2pi(side * (psi - a0)), sqrt(r * r - 1.0), 0.0);
+        }
+
+        /* CC: switch to the opposite circle, which must pass through the goal */
+        if( r >= 1.0 && r <= 3.0 ) {
+            gamma = acos(fmin(1.0, (3.0 + r * r) / (4.0 * r)));
+            for( k = -1; k <= 1; k += 2 ) {
+                psi = phi + k * gamma;
+                c2x = cx + 2 * cos(psi);
+                c2y = cy + 2 * sin(psi);
+                omega = atan2(y1 / rho - c2y, x1 / rho - c2x);
+                keep_shorter(path, &best, (side > 0) ? LRL : RLR,
+                             mod2pi(side * (psi - a0)), mod2pi(side * (psi + M_PI - omega)), 0.0);
+            }
+        }
+    }
+    if(best == INFINITY) {
+        return EDUBNOPATH;
+    }
+    path->qi[0] = q0[0];
+    path->qi[1] = q0[1];
+    path->qi[2] = q0[2];
+    path->rho = rho;
+    return EDUBOK;
+}
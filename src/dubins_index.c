@@ -0,0 +1,488 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Nearest neighbour queries over a growing set of configurations.
+ *
+ * Configurations live in a uniform (x, y) grid whose occupied cells are kept
+ * in an open addressing hash table, each cell holding a singly linked list of
+ * configuration ids.  Queries visit square rings of cells around the query
+ * position; the straight line distance to the nearest cell of a ring bounds
+ * the path length of everything in and beyond it, so the scan stops as soon
+ * as that bound passes the current search limit.  Rings that would cost more
+ * than a pass over the whole table, as around far outliers, are replaced by
+ * that pass.
+ */
+#include "dubins_index.h"
+#include "dubins_internal.h"
+
+#include <stdlib.h>
+
+#define DUBINS_INDEX_NONE ((size_t)-1)
+
+/* keeps cell coordinates, and ring extents around them, inside a 32-bit long */
+#define DUBINS_INDEX_CELL_LIMIT (1L << 29)
+
+typedef struct
+{
+    long ix;
+    long iy;
+    /* first configuration of the cell, or DUBINS_INDEX_NONE for an empty slot */
+    size_t head;
+} DubinsIndexCell;
+
+struct DubinsIndex
+{
+    double rho;
+    double cell_size;
+
+    /* configurations as x, y, theta triples, and the next id in each cell */
+    double* q;
+    size_t* next;
+    size_t n;
+    size_t capacity;
+
+    /* hash table of occupied cells, the capacity is a power of two */
+    DubinsIndexCell* cells;
+    size_t n_cells;
+    size_t cell_capacity;
+
+    /* extent of the occupied cells */
+    long ix_min;
+    long ix_max;
+    long iy_min;
+    long iy_max;
+};
+
+typedef struct
+{
+    const DubinsIndex* index;
+    double* q;
+    DubinsIndexDirection direction;
+    /* lengths above this are not reported */
+    double limit;
+    /* non-zero for radius queries, zero for nearest neighbour queries */
+    int radius;
+    size_t* ids;
+    double* lengths;
+    size_t capacity;
+    size_t n_found;
+} DubinsIndexQuery;
+
+static long cell_coordinate(double v, double cell_size)
+{
+    double c = floor(v / cell_size);
+    if(c < -DUBINS_INDEX_CELL_LIMIT) {
+        return -DUBINS_INDEX_CELL_LIMIT;
+    }
+    if(c > DUBINS_INDEX_CELL_LIMIT) {
+        return DUBINS_INDEX_CELL_LIMIT;
+    }
+    return (long)c;
+}
+
+/* false when any coordinate is infinite or NaN */
+static int finite_config(const double q[3])
+{
+    return q[0] - q[0] == 0.0 && q[1] - q[1] == 0.0 && q[2] - q[2] == 0.0;
+}
+
+static size_t cell_hash(long ix, long iy)
+{
+    unsigned long h = (unsigned long)ix * 0x9E3779B1UL ^ (unsigned long)iy * 0x85EBCA77UL;
+    return (size_t)(h ^ (h >> 15));
+}
+
+/* the slot holding cell (ix, iy), or the empty slot where it would go */
+static DubinsIndexCell* find_cell(DubinsIndexCell* cells, size_t capacity, long ix, long iy)
+{
+    size_t mask = capacity - 1;
+    size_t slot = cell_hash(ix, iy) & mask;
+    while(cells[slot].head != DUBINS_INDEX_NONE
+          && (cells[slot].ix != ix || cells[slot].iy != iy)) {
+        slot = (slot + 1) & mask;
+    }
+    return &cells[slot];
+}
+
+static DubinsIndexCell* allocate_cells(size_t capacity)
+{
+    size_t i;
+    DubinsIndexCell* cells = (DubinsIndexCell*)malloc(capacity * sizeof(DubinsIndexCell));
+    if(cells != NULL) {
+        for( i = 0; i < capacity; i++ ) {
+            cells[i].head = DUBINS_INDEX_NONE;
+        }
+    }
+    return cells;
+}
+
+static int grow_cells(DubinsIndex* index)
+{
+    size_t i;
+    size_t capacity = index->cell_capacity * 2;
+    DubinsIndexCell* cells = allocate_cells(capacity);
+    if(cells == NULL) {
+        return EDUBNOMEM;
+    }
+    for( i = 0; i < index->cell_capacity; i++ ) {
+        if(index->cells[i].head != DUBINS_INDEX_NONE) {
+            *find_cell(cells, capacity, index->cells[i].ix, index->cells[i].iy) = index->cells[i];
+        }
+    }
+    free(index->cells);
+    index->cells = cells;
+    index->cell_capacity = capacity;
+    return EDUBOK;
+}
+
+static int grow_configs(DubinsIndex* index)
+{
+    size_t capacity = index->capacity ? index->capacity * 2 : 64;
+    double* q = (double*)realloc(index->q, capacity * 3 * sizeof(double));
+    size_t* next;
+    if(q == NULL) {
+        return EDUBNOMEM;
+    }
+    index->q = q;
+    next = (size_t*)realloc(index->next, capacity * sizeof(size_t));
+    if(next == NULL) {
+        return EDUBNOMEM;
+    }
+    index->next = next;
+    index->capacity = capacity;
+    return EDUBOK;
+}
+
+EMSCRIPTEN_KEEPALIVE
+DubinsIndex* dubins_index_create(double rho, double cell_size)
+{
+    DubinsIndex* index;
+    if(!(rho > 0.0) || !(cell_size >= 0.0) || rho == INFINITY || cell_size == INFINITY) {
+        return NULL;
+    }
+    index = (DubinsIndex*)calloc(1, sizeof(DubinsIndex));
+    if(index == NULL) {
+        return NULL;
+    }
+    index->rho = rho;
+    index->cell_size = (cell_size > 0.0) ? cell_size : 4.0 * rho;
+    index->cell_capacity = 64;
+    index->cells = allocate_cells(index->cell_capacity);
+    if(index->cells == NULL) {
+        free(index);
+        return NULL;
+    }
+    return index;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void dubins_index_destroy(DubinsIndex* index)
+{
+    if(index == NULL) {
+        return;
+    }
+    free(index->q);
+    free(index->next);
+    free(index->cells);
+    free(index);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_index_insert(DubinsIndex* index, const double q[3], size_t* id)
+{
+    DubinsIndexCell* cell;
+    long ix, iy;
+    int errcode;
+
+    if(!finite_config(q)) {
+        return EDUBPARAM;
+    }
+    if(index->n == index->capacity && (errcode = grow_configs(index)) != EDUBOK) {
+        return errcode;
+    }
+    ix = cell_coordinate(q[0], index->cell_size);
+    iy = cell_coordinate(q[1], index->cell_size);
+    cell = find_cell(index->cells, index->cell_capacity, ix, iy);
+    if(cell->head == DUBINS_INDEX_NONE) {
+        /* keep the table at most half full */
+        if(2 * (index->n_cells + 1) > index->cell_capacity) {
+            if((errcode = grow_cells(index)) != EDUBOK) {
+                return errcode;
+            }
+            cell = find_cell(index->cells, index->cell_capacity, ix, iy);
+        }
+        cell->ix = ix;
+        cell->iy = iy;
+        if(index->n_cells == 0) {
+            index->ix_min = index->ix_max = ix;
+            index->iy_min = index->iy_max = iy;
+        }
+        index->ix_min = (ix < index->ix_min) ? ix : index->ix_min;
+        index->ix_max = (ix > index->ix_max) ? ix : index->ix_max;
+        index->iy_min = (iy < index->iy_min) ? iy : index->iy_min;
+        index->iy_max = (iy > index->iy_max) ? iy : index->iy_max;
+        index->n_cells++;
+    }
+
+    index->q[3 * index->n + 0] = q[0];
+    index->q[3 * index->n + 1] = q[1];
+    index->q[3 * index->n + 2] = q[2];
+    index->next[index->n] = cell->head;
+    cell->head = index->n;
+    if(id != NULL) {
+        *id = index->n;
+    }
+    index->n++;
+    return EDUBOK;
+}
+
+EMSCRIPTEN_KEEPALIVE
+size_t dubins_index_size(const DubinsIndex* index)
+{
+    return index->n;
+}
+
+EMSCRIPTEN_KEEPALIVE
+const double* dubins_index_config(const DubinsIndex* index, size_t id)
+{
+    return (id < index->n) ? &index->q[3 * id] : NULL;
+}
+
+static void knn_accept(DubinsIndexQuery* query, size_t id, double length)
+{
+    size_t k = query->capacity;
+    size_t i = (query->n_found < k) ? query->n_found++ : k - 1;
+
+    /* insertion into the sorted list, dropping the current last entry when full */
+    while(i > 0 && (query->lengths[i - 1] > length
+                    || (query->lengths[i - 1] == length && query->ids[i - 1] > id))) {
+        query->lengths[i] = query->lengths[i - 1];
+        query->ids[i] = query->ids[i - 1];
+        i--;
+    }
+    query->lengths[i] = length;
+    query->ids[i] = id;
+    if(query->n_found == k) {
+        query->limit = query->lengths[k - 1];
+    }
+}
+
+static void visit(DubinsIndexQuery* query, size_t id)
+{
+    const DubinsIndex* index = query->index;
+    DubinsIntermediateResults in;
+    double node[3];
+    double distance, length;
+    size_t k = query->capacity;
+    int errcode;
+
+    node[0] = index->q[3 * id + 0];
+    node[1] = index->q[3 * id + 1];
+    node[2] = index->q[3 * id + 2];
+    distance = sqrt((node[0] - query->q[0]) * (node[0] - query->q[0])
+                    + (node[1] - query->q[1]) * (node[1] - query->q[1]));
+    if(distance > query->limit) {
+        return;
+    }
+
+    /*
+     * An LSL path always exists, and turning at most a full circle on to and
+     * off its centre line bounds it by the distance plus (4 pi + 2) rho
+     */
+    if(query->radius && query->lengths == NULL
+       && distance + (4.0 * M_PI + 2.0) * index->rho <= query->limit) {
+        if(query->n_found < query->capacity) {
+            query->ids[query->n_found] = id;
+        }
+        query->n_found++;
+        return;
+    }
+
+    if(query->direction == DUBINS_INDEX_FROM_QUERY) {
+        errcode = dubins_intermediate_results(&in, query->q, node, index->rho);
+    }
+    else {
+        errcode = dubins_intermediate_results(&in, node, query->q, index->rho);
+    }
+    if(errcode != EDUBOK) {
+        return;
+    }
+    length = dubins_shortest_cost(&in) * index->rho;
+
+    if(query->radius) {
+        if(length <= query->limit) {
+            if(query->n_found < query->capacity) {
+                query->ids[query->n_found] = id;
+                if(query->lengths != NULL) {
+                    query->lengths[query->n_found] = length;
+                }
+            }
+            query->n_found++;
+        }
+    }
+    else if(query->n_found < k || length < query->limit
+            || (length == query->limit && id < query->ids[k - 1])) {
+        knn_accept(query, id, length);
+    }
+}
+
+static void visit_cell(DubinsIndexQuery* query, long ix, long iy)
+{
+    const DubinsIndex* index = query->index;
+    const DubinsIndexCell* cell = find_cell(index->cells, index->cell_capacity, ix, iy);
+    size_t id;
+    for( id = cell->head; id != DUBINS_INDEX_NONE; id = index->next[id] ) {
+        visit(query, id);
+    }
+}
+
+/* visit every occupied cell at least r rings away from (cx, cy) */
+static void sweep(DubinsIndexQuery* query, long cx, long cy, long r)
+{
+    const DubinsIndex* index = query->index;
+    const DubinsIndexCell* cell;
+    size_t slot, id;
+    long dx, dy;
+    for( slot = 0; slot < index->cell_capacity; slot++ ) {
+        cell = &index->cells[slot];
+        if(cell->head == DUBINS_INDEX_NONE) {
+            continue;
+        }
+        dx = (cell->ix > cx) ? cell->ix - cx : cx - cell->ix;
+        dy = (cell->iy > cy) ? cell->iy - cy : cy - cell->iy;
+        if(dx < r && dy < r) {
+            continue;
+        }
+        for( id = cell->head; id != DUBINS_INDEX_NONE; id = index->next[id] ) {
+            visit(query, id);
+        }
+    }
+}
+
+static void search(DubinsIndexQuery* query)
+{
+    const DubinsIndex* index = query->index;
+    double cs = index->cell_size;
+    long cx = cell_coordinate(query->q[0], cs);
+    long cy = cell_coordinate(query->q[1], cs);
+    double ox = query->q[0] - (double)cx * cs;
+    double oy = query->q[1] - (double)cy * cs;
+    double margin;
+    long r, ix, iy, x_lo, x_hi, y_lo, y_hi;
+
+    /* distance from q to the edge of its own cell */
+    margin = ox;
+    margin = (cs - ox < margin) ? cs - ox : margin;
+    margin = (oy < margin) ? oy : margin;
+    margin = (cs - oy < margin) ? cs - oy : margin;
+    margin = (margin > 0.0) ? margin : 0.0;
+
+    if(index->n == 0) {
+        return;
+    }
+    for( r = 0; ; r++ ) {
+        if(r > 0 && (double)(r - 1) * cs + margin > query->limit) {
+            break;
+        }
+        /* once a ring has more cells than the table has slots, sweep the table instead */
+        if((double)r * 8.0 > (double)index->cell_capacity) {
+            sweep(query, cx, cy, r);
+            break;
+        }
+        x_lo = (cx - r > index->ix_min) ? cx - r : index->ix_min;
+        x_hi = (cx + r < index->ix_max) ? cx + r : index->ix_max;
+        y_lo = (cy - r + 1 > index->iy_min) ? cy - r + 1 : index->iy_min;
+        y_hi = (cy + r - 1 < index->iy_max) ? cy + r - 1 : index->iy_max;
+        if(cy - r >= index->iy_min && cy - r <= index->iy_max) {
+            for( ix = x_lo; ix <= x_hi; ix++ ) {
+                visit_cell(query, ix, cy - r);
+            }
+        }
+        if(r > 0 && cy + r >= index->iy_min && cy + r <= index->iy_max) {
+            for( ix = x_lo; ix <= x_hi; ix++ ) {
+                visit_cell(query, ix, cy + r);
+            }
+        }
+        if(cx - r >= index->ix_min && cx - r <= index->ix_max) {
+            for( iy = y_lo; iy <= y_hi; iy++ ) {
+                visit_cell(query, cx - r, iy);
+            }
+        }
+        if(r > 0 && cx + r >= index->ix_min && cx + r <= index->ix_max) {
+            for( iy = y_lo; iy <= y_hi; iy++ ) {
+                visit_cell(query, cx + r, iy);
+            }
+        }
+        /* every occupied cell has been visited */
+        if(cx - r <= index->ix_min && cx + r >= index->ix_max
+           && cy - r <= index->iy_min && cy + r >= index->iy_max) {
+            break;
+        }
+    }
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_index_knn(const DubinsIndex* index, double q[3], DubinsIndexDirection direction,
+                     size_t k, size_t* ids, double* lengths, size_t* n_found)
+{
+    DubinsIndexQuery query;
+    if(!finite_config(q)) {
+        return EDUBPARAM;
+    }
+    query.index = index;
+    query.q = q;
+    query.direction = direction;
+    query.limit = INFINITY;
+    query.radius = 0;
+    query.ids = ids;
+    query.lengths = lengths;
+    query.capacity = k;
+    query.n_found = 0;
+    if(k > 0) {
+        search(&query);
+    }
+    *n_found = query.n_found;
+    return EDUBOK;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_index_radius(const DubinsIndex* index, double q[3], DubinsIndexDirection direction,
+                        double radius, size_t* ids, double* lengths, size_t capacity, size_t* n_found)
+{
+    DubinsIndexQuery query;
+    if(!finite_config(q) || !(radius >= 0.0)) {
+        return EDUBPARAM;
+    }
+    query.index = index;
+    query.q = q;
+    query.direction = direction;
+    query.limit = radius;
+    query.radius = 1;
+    query.ids = ids;
+    query.lengths = lengths;
+    query.capacity = capacity;
+    query.n_found = 0;
+    search(&query);
+    *n_found = query.n_found;
+    return EDUBOK;
+}
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Declarations shared between the translation units of the library.
+ * Nothing in here is part of the public API.
+ */
+#ifndef DUBINS_INTERNAL_H
+#define DUBINS_INTERNAL_H
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+
+#include <math.h>
+#include <stddef.h>
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#else
+#define EMSCRIPTEN_KEEPALIVE
+#endif
+
+#include "dubins.h"
+
+#define EPSILON (10e-10)
+
+typedef enum
+{
+    L_SEG = 0,
+    S_SEG = 1,
+    R_SEG = 2
+} SegmentType;
+
+/* The segment types for each of the Path types */
+extern const SegmentType DIRDATA[][3];
+
+typedef struct
+{
+    double alpha;
+    double beta;
+    double d;
+    double sa;
+    double sb;
+    double ca;
+    double cb;
+    double c_ab;
+    double d_sq;
+} DubinsIntermediateResults;
+
+/* Number of pairs processed together by the batch solvers */
+#define DUBINS_BLOCK_SIZE (64)
+
+/* Widest vector used by a block solver, blocks are padded to a multiple of it */
+#define DUBINS_SIMD_MAX_LANES (8)
+
+/* Word sets are bitmasks, bit i stands for DubinsPathType i */
+#define DUBINS_WORD(w) (1u << (w))
+#define DUBINS_ALL_WORDS (0x3fu)
+
+/**
+ * Structure-of-arrays variant of DubinsIntermediateResults, holding
+ * up to DUBINS_BLOCK_SIZE problems at once
+ */
+typedef struct
+{
+    double alpha[DUBINS_BLOCK_SIZE];
+    double beta[DUBINS_BLOCK_SIZE];
+    double d[DUBINS_BLOCK_SIZE];
+    double sa[DUBINS_BLOCK_SIZE];
+    double sb[DUBINS_BLOCK_SIZE];
+    double ca[DUBINS_BLOCK_SIZE];
+    double cb[DUBINS_BLOCK_SIZE];
+    double c_ab[DUBINS_BLOCK_SIZE];
+    double d_sq[DUBINS_BLOCK_SIZE];
+    /* EDUBOK, or the reason this problem could not be set up */
+    int errcode[DUBINS_BLOCK_SIZE];
+} DubinsIntermediateBlock;
+
+/**
+ * Best word found for each problem of a DubinsIntermediateBlock
+ */
+typedef struct
+{
+    double cost[DUBINS_BLOCK_SIZE];
+    double param[3][DUBINS_BLOCK_SIZE];
+    /* index of the winning DubinsPathType, or -1 if no word is feasible */
+    int word[DUBINS_BLOCK_SIZE];
+} DubinsBlockResult;
+
+double fmodr( double x, double y );
+double mod2pi( double theta );
+
+int dubins_intermediate_results(DubinsIntermediateResults* in, double q0[3], double q1[3], double rho);
+int dubins_word(DubinsIntermediateResults* in, DubinsPathType pathType, double out[3]);
+int dubins_LSL(DubinsIntermediateResults* in, double out[3]);
+int dubins_RSR(DubinsIntermediateResults* in, double out[3]);
+int dubins_LSR(DubinsIntermediateResults* in, double out[3]);
+int dubins_RSL(DubinsIntermediateResults* in, double out[3]);
+int dubins_RLR(DubinsIntermediateResults* in, double out[3]);
+int dubins_LRL(DubinsIntermediateResults* in, double out[3]);
+
+void dubins_segment( double t, double qi[3], double qt[3], SegmentType type );
+
+/**
+ * Choose the shortest of a set of words, as dubins_shortest_path does
+ *
+ * Only the type and param members of the path are written.
+ */
+int dubins_scan_words(DubinsPath* path, DubinsIntermediateResults* in, unsigned words);
+
+/* Single precision counterpart of DubinsIntermediateResults */
+typedef struct
+{
+    float alpha;
+    float beta;
+    float d;
+    float sa;
+    float sb;
+    float ca;
+    float cb;
+    float c_ab;
+    float d_sq;
+} DubinsIntermediateResultsF;
+
+int dubins_intermediate_results_f(DubinsIntermediateResultsF* in, float q0[3], float q1[3], float rho);
+int dubins_word_f(DubinsIntermediateResultsF* in, DubinsPathType pathType, float out[3]);
+
+/**
+ * The set of words that can be the shortest for these intermediate results
+ *
+ * Bit i of the result stands for DubinsPathType i.  Configurations close to
+ * a quadrant boundary fall back to a wider set, so ties are broken the same
+ * way as a scan of all six words.
+ */
+unsigned dubins_candidate_words(DubinsIntermediateResults* in);
+
+/**
+ * The normalised length of the shortest word, or INFINITY if none is feasible
+ *
+ * Words are visited in order of a cheap lower bound on their length and the
+ * search stops once no remaining word can beat the best so far.
+ */
+double dubins_shortest_cost(DubinsIntermediateResults* in);
+
+/**
+ * Fill a block with the intermediate results of problems [offset, offset+n)
+ * of a batch, n must not exceed DUBINS_BLOCK_SIZE
+ *
+ * Lanes past n, up to the next multiple of DUBINS_SIMD_MAX_LANES, are padded
+ * with harmless values and flagged as failed.
+ */
+void dubins_intermediate_block(DubinsIntermediateBlock* blk, const DubinsBatchInput* in,
+                               size_t offset, size_t n);
+
+/**
+ * Pad the lanes of a block past n up to the next multiple of
+ * DUBINS_SIMD_MAX_LANES, flagging them as failed
+ */
+void dubins_intermediate_block_pad(DubinsIntermediateBlock* blk, size_t n);
+
+/**
+ * Evaluate the words in the set for every problem of a block and keep the
+ * shortest, using the same tie-breaking as dubins_shortest_path
+ */
+void dubins_words_block_scalar(const DubinsIntermediateBlock* blk, size_t n, unsigned words, DubinsBlockResult* res);
+
+/**
+ * As dubins_words_block_scalar, using the vector kernel selected by
+ * dubins_simd_level
+ */
+void dubins_words_block(const DubinsIntermediateBlock* blk, size_t n, unsigned words, DubinsBlockResult* res);
+
+/**
+ * Copy the results of a solved block into entries [offset, offset+n) of a
+ * batch output, marking failed problems as dubins_shortest_path_batch does
+ *
+ * @param rho - the n turning radii of the block, or NULL to use rho_shared
+ * @return    - the error code of the first failing problem, or EDUBOK
+ */
+int dubins_block_store(DubinsIntermediateBlock* blk, DubinsBlockResult* res, size_t n,
+                       const double* rho, double rho_shared, DubinsBatchOutput* out, size_t offset);
+
+/**
+ * A read-only view of a whole file
+ */
+typedef struct
+{
+    void* data;
+    size_t size;
+    /* platform specific handle kept alive by the mapping */
+    void* handle;
+} DubinsMapping;
+
+/**
+ * Map a file read-only, falling back to reading it into memory where mmap
+ * is unavailable
+ *
+ * @return - EDUBIO if the file cannot be opened or is empty
+ */
+int dubins_map_file(DubinsMapping* m, const char* filename);
+
+/**
+ * Release a mapping created by dubins_map_file
+ */
+void dubins_unmap_file(DubinsMapping* m);
+
+/**
+ * Non-zero if the host stores integers little-endian, as the file formats do
+ */
+int dubins_host_is_little_endian(void);
+
+#ifdef DUBINS_ENABLE_STATS
+/* the counters of the calling thread */
+DubinsStats* dubins_stats_local(void);
+#ifdef DUBINS_ENABLE_STATS_TIMING
+uint64_t dubins_stats_clock(void);
+#define DUBINS_STATS_CLOCK() dubins_stats_clock()
+#else
+#define DUBINS_STATS_CLOCK() ((uint64_t)0)
+#endif
+#define DUBINS_STAT_ADD(field, n) (dubins_stats_local()->field += (n))
+#else
+#define DUBINS_STAT_ADD(field, n) ((void)0)
+#endif
+#define DUBINS_STAT_INC(field) DUBINS_STAT_ADD(field, 1)
+
+#endif /* DUBINS_INTERNAL_H */
@@ -0,0 +1,55 @@
+/**
+ * Dubins module loader
+ *
+ * Loads the SIMD128 + threads build (dubins.simd.js) where the runtime can
+ * run it, and the scalar build (dubins.js) everywhere else.  Takes the same
+ * options and returns the same promise as calling either module factory.
+ *
+ * solveBatch and createPool are the asynchronous batch API of
+ * dubins_async.js, which solves on worker threads instead of the caller's.
+ */
+
+/* a function using i8x16.splat and i8x16.popcnt, which only validates with SIMD128 */
+const SIMD_PROBE = new Uint8Array([
+    0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0, 10, 10, 1, 8, 0,
+    65, 0, 253, 15, 253, 98, 11
+])
+
+function supportsSimd() {
+    try {
+        return typeof WebAssembly === 'object' && WebAssembly.validate(SIMD_PROBE)
+    } catch (e) {
+        return false
+    }
+}
+
+function supportsThreads() {
+    if (typeof SharedArrayBuffer === 'undefined') return false
+    /* browsers only hand out shared memory to cross-origin isolated pages */
+    if (typeof crossOriginIsolated !== 'undefined' && !crossOriginIsolated) return false
+    try {
+        let memory = new WebAssembly.Memory({ initial: 1, maximum: 1, shared: true })
+        return memory.buffer instanceof SharedArrayBuffer
+    } catch (e) {
+        return false
+    }
+}
+
+function loadDubins(options) {
+    if (supportsSimd() && supportsThreads()) {
+        try {
+            return require('./dubins.simd.js')(options)
+        } catch (e) {
+            /* the SIMD build is optional, fall back to the scalar one only when it is missing */
+            if (e.code !== 'MODULE_NOT_FOUND') throw e
+        }
+    }
+    return require('./dubins.js')(options)
+}
+
+module.exports = loadDubins
+module.exports.supportsSimd = supportsSimd
+module.exports.supportsThreads = supportsThreads
+module.exports.solveBatch = (starts, ends, rho, options) =>
+    require('./dubins_async.js').solveBatch(starts, ends, rho, options)
+module.exports.createPool = (options) => require('./dubins_async.js').createPool(options)
@@ -0,0 +1,423 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "dubins_internal.h"
+#include "dubins_lut.h"
+
+#define LUT_MAGIC   "DUBINLUT"
+#define LUT_VERSION (1)
+#define LUT_ALIGN   (64)
+
+/* sub-samples per axis used to bound the error of each cell */
+#define LUT_VERIFY_SAMPLES (3)
+
+/* factor applied to the largest sampled error of a cell */
+#define LUT_ERROR_MARGIN (4.0)
+
+/*
+ * On-disk (and in-memory) layout: this header, then the residual, cell
+ * error and type arrays, each starting on a LUT_ALIGN boundary.  All
+ * offsets are in bytes from the start of the header.
+ */
+typedef struct
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t n_alpha;
+    uint32_t n_beta;
+    uint32_t n_d;
+    uint32_t reserved;
+    double   d_max;
+    double   max_error;
+    uint64_t residual_offset;
+    uint64_t cell_error_offset;
+    uint64_t type_offset;
+    uint64_t file_size;
+} LutHeader;
+
+static size_t align_up(size_t x)
+{
+    return (x + LUT_ALIGN - 1) / LUT_ALIGN * LUT_ALIGN;
+}
+
+static size_t vertex_count(const LutHeader* h)
+{
+    return (size_t)h->n_alpha * h->n_beta * h->n_d;
+}
+
+static size_t cell_count(const LutHeader* h)
+{
+    return (size_t)h->n_alpha * h->n_beta * (h->n_d - 1);
+}
+
+/*
+ * Whether the arrays of a table with these dimensions fit in size bytes.
+ * There are fewer cells than vertices, so the whole table then needs less
+ * than twice size plus the header and padding.
+ */
+static int fits(size_t n_alpha, size_t n_beta, size_t n_d, size_t size)
+{
+    size_t per_vertex = sizeof(float) + 1;
+    if(n_alpha > size / n_beta) {
+        return 0;
+    }
+    return n_d <= size / per_vertex / (n_alpha * n_beta);
+}
+
+static void layout(LutHeader* h)
+{
+    h->residual_offset   = align_up(sizeof(LutHeader));
+    h->cell_error_offset = align_up((size_t)h->residual_offset + vertex_count(h) * sizeof(float));
+    h->type_offset       = align_up((size_t)h->cell_error_offset + cell_count(h) * sizeof(float));
+    h->file_size         = align_up((size_t)h->type_offset + vertex_count(h));
+}
+
+static void attach(DubinsLut* lut, void* storage)
+{
+    const LutHeader* h = (const LutHeader*)storage;
+    const char* base = (const char*)storage;
+    lut->n_alpha    = h->n_alpha;
+    lut->n_beta     = h->n_beta;
+    lut->n_d        = h->n_d;
+    lut->d_max      = h->d_max;
+    lut->max_error  = h->max_error;
+    lut->residual   = (const float*)(base + h->residual_offset);
+    lut->cell_error = (const float*)(base + h->cell_error_offset);
+    lut->type       = (const unsigned char*)(base + h->type_offset);
+    lut->storage    = storage;
+}
+
+/* normalised alpha, beta and d, without the sines and cosines */
+static int normalise(double q0[3], double q1[3], double rho, double* alpha, double* beta, double* d)
+{
+    double dx, dy, theta = 0;
+    if( rho <= 0.0 ) {
+        return EDUBBADRHO;
+    }
+    dx = q1[0] - q0[0];
+    dy = q1[1] - q0[1];
+    *d = sqrt( dx * dx + dy * dy ) / rho;
+    if(*d > 0) {
+        theta = mod2pi(atan2( dy, dx ));
+    }
+    *alpha = mod2pi(q0[2] - theta);
+    *beta  = mod2pi(q1[2] - theta);
+    return EDUBOK;
+}
+
+/* exact normalised cost of the canonical problem (0, 0, alpha) -> (d, 0, beta) */
+static double exact_cost(double alpha, double beta, double d, DubinsPathType* type)
+{
+    double q0[3], q1[3];
+    DubinsPath path;
+    q0[0] = 0.0;
+    q0[1] = 0.0;
+    q0[2] = alpha;
+    q1[0] = d;
+    q1[1] = 0.0;
+    q1[2] = beta;
+    dubins_shortest_path(&path, q0, q1, 1.0);
+    if(type != NULL) {
+        *type = path.type;
+    }
+    return path.param[0] + path.param[1] + path.param[2];
+}
+
+/* locate the cell holding (alpha, beta, d) and the position inside it */
+static void locate(const DubinsLut* lut, double alpha, double beta, double d,
+                   size_t idx[3], double frac[3])
+{
+    double fa = alpha / (2 * M_PI) * lut->n_alpha;
+    double fb = beta / (2 * M_PI) * lut->n_beta;
+    double fd = d / lut->d_max * (lut->n_d - 1);
+    double ia = floor(fa);
+    double ib = floor(fb);
+    double id = floor(fd);
+    if(id > lut->n_d - 2) {
+        id = lut->n_d - 2;
+    }
+    frac[0] = fa - ia;
+    frac[1] = fb - ib;
+    frac[2] = fd - id;
+    idx[0] = (size_t)ia % lut->n_alpha;
+    idx[1] = (size_t)ib % lut->n_beta;
+    idx[2] = (size_t)id;
+}
+
+/* the word shared by the eight corners of a cell, zero if they differ */
+static int cell_word(const DubinsLut* lut, size_t ia, size_t ib, size_t id, DubinsPathType* word)
+{
+    size_t a[2], b[2], i, j, k;
+    unsigned char t;
+    a[0] = ia;
+    a[1] = (ia + 1) % lut->n_alpha;
+    b[0] = ib;
+    b[1] = (ib + 1) % lut->n_beta;
+    t = lut->type[(a[0] * lut->n_beta + b[0]) * lut->n_d + id];
+    for( i = 0; i < 2; i++ ) {
+        for( j = 0; j < 2; j++ ) {
+            for( k = 0; k < 2; k++ ) {
+                if(lut->type[(a[i] * lut->n_beta + b[j]) * lut->n_d + id + k] != t) {
+                    return 0;
+                }
+            }
+        }
+    }
+    *word = (DubinsPathType)t;
+    return 1;
+}
+
+static double interpolate(const DubinsLut* lut, const size_t idx[3], const double frac[3])
+{
+    size_t a0 = idx[0], a1 = (idx[0] + 1) % lut->n_alpha;
+    size_t b0 = idx[1], b1 = (idx[1] + 1) % lut->n_beta;
+    size_t nd = lut->n_d;
+    const float* r00 = lut->residual + (a0 * lut->n_beta + b0) * nd + idx[2];
+    const float* r01 = lut->residual + (a0 * lut->n_beta + b1) * nd + idx[2];
+    const float* r10 = lut->residual + (a1 * lut->n_beta + b0) * nd + idx[2];
+    const float* r11 = lut->residual + (a1 * lut->n_beta + b1) * nd + idx[2];
+    double td = frac[2];
+    double c00 = r00[0] + (r00[1] - r00[0]) * td;
+    double c01 = r01[0] + (r01[1] - r01[0]) * td;
+    double c10 = r10[0] + (r10[1] - r10[0]) * td;
+    double c11 = r11[0] + (r11[1] - r11[0]) * td;
+    double c0 = c00 + (c01 - c00) * frac[1];
+    double c1 = c10 + (c11 - c10) * frac[1];
+    return c0 + (c1 - c0) * frac[0];
+}
+
+int dubins_lut_build(DubinsLut* lut, unsigned n_alpha, unsigned n_beta, unsigned n_d, double d_max)
+{
+    LutHeader h;
+    char* storage;
+    float* residual;
+    float* cell_error;
+    unsigned char* type;
+    size_t ia, ib, id, i, j, k, idx[3];
+    double alpha, beta, d, frac[3], err, worst, max_error = 0.0;
+    double da, db, dd;
+    DubinsPathType word, sample_word;
+
+    if(n_alpha < 1 || n_beta < 1 || n_d < 2 || !(d_max > 0.0)) {
+        return EDUBPARAM;
+    }
+    if(!fits(n_alpha, n_beta, n_d, (size_t)-1 / 4)) {
+        return EDUBNOMEM;
+    }
+
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, LUT_MAGIC, sizeof(h.magic));
+    h.version = LUT_VERSION;
+    h.header_size = sizeof(LutHeader);
+    h.n_alpha = n_alpha;
+    h.n_beta = n_beta;
+    h.n_d = n_d;
+    h.d_max = d_max;
+    layout(&h);
+
+    storage = (char*)calloc(1, (size_t)h.file_size);
+    if(storage == NULL) {
+        return EDUBNOMEM;
+    }
+    residual   = (float*)(storage + h.residual_offset);
+    cell_error = (float*)(storage + h.cell_error_offset);
+    type       = (unsigned char*)(storage + h.type_offset);
+
+    da = 2 * M_PI / n_alpha;
+    db = 2 * M_PI / n_beta;
+    dd = d_max / (n_d - 1);
+    for( ia = 0; ia < n_alpha; ia++ ) {
+        for( ib = 0; ib < n_beta; ib++ ) {
+            for( id = 0; id < n_d; id++ ) {
+                i = (ia * n_beta + ib) * n_d + id;
+                d = id * dd;
+                residual[i] = (float)(exact_cost(ia * da, ib * db, d, &word) - d);
+                type[i] = (unsigned char)word;
+            }
+        }
+    }
+
+    memcpy(storage, &h, sizeof(h));
+    attach(lut, storage);
+    lut->storage_size = (size_t)h.file_size;
+    lut->storage_handle = NULL;
+    lut->mapped = 0;
+
+    /*
+     * Bound each cell by comparing against exact solutions inside it.  The
+     * cost jumps where the optimal word changes, so a cell whose corners and
+     * sub-samples do not all share one word gets an infinite error and is
+     * solved exactly by dubins_lut_estimate.
+     */
+    for( ia = 0; ia < n_alpha; ia++ ) {
+        for( ib = 0; ib < n_beta; ib++ ) {
+            for( id = 0; id + 1 < n_d; id++ ) {
+                worst = cell_word(lut, ia, ib, id, &word) ? 0.0 : INFINITY;
+                for( i = 0; i < LUT_VERIFY_SAMPLES && worst < INFINITY; i++ ) {
+                    for( j = 0; j < LUT_VERIFY_SAMPLES && worst < INFINITY; j++ ) {
+                        for( k = 0; k < LUT_VERIFY_SAMPLES && worst < INFINITY; k++ ) {
+                            alpha = (ia + (i + 1.0) / (LUT_VERIFY_SAMPLES + 1)) * da;
+                            beta  = (ib + (j + 1.0) / (LUT_VERIFY_SAMPLES + 1)) * db;
+                            d     = (id + (k + 1.0) / (LUT_VERIFY_SAMPLES + 1)) * dd;
+                            locate(lut, alpha, beta, d, idx, frac);
+                            err = fabs(interpolate(lut, idx, frac) + d - exact_cost(alpha, beta, d, &sample_word));
+                            if(sample_word != word) {
+                                worst = INFINITY;
+                            }
+                            else if(err > worst) {
+                                worst = err;
+                            }
+                        }
+                    }
+                }
+                if(worst < INFINITY) {
+                    /* the samples miss the peak of the error between them, so leave a margin */
+                    worst = worst * LUT_ERROR_MARGIN + 1e-6;
+                    if(worst > max_error) {
+                        max_error = worst;
+                    }
+                }
+                cell_error[(ia * n_beta + ib) * (n_d - 1) + id] = (float)worst;
+            }
+        }
+    }
+    ((LutHeader*)storage)->max_error = max_error;
+    lut->max_error = max_error;
+    return EDUBOK;
+}
+
+int dubins_lut_save(const DubinsLut* lut, const char* filename)
+{
+    FILE* fp;
+    size_t written;
+    if(!dubins_host_is_little_endian()) {
+        return EDUBFORMAT;
+    }
+    fp = fopen(filename, "wb");
+    if(fp == NULL) {
+        return EDUBIO;
+    }
+    written = fwrite(lut->storage, 1, lut->storage_size, fp);
+    if(fclose(fp) != 0 || written != lut->storage_size) {
+        return EDUBIO;
+    }
+    return EDUBOK;
+}
+
+int dubins_lut_map(DubinsLut* lut, const char* filename)
+{
+    DubinsMapping m;
+    LutHeader expected;
+    const LutHeader* h;
+    int errcode;
+
+    if(!dubins_host_is_little_endian()) {
+        return EDUBFORMAT;
+    }
+    errcode = dubins_map_file(&m, filename);
+    if(errcode != EDUBOK) {
+        return errcode;
+    }
+
+    h = (const LutHeader*)m.data;
+    if(m.size < sizeof(LutHeader) || memcmp(h->magic, LUT_MAGIC, sizeof(h->magic)) != 0
+       || h->version != LUT_VERSION || h->header_size != sizeof(LutHeader)
+       || h->n_alpha < 1 || h->n_beta < 1 || h->n_d < 2 || !(h->d_max > 0.0)
+       || !fits(h->n_alpha, h->n_beta, h->n_d, m.size)) {
+        dubins_unmap_file(&m);
+        return EDUBFORMAT;
+    }
+    expected = *h;
+    layout(&expected);
+    if(expected.residual_offset != h->residual_offset || expected.cell_error_offset != h->cell_error_offset
+       || expected.type_offset != h->type_offset || expected.file_size != h->file_size
+       || h->file_size > m.size) {
+        dubins_unmap_file(&m);
+        return EDUBFORMAT;
+    }
+
+    attach(lut, m.data);
+    lut->storage_size = m.size;
+    lut->storage_handle = m.handle;
+    lut->mapped = 1;
+    return EDUBOK;
+}
+
+void dubins_lut_free(DubinsLut* lut)
+{
+    DubinsMapping m;
+    if(lut->mapped) {
+        m.data = lut->storage;
+        m.size = lut->storage_size;
+        m.handle = lut->storage_handle;
+        dubins_unmap_file(&m);
+    }
+    else {
+        free(lut->storage);
+    }
+    memset(lut, 0, sizeof(*lut));
+}
+
+int dubins_lut_estimate(const DubinsLut* lut, double* length, double* error, DubinsPathType* type,
+                        double q0[3], double q1[3], double rho)
+{
+    double alpha, beta, d, frac[3], cell = 0.0;
+    size_t idx[3], a, b, k;
+    DubinsPath path;
+    int errcode = normalise(q0, q1, rho, &alpha, &beta, &d);
+    if(errcode != EDUBOK) {
+        return errcode;
+    }
+
+    if(d <= lut->d_max) {
+        locate(lut, alpha, beta, d, idx, frac);
+        cell = lut->cell_error[(idx[0] * lut->n_beta + idx[1]) * (lut->n_d - 1) + idx[2]];
+    }
+    if(d > lut->d_max || !(cell < INFINITY)) {
+        errcode = dubins_shortest_path(&path, q0, q1, rho);
+        if(errcode == EDUBOK) {
+            *length = dubins_path_length(&path);
+            if(error != NULL) {
+                *error = 0.0;
+            }
+            if(type != NULL) {
+                *type = path.type;
+            }
+        }
+        return errcode;
+    }
+
+    *length = (interpolate(lut, idx, frac) + d) * rho;
+    if(error != NULL) {
+        *error = cell * rho;
+    }
+    if(type != NULL) {
+        a = (idx[0] + (frac[0] >= 0.5)) % lut->n_alpha;
+        b = (idx[1] + (frac[1] >= 0.5)) % lut->n_beta;
+        k = idx[2] + (frac[2] >= 0.5);
+        *type = (DubinsPathType)lut->type[(a * lut->n_beta + b) * lut->n_d + k];
+    }
+    return EDUBOK;
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Read-only file mappings for the precomputed table formats.
+ *
+ * POSIX systems use mmap and Windows uses file mapping objects.  Elsewhere
+ * (including emscripten) the file is read into an allocated buffer, which
+ * costs a copy but keeps the same interface.
+ */
+#include "dubins_internal.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+
+#if defined(_WIN32)
+#define DUBINS_MAP_WIN32
+#include <windows.h>
+#elif (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+#define DUBINS_MAP_POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+int dubins_host_is_little_endian(void)
+{
+    unsigned int one = 1;
+    return *(unsigned char*)&one == 1;
+}
+
+#if defined(DUBINS_MAP_POSIX)
+
+int dubins_map_file(DubinsMapping* m, const char* filename)
+{
+    struct stat st;
+    void* data;
+    int fd = open(filename, O_RDONLY);
+    if(fd < 0) {
+        return EDUBIO;
+    }
+    if(fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return EDUBIO;
+    }
+    data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(data == MAP_FAILED) {
+        return EDUBIO;
+    }
+    m->data = data;
+    m->size = (size_t)st.st_size;
+    m->handle = NULL;
+    return EDUBOK;
+}
+
+void dubins_unmap_file(DubinsMapping* m)
+{
+    if(m->data != NULL) {
+        munmap(m->data, m->size);
+    }
+    m->data = NULL;
+    m->size = 0;
+}
+
+#elif defined(DUBINS_MAP_WIN32)
+
+int dubins_map_file(DubinsMapping* m, const char* filename)
+{
+    LARGE_INTEGER size;
+    HANDLE mapping;
+    void* data;
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(file == INVALID_HANDLE_VALUE) {
+        return EDUBIO;
+    }
+    if(!GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+        CloseHandle(file);
+        return EDUBIO;
+    }
+    mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if(mapping == NULL) {
+        return EDUBIO;
+    }
+    data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if(data == NULL) {
+        CloseHandle(mapping);
+        return EDUBIO;
+    }
+    m->data = data;
+    m->size = (size_t)size.QuadPart;
+    m->handle = mapping;
+    return EDUBOK;
+}
+
+void dubins_unmap_file(DubinsMapping* m)
+{
+    if(m->data != NULL) {
+        UnmapViewOfFile(m->data);
+        CloseHandle((HANDLE)m->handle);
+    }
+    m->data = NULL;
+    m->size = 0;
+    m->handle = NULL;
+}
+
+#else
+
+int dubins_map_file(DubinsMapping* m, const char* filename)
+{
+    long size;
+    void* data;
+    FILE* fp = fopen(filename, "rb");
+    if(fp == NULL) {
+        return EDUBIO;
+    }
+    if(fseek(fp, 0, SEEK_END) != 0 || (size = ftell(fp)) <= 0 || fseek(fp, 0, SEEK_SET) != 0) {
+        fclose(fp);
+        return EDUBIO;
+    }
+    data = malloc((size_t)size);
+    if(data == NULL || fread(data, 1, (size_t)size, fp) != (size_t)size) {
+        free(data);
+        fclose(fp);
+        return EDUBIO;
+    }
+    fclose(fp);
+    m->data = data;
+    m->size = (size_t)size;
+    m->handle = NULL;
+    return EDUBOK;
+}
+
+void dubins_unmap_file(DubinsMapping* m)
+{
+    free(m->data);
+    m->data = NULL;
+    m->size = 0;
+}
+
+#endif
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include "dubins_internal.h"
+
+/* rows solved against each column tile before moving to the next tile */
+#define MATRIX_ROW_TILE (16)
+
+static void headings(const double* th, size_t n, double* s, double* c)
+{
+    size_t i;
+    for( i = 0; i < n; i++ ) {
+        s[i] = sin(th[i]);
+        c[i] = cos(th[i]);
+    }
+}
+
+/*
+ * Intermediate results of one row against a tile of columns.  Instead of
+ * evaluating sin and cos of alpha = th0 - theta per pair, expand them with
+ * the cached heading terms and cos(theta) = dx / D, sin(theta) = dy / D.
+ */
+static void row_block(DubinsIntermediateBlock* blk, double x0, double y0, double th0,
+                      double s0, double c0, const DubinsConfigSet* to, size_t col,
+                      const double* s1, const double* c1, size_t n, double rho)
+{
+    size_t i;
+    double dx, dy, D, ct, st, theta;
+    int errcode = (rho <= 0.0) ? EDUBBADRHO : EDUBOK;
+
+    for( i = 0; i < n; i++ ) {
+        dx = to->x[col + i] - x0;
+        dy = to->y[col + i] - y0;
+        D = sqrt( dx * dx + dy * dy );
+        blk->d[i] = D / rho;
+        blk->d_sq[i] = blk->d[i] * blk->d[i];
+        blk->errcode[i] = errcode;
+
+        theta = 0;
+        ct = 1.0;
+        st = 0.0;
+        if(blk->d[i] > 0) {
+            theta = mod2pi(atan2( dy, dx ));
+            ct = dx / D;
+            st = dy / D;
+        }
+        blk->alpha[i] = mod2pi(th0 - theta);
+        blk->beta[i]  = mod2pi(to->th[col + i] - theta);
+        blk->sa[i]    = s0 * ct - c0 * st;
+        blk->ca[i]    = c0 * ct + s0 * st;
+        blk->sb[i]    = s1[i] * ct - c1[i] * st;
+        blk->cb[i]    = c1[i] * ct + s1[i] * st;
+        blk->c_ab[i]  = c0 * c1[i] + s0 * s1[i];
+    }
+    dubins_intermediate_block_pad(blk, n);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_distance_matrix(const DubinsConfigSet* from, size_t n_from,
+                           const DubinsConfigSet* to, size_t n_to,
+                           double rho, DubinsBatchOutput* out)
+{
+    return dubins_distance_matrix_rows(from, to, n_to, rho, out, 0, n_from);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_distance_matrix_rows(const DubinsConfigSet* from, const DubinsConfigSet* to, size_t n_to,
+                                double rho, DubinsBatchOutput* out, size_t row_begin, size_t row_end)
+{
+    DubinsIntermediateBlock blk;
+    DubinsBlockResult res;
+    double s0[MATRIX_ROW_TILE], c0[MATRIX_ROW_TILE];
+    double s1[DUBINS_BLOCK_SIZE], c1[DUBINS_BLOCK_SIZE];
+    size_t row, rows, col, count, r;
+    int errcode, first_error = EDUBOK;
+
+    for( row = row_begin; row < row_end; row += rows ) {
+        rows = row_end - row;
+        if(rows > MATRIX_ROW_TILE) {
+            rows = MATRIX_ROW_TILE;
+        }
+        headings(from->th + row, rows, s0, c0);
+
+        for( col = 0; col < n_to; col += count ) {
+            count = n_to - col;
+            if(count > DUBINS_BLOCK_SIZE) {
+                count = DUBINS_BLOCK_SIZE;
+            }
+            headings(to->th + col, count, s1, c1);
+
+            for( r = 0; r < rows; r++ ) {
+                row_block(&blk, from->x[row + r], from->y[row + r], from->th[row + r], s0[r], c0[r],
+                          to, col, s1, c1, count, rho);
+                dubins_words_block(&blk, count, DUBINS_ALL_WORDS, &res);
+                errcode = dubins_block_store(&blk, &res, count, NULL, rho, out, (row + r) * n_to + col);
+                if(first_error == EDUBOK) {
+                    first_error = errcode;
+                }
+            }
+        }
+    }
+    return first_error;
+}
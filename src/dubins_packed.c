@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Compact storage for large numbers of precomputed paths.
+ */
+#include "dubins_internal.h"
+
+#define PACKED_TYPE_BITS (3)
+#define PACKED_TYPE_MASK (0x7u)
+#define PACKED_MAX_NODE  (0xffffffffu >> PACKED_TYPE_BITS)
+
+int dubins_path_pack(const DubinsPath* path, uint32_t node, DubinsPackedPath* packed)
+{
+    if(node > PACKED_MAX_NODE || (unsigned)path->type > LRL) {
+        return EDUBPARAM;
+    }
+    packed->param[0] = (float)path->param[0];
+    packed->param[1] = (float)path->param[1];
+    packed->param[2] = (float)path->param[2];
+    packed->word_node = (node << PACKED_TYPE_BITS) | (uint32_t)path->type;
+    return EDUBOK;
+}
+
+uint32_t dubins_packed_path_node(const DubinsPackedPath* packed)
+{
+    return packed->word_node >> PACKED_TYPE_BITS;
+}
+
+DubinsPathType dubins_packed_path_type(const DubinsPackedPath* packed)
+{
+    return (DubinsPathType)(packed->word_node & PACKED_TYPE_MASK);
+}
+
+int dubins_path_unpack(const DubinsPackedPath* packed, const DubinsNodeTable* nodes, DubinsPath* path)
+{
+    uint32_t node = dubins_packed_path_node(packed);
+    DubinsPathType type = dubins_packed_path_type(packed);
+    if(node >= nodes->n || (unsigned)type > LRL) {
+        return EDUBPARAM;
+    }
+    path->qi[0] = nodes->q[3 * node + 0];
+    path->qi[1] = nodes->q[3 * node + 1];
+    path->qi[2] = nodes->q[3 * node + 2];
+    path->param[0] = packed->param[0];
+    path->param[1] = packed->param[1];
+    path->param[2] = packed->param[2];
+    path->rho = nodes->rho;
+    path->type = type;
+    return EDUBOK;
+}
+
+double dubins_packed_path_length(const DubinsPackedPath* packed, double rho)
+{
+    double length = 0.;
+    length += packed->param[0];
+    length += packed->param[1];
+    length += packed->param[2];
+    return length * rho;
+}
+
+int dubins_packed_path_sample(const DubinsPackedPath* packed, const DubinsNodeTable* nodes,
+                              double t, double q[3])
+{
+    DubinsPath path;
+    int errcode = dubins_path_unpack(packed, nodes, &path);
+    if(errcode != EDUBOK) {
+        return errcode;
+    }
+    return dubins_path_sample(&path, t, q);
+}
@@ -0,0 +1,565 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Thread pool and work-stealing scheduler for the batch solvers.
+ *
+ * A job is split into fixed chunks numbered 0..n-1.  Each worker starts with
+ * a contiguous range of chunks, takes chunks from the front of its own range
+ * and, once that is empty, steals the back half of another worker's range.
+ * Chunks write disjoint parts of the caller's output, so results do not
+ * depend on which thread ran which chunk, and the reported error is the one
+ * of the lowest failing chunk, as a sequential solve would report.
+ */
+#include "dubins_internal.h"
+
+#include <stdlib.h>
+
+#if defined(DUBINS_NO_THREADS)
+#elif defined(_WIN32)
+#define DUBINS_THREADS_WIN32
+#include <windows.h>
+#elif !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+#define DUBINS_THREADS_POSIX
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+#if defined(DUBINS_THREADS_WIN32)
+typedef SRWLOCK DubinsMutex;
+typedef CONDITION_VARIABLE DubinsCond;
+typedef HANDLE DubinsThread;
+#define mutex_init(m)      InitializeSRWLock(m)
+#define mutex_destroy(m)   ((void)(m))
+#define mutex_lock(m)      AcquireSRWLockExclusive(m)
+#define mutex_unlock(m)    ReleaseSRWLockExclusive(m)
+#define cond_init(c)       InitializeConditionVariable(c)
+#define cond_destroy(c)    ((void)(c))
+#define cond_wait(c, m)    SleepConditionVariableSRW(c, m, INFINITE, 0)
+#define cond_signal(c)     WakeConditionVariable(c)
+#define cond_broadcast(c)  WakeAllConditionVariable(c)
+#elif defined(DUBINS_THREADS_POSIX)
+typedef pthread_mutex_t DubinsMutex;
+typedef pthread_cond_t DubinsCond;
+typedef pthread_t DubinsThread;
+#define mutex_init(m)      pthread_mutex_init(m, NULL)
+#define mutex_destroy(m)   pthread_mutex_destroy(m)
+#define mutex_lock(m)      pthread_mutex_lock(m)
+#define mutex_unlock(m)    pthread_mutex_unlock(m)
+#define cond_init(c)       pthread_cond_init(c, NULL)
+#define cond_destroy(c)    pthread_cond_destroy(c)
+#define cond_wait(c, m)    pthread_cond_wait(c, m)
+#define cond_signal(c)     pthread_cond_signal(c)
+#define cond_broadcast(c)  pthread_cond_broadcast(c)
+#endif
+
+/* pairs per chunk of a batch, a few blocks so scheduling costs stay negligible */
+#define BATCH_CHUNK (16 * DUBINS_BLOCK_SIZE)
+
+/* rows per chunk of a distance matrix */
+#define MATRIX_CHUNK (16)
+
+/**
+ * Solve one chunk of a job
+ *
+ * @return - EDUBOK, or the error code of the first failing problem of the chunk
+ */
+typedef int (*DubinsChunkFn)(void* ctx, size_t chunk);
+
+/* every chunk in order on the calling thread, keeping the first error */
+static int run_sequential(size_t n_chunks, DubinsChunkFn fn, void* ctx)
+{
+    size_t chunk;
+    int errcode, first_error = EDUBOK;
+    for( chunk = 0; chunk < n_chunks; chunk++ ) {
+        errcode = fn(ctx, chunk);
+        if(first_error == EDUBOK) {
+            first_error = errcode;
+        }
+    }
+    return first_error;
+}
+
+#if defined(DUBINS_THREADS_WIN32) || defined(DUBINS_THREADS_POSIX)
+
+typedef struct
+{
+    DubinsMutex lock;
+    /* the chunks [next, end) not yet taken */
+    size_t next;
+    size_t end;
+} DubinsWorker;
+
+typedef struct
+{
+    DubinsChunkFn fn;
+    void* ctx;
+    DubinsMutex lock;
+    /* the lowest failing chunk so far, and its error */
+    size_t error_chunk;
+    int errcode;
+} DubinsJob;
+
+struct DubinsThreadPool
+{
+    unsigned n_threads;
+    /* n_threads - 1 background threads, the caller acts as worker 0 */
+    DubinsThread* threads;
+    DubinsWorker* workers;
+
+    /* serialises concurrent jobs on the same pool */
+    DubinsMutex run_lock;
+
+    DubinsMutex lock;
+    DubinsCond wake;
+    DubinsCond done;
+    DubinsJob* job;
+    unsigned generation;
+    unsigned busy;
+    int shutdown;
+};
+
+typedef struct
+{
+    DubinsThreadPool* pool;
+    unsigned id;
+} DubinsWorkerArg;
+
+static int take_chunk(DubinsWorker* w, size_t* chunk)
+{
+    int found = 0;
+    mutex_lock(&w->lock);
+    if(w->next < w->end) {
+        *chunk = w->next++;
+        found = 1;
+    }
+    mutex_unlock(&w->lock);
+    return found;
+}
+
+static int steal_chunks(DubinsThreadPool* pool, unsigned id)
+{
+    unsigned i;
+    size_t begin = 0, end = 0;
+    DubinsWorker* victim;
+
+    for( i = 1; i < pool->n_threads && begin == end; i++ ) {
+        victim = &pool->workers[(id + i) % pool->n_threads];
+        mutex_lock(&victim->lock);
+        if(victim->next < victim->end) {
+            end = victim->end;
+            begin = end - (end - victim->next + 1) / 2;
+            victim->end = begin;
+        }
+        mutex_unlock(&victim->lock);
+    }
+    if(begin == end) {
+        return 0;
+    }
+    mutex_lock(&pool->workers[id].lock);
+    pool->workers[id].next = begin;
+    pool->workers[id].end = end;
+    mutex_unlock(&pool->workers[id].lock);
+    return 1;
+}
+
+static void work(DubinsThreadPool* pool, unsigned id)
+{
+    DubinsJob* job = pool->job;
+    size_t chunk;
+    int errcode;
+
+    do {
+        while(take_chunk(&pool->workers[id], &chunk)) {
+            errcode = job->fn(job->ctx, chunk);
+            if(errcode != EDUBOK) {
+                mutex_lock(&job->lock);
+                if(chunk < job->error_chunk) {
+                    job->error_chunk = chunk;
+                    job->errcode = errcode;
+                }
+                mutex_unlock(&job->lock);
+            }
+        }
+    } while(steal_chunks(pool, id));
+}
+
+#if defined(DUBINS_THREADS_WIN32)
+static DWORD WINAPI worker_main(LPVOID data)
+#else
+static void* worker_main(void* data)
+#endif
+{
+    DubinsWorkerArg* arg = (DubinsWorkerArg*)data;
+    DubinsThreadPool* pool = arg->pool;
+    unsigned id = arg->id;
+    unsigned seen = 0;
+    free(arg);
+
+    mutex_lock(&pool->lock);
+    for(;;) {
+        while(pool->generation == seen && !pool->shutdown) {
+            cond_wait(&pool->wake, &pool->lock);
+        }
+        if(pool->shutdown) {
+            break;
+        }
+        seen = pool->generation;
+        mutex_unlock(&pool->lock);
+        work(pool, id);
+        mutex_lock(&pool->lock);
+        if(--pool->busy == 0) {
+            cond_signal(&pool->done);
+        }
+    }
+    mutex_unlock(&pool->lock);
+    return 0;
+}
+
+static int start_thread(DubinsThreadPool* pool, unsigned id)
+{
+    DubinsWorkerArg* arg = (DubinsWorkerArg*)malloc(sizeof(DubinsWorkerArg));
+    if(arg == NULL) {
+        return 0;
+    }
+    arg->pool = pool;
+    arg->id = id;
+#if defined(DUBINS_THREADS_WIN32)
+    pool->threads[id - 1] = CreateThread(NULL, 0, worker_main, arg, 0, NULL);
+    if(pool->threads[id - 1] == NULL) {
+        free(arg);
+        return 0;
+    }
+#else
+    if(pthread_create(&pool->threads[id - 1], NULL, worker_main, arg) != 0) {
+        free(arg);
+        return 0;
+    }
+#endif
+    return 1;
+}
+
+static void join_thread(DubinsThread thread)
+{
+#if defined(DUBINS_THREADS_WIN32)
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+#else
+    pthread_join(thread, NULL);
+#endif
+}
+
+static unsigned hardware_threads(void)
+{
+#if defined(DUBINS_THREADS_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (unsigned)n : 1;
+#else
+    return 1;
+#endif
+}
+
+static void stop_threads(DubinsThreadPool* pool, unsigned started)
+{
+    unsigned i;
+    mutex_lock(&pool->lock);
+    pool->shutdown = 1;
+    cond_broadcast(&pool->wake);
+    mutex_unlock(&pool->lock);
+    for( i = 0; i < started; i++ ) {
+        join_thread(pool->threads[i]);
+    }
+}
+
+static void release(DubinsThreadPool* pool)
+{
+    unsigned i;
+    for( i = 0; i < pool->n_threads; i++ ) {
+        mutex_destroy(&pool->workers[i].lock);
+    }
+    mutex_destroy(&pool->run_lock);
+    mutex_destroy(&pool->lock);
+    cond_destroy(&pool->wake);
+    cond_destroy(&pool->done);
+    free(pool->threads);
+    free(pool->workers);
+    free(pool);
+}
+
+EMSCRIPTEN_KEEPALIVE
+DubinsThreadPool* dubins_thread_pool_create(unsigned n_threads)
+{
+    unsigned i;
+    DubinsThreadPool* pool = (DubinsThreadPool*)calloc(1, sizeof(DubinsThreadPool));
+    if(pool == NULL) {
+        return NULL;
+    }
+    if(n_threads == 0) {
+        n_threads = hardware_threads();
+    }
+#if defined(__EMSCRIPTEN_PTHREADS__) && defined(DUBINS_WASM_POOL_SIZE)
+    /* workers beyond the preloaded ones would start asynchronously and deadlock a blocking solve */
+    if(n_threads > DUBINS_WASM_POOL_SIZE + 1) {
+        n_threads = DUBINS_WASM_POOL_SIZE + 1;
+    }
+#endif
+    pool->n_threads = n_threads;
+    pool->threads = (DubinsThread*)calloc(n_threads, sizeof(DubinsThread));
+    pool->workers = (DubinsWorker*)calloc(n_threads, sizeof(DubinsWorker));
+    if(pool->threads == NULL || pool->workers == NULL) {
+        free(pool->threads);
+        free(pool->workers);
+        free(pool);
+        return NULL;
+    }
+    for( i = 0; i < n_threads; i++ ) {
+        mutex_init(&pool->workers[i].lock);
+    }
+    mutex_init(&pool->run_lock);
+    mutex_init(&pool->lock);
+    cond_init(&pool->wake);
+    cond_init(&pool->done);
+
+    /* detect the vector level before any worker can race to do it */
+    dubins_simd_level();
+
+    for( i = 1; i < n_threads; i++ ) {
+        if(!start_thread(pool, i)) {
+            stop_threads(pool, i - 1);
+            release(pool);
+            return NULL;
+        }
+    }
+    return pool;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void dubins_thread_pool_destroy(DubinsThreadPool* pool)
+{
+    if(pool == NULL) {
+        return;
+    }
+    stop_threads(pool, pool->n_threads - 1);
+    release(pool);
+}
+
+static int run_chunks(DubinsThreadPool* pool, size_t n_chunks, DubinsChunkFn fn, void* ctx)
+{
+    DubinsJob job;
+    unsigned i;
+
+    if(pool == NULL || pool->n_threads == 1 || n_chunks <= 1) {
+        return run_sequential(n_chunks, fn, ctx);
+    }
+
+    job.fn = fn;
+    job.ctx = ctx;
+    job.error_chunk = n_chunks;
+    job.errcode = EDUBOK;
+    mutex_init(&job.lock);
+
+    mutex_lock(&pool->run_lock);
+    for( i = 0; i < pool->n_threads; i++ ) {
+        pool->workers[i].next = n_chunks * i / pool->n_threads;
+        pool->workers[i].end = n_chunks * (i + 1) / pool->n_threads;
+    }
+    mutex_lock(&pool->lock);
+    pool->job = &job;
+    pool->busy = pool->n_threads - 1;
+    pool->generation++;
+    cond_broadcast(&pool->wake);
+    mutex_unlock(&pool->lock);
+
+    work(pool, 0);
+
+    mutex_lock(&pool->lock);
+    while(pool->busy > 0) {
+        cond_wait(&pool->done, &pool->lock);
+    }
+    pool->job = NULL;
+    mutex_unlock(&pool->lock);
+    mutex_unlock(&pool->run_lock);
+
+    mutex_destroy(&job.lock);
+    return job.errcode;
+}
+
+#else
+
+/* without a thread backend every pool runs jobs on the calling thread */
+struct DubinsThreadPool
+{
+    unsigned n_threads;
+};
+
+EMSCRIPTEN_KEEPALIVE
+DubinsThreadPool* dubins_thread_pool_create(unsigned n_threads)
+{
+    DubinsThreadPool* pool = (DubinsThreadPool*)malloc(sizeof(DubinsThreadPool));
+    (void)n_threads;
+    if(pool != NULL) {
+        pool->n_threads = 1;
+    }
+    return pool;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void dubins_thread_pool_destroy(DubinsThreadPool* pool)
+{
+    free(pool);
+}
+
+static int run_chunks(DubinsThreadPool* pool, size_t n_chunks, DubinsChunkFn fn, void* ctx)
+{
+    (void)pool;
+    return run_sequential(n_chunks, fn, ctx);
+}
+
+#endif
+
+EMSCRIPTEN_KEEPALIVE
+unsigned dubins_thread_pool_size(const DubinsThreadPool* pool)
+{
+    return (pool != NULL) ? pool->n_threads : 1;
+}
+
+typedef struct
+{
+    const DubinsBatchInput* in;
+    DubinsBatchOutput* out;
+    size_t n;
+    int all_words;
+    DubinsPathType pathType;
+} BatchJob;
+
+static const double* shift_in(const double* p, size_t offset)
+{
+    return (p != NULL) ? p + offset : NULL;
+}
+
+static double* shift_out(double* p, size_t offset)
+{
+    return (p != NULL) ? p + offset : NULL;
+}
+
+static int batch_chunk(void* ctx, size_t chunk)
+{
+    BatchJob* job = (BatchJob*)ctx;
+    DubinsBatchInput in;
+    DubinsBatchOutput out;
+    size_t offset = chunk * BATCH_CHUNK;
+    size_t count = job->n - offset;
+    int i;
+    if(count > BATCH_CHUNK) {
+        count = BATCH_CHUNK;
+    }
+
+    in.x0  = job->in->x0 + offset;
+    in.y0  = job->in->y0 + offset;
+    in.th0 = job->in->th0 + offset;
+    in.x1  = job->in->x1 + offset;
+    in.y1  = job->in->y1 + offset;
+    in.th1 = job->in->th1 + offset;
+    in.rho = shift_in(job->in->rho, offset);
+    in.rho_shared = job->in->rho_shared;
+
+    out.length = shift_out(job->out->length, offset);
+    out.type = (job->out->type != NULL) ? job->out->type + offset : NULL;
+    for( i = 0; i < 3; i++ ) {
+        out.param[i] = shift_out(job->out->param[i], offset);
+    }
+    out.errcode = (job->out->errcode != NULL) ? job->out->errcode + offset : NULL;
+
+    if(job->all_words) {
+        return dubins_shortest_path_batch(&in, &out, count);
+    }
+    return dubins_path_batch(&in, &out, count, job->pathType);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_shortest_path_batch_parallel(const DubinsBatchInput* in, DubinsBatchOutput* out, size_t n,
+                                        DubinsThreadPool* pool)
+{
+    BatchJob job;
+    job.in = in;
+    job.out = out;
+    job.n = n;
+    job.all_words = 1;
+    job.pathType = LSL;
+    return run_chunks(pool, (n + BATCH_CHUNK - 1) / BATCH_CHUNK, batch_chunk, &job);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_path_batch_parallel(const DubinsBatchInput* in, DubinsBatchOutput* out, size_t n,
+                               DubinsPathType pathType, DubinsThreadPool* pool)
+{
+    BatchJob job;
+    if((int)pathType < 0 || (int)pathType > LRL) {
+        return EDUBPARAM;
+    }
+    job.in = in;
+    job.out = out;
+    job.n = n;
+    job.all_words = 0;
+    job.pathType = pathType;
+    return run_chunks(pool, (n + BATCH_CHUNK - 1) / BATCH_CHUNK, batch_chunk, &job);
+}
+
+typedef struct
+{
+    const DubinsConfigSet* from;
+    size_t n_from;
+    const DubinsConfigSet* to;
+    size_t n_to;
+    double rho;
+    DubinsBatchOutput* out;
+} MatrixJob;
+
+static int matrix_chunk(void* ctx, size_t chunk)
+{
+    MatrixJob* job = (MatrixJob*)ctx;
+    size_t begin = chunk * MATRIX_CHUNK;
+    size_t end = begin + MATRIX_CHUNK;
+    if(end > job->n_from) {
+        end = job->n_from;
+    }
+    return dubins_distance_matrix_rows(job->from, job->to, job->n_to, job->rho, job->out, begin, end);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_distance_matrix_parallel(const DubinsConfigSet* from, size_t n_from,
+                                    const DubinsConfigSet* to, size_t n_to,
+                                    double rho, DubinsBatchOutput* out, DubinsThreadPool* pool)
+{
+    MatrixJob job;
+    job.from = from;
+    job.n_from = n_from;
+    job.to = to;
+    job.n_to = n_to;
+    job.rho = rho;
+    job.out = out;
+    return run_chunks(pool, (n_from + MATRIX_CHUNK - 1) / MATRIX_CHUNK, matrix_chunk, &job);
+}
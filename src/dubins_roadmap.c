@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+#include <stdio.h>
+#include <string.h>
+#include "dubins_internal.h"
+#include "dubins_roadmap.h"
+
+#define ROADMAP_MAGIC   "DUBINRMP"
+#define ROADMAP_VERSION (1)
+#define ROADMAP_ALIGN   (64)
+
+/* records converted at a time while writing */
+#define ROADMAP_CHUNK (256)
+
+/*
+ * On-disk (and in-memory) layout: this header, then the node, edge index,
+ * edge target and edge arrays, each starting on a ROADMAP_ALIGN boundary.
+ * All offsets are in bytes from the start of the header.  record_size is the
+ * size of one edge record, which ties DUBINS_ROADMAP_PATHS files to the
+ * DubinsPath layout of the writer.
+ */
+typedef struct
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint32_t format;
+    uint32_t record_size;
+    uint64_t n_nodes;
+    uint64_t n_edges;
+    double   rho;
+    uint64_t node_offset;
+    uint64_t index_offset;
+    uint64_t target_offset;
+    uint64_t edge_offset;
+    uint64_t file_size;
+} RoadmapHeader;
+
+static uint64_t align_up(uint64_t x)
+{
+    return (x + ROADMAP_ALIGN - 1) / ROADMAP_ALIGN * ROADMAP_ALIGN;
+}
+
+static size_t record_size(uint32_t format)
+{
+    return format == DUBINS_ROADMAP_PACKED ? sizeof(DubinsPackedPath) : sizeof(DubinsPath);
+}
+
+static void layout(RoadmapHeader* h)
+{
+    h->record_size   = (uint32_t)record_size(h->format);
+    h->node_offset   = align_up(sizeof(RoadmapHeader));
+    h->index_offset  = align_up(h->node_offset + h->n_nodes * 3 * sizeof(double));
+    h->target_offset = align_up(h->index_offset + (h->n_nodes + 1) * sizeof(uint64_t));
+    h->edge_offset   = align_up(h->target_offset + h->n_edges * sizeof(uint32_t));
+    h->file_size     = align_up(h->edge_offset + h->n_edges * h->record_size);
+}
+
+/* write data, then zeros up to the byte offset `end` of the file */
+static int write_padded(FILE* fp, const void* data, size_t size, uint64_t* pos, uint64_t end)
+{
+    static const char zeros[ROADMAP_ALIGN] = { 0 };
+    if(size > 0 && fwrite(data, 1, size, fp) != size) {
+        return EDUBIO;
+    }
+    *pos += size;
+    while(*pos < end) {
+        size_t n = (size_t)(end - *pos);
+        if(n > sizeof(zeros)) {
+            n = sizeof(zeros);
+        }
+        if(fwrite(zeros, 1, n, fp) != n) {
+            return EDUBIO;
+        }
+        *pos += n;
+    }
+    return EDUBOK;
+}
+
+static int write_index(FILE* fp, const uint32_t* sources, size_t n_nodes, size_t n_edges, uint64_t* pos)
+{
+    uint64_t index[ROADMAP_CHUNK];
+    size_t node, count = 0, edge = 0;
+    for( node = 0; node <= n_nodes; node++ ) {
+        while(edge < n_edges && sources[edge] < node) {
+            edge++;
+        }
+        index[count++] = edge;
+        if(count == ROADMAP_CHUNK || node == n_nodes) {
+            if(fwrite(index, sizeof(uint64_t), count, fp) != count) {
+                return EDUBIO;
+            }
+            *pos += count * sizeof(uint64_t);
+            count = 0;
+        }
+    }
+    return EDUBOK;
+}
+
+static int write_packed(FILE* fp, const uint32_t* sources, const DubinsPath* paths, size_t n_edges,
+                        uint64_t* pos)
+{
+    DubinsPackedPath packed[ROADMAP_CHUNK];
+    size_t offset, count, i;
+    int errcode;
+    for( offset = 0; offset < n_edges; offset += count ) {
+        count = n_edges - offset;
+        if(count > ROADMAP_CHUNK) {
+            count = ROADMAP_CHUNK;
+        }
+        for( i = 0; i < count; i++ ) {
+            errcode = dubins_path_pack(&paths[offset + i], sources[offset + i], &packed[i]);
+            if(errcode != EDUBOK) {
+                return errcode;
+            }
+        }
+        if(fwrite(packed, sizeof(DubinsPackedPath), count, fp) != count) {
+            return EDUBIO;
+        }
+        *pos += count * sizeof(DubinsPackedPath);
+    }
+    return EDUBOK;
+}
+
+static int check_edges(size_t n_nodes, const uint32_t* sources, const uint32_t* targets, size_t n_edges)
+{
+    size_t e;
+    for( e = 0; e < n_edges; e++ ) {
+        if(sources[e] >= n_nodes || targets[e] >= n_nodes || (e > 0 && sources[e] < sources[e - 1])) {
+            return EDUBPARAM;
+        }
+    }
+    return EDUBOK;
+}
+
+int dubins_roadmap_save(const char* filename, DubinsRoadmapFormat format,
+                        const double* nodes, size_t n_nodes, double rho,
+                        const uint32_t* sources, const uint32_t* targets,
+                        const DubinsPath* paths, size_t n_edges)
+{
+    RoadmapHeader h;
+    FILE* fp;
+    uint64_t pos = 0;
+    int errcode;
+
+    if(!dubins_host_is_little_endian()) {
+        return EDUBFORMAT;
+    }
+    if(!(rho > 0.0)) {
+        return EDUBBADRHO;
+    }
+    if((format != DUBINS_ROADMAP_PATHS && format != DUBINS_ROADMAP_PACKED)
+       || (uint64_t)n_nodes > UINT32_MAX) {
+        return EDUBPARAM;
+    }
+    errcode = check_edges(n_nodes, sources, targets, n_edges);
+    if(errcode != EDUBOK) {
+        return errcode;
+    }
+
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, ROADMAP_MAGIC, sizeof(h.magic));
+    h.version = ROADMAP_VERSION;
+    h.header_size = sizeof(RoadmapHeader);
+    h.format = (uint32_t)format;
+    h.n_nodes = n_nodes;
+    h.n_edges = n_edges;
+    h.rho = rho;
+    layout(&h);
+
+    fp = fopen(filename, "wb");
+    if(fp == NULL) {
+        return EDUBIO;
+    }
+    errcode = write_padded(fp, &h, sizeof(h), &pos, h.node_offset);
+    if(errcode == EDUBOK) {
+        errcode = write_padded(fp, nodes, n_nodes * 3 * sizeof(double), &pos, h.index_offset);
+    }
+    if(errcode == EDUBOK) {
+        errcode = write_index(fp, sources, n_nodes, n_edges, &pos);
+    }
+    if(errcode == EDUBOK) {
+        errcode = write_padded(fp, NULL, 0, &pos, h.target_offset);
+    }
+    if(errcode == EDUBOK) {
+        errcode = write_padded(fp, targets, n_edges * sizeof(uint32_t), &pos, h.edge_offset);
+    }
+    if(errcode == EDUBOK) {
+        if(format == DUBINS_ROADMAP_PACKED) {
+            errcode = write_packed(fp, sources, paths, n_edges, &pos);
+        }
+        else {
+            errcode = write_padded(fp, paths, n_edges * sizeof(DubinsPath), &pos, h.file_size);
+        }
+    }
+    if(errcode == EDUBOK) {
+        errcode = write_padded(fp, NULL, 0, &pos, h.file_size);
+    }
+    if(fclose(fp) != 0 && errcode == EDUBOK) {
+        errcode = EDUBIO;
+    }
+    return errcode;
+}
+
+int dubins_roadmap_map(DubinsRoadmap* roadmap, const char* filename)
+{
+    DubinsMapping m;
+    RoadmapHeader expected;
+    const RoadmapHeader* h;
+    const char* base;
+    int errcode;
+
+    if(!dubins_host_is_little_endian()) {
+        return EDUBFORMAT;
+    }
+    errcode = dubins_map_file(&m, filename);
+    if(errcode != EDUBOK) {
+        return errcode;
+    }
+
+    h = (const RoadmapHeader*)m.data;
+    base = (const char*)m.data;
+    if(m.size < sizeof(RoadmapHeader) || memcmp(h->magic, ROADMAP_MAGIC, sizeof(h->magic)) != 0
+       || h->version != ROADMAP_VERSION || h->header_size != sizeof(RoadmapHeader)
+       || (h->format != DUBINS_ROADMAP_PATHS && h->format != DUBINS_ROADMAP_PACKED)
+       || h->n_nodes > UINT32_MAX || !(h->rho > 0.0)) {
+        dubins_unmap_file(&m);
+        return EDUBFORMAT;
+    }
+    /* every array must fit in the file, which also keeps layout from overflowing */
+    if(h->n_nodes > m.size / (3 * sizeof(double)) || h->n_edges > m.size / record_size(h->format)) {
+        dubins_unmap_file(&m);
+        return EDUBFORMAT;
+    }
+    expected = *h;
+    layout(&expected);
+    if(expected.record_size != h->record_size || expected.node_offset != h->node_offset
+       || expected.index_offset != h->index_offset || expected.target_offset != h->target_offset
+       || expected.edge_offset != h->edge_offset || expected.file_size != h->file_size
+       || h->file_size > m.size) {
+        dubins_unmap_file(&m);
+        return EDUBFORMAT;
+    }
+
+    roadmap->format      = (DubinsRoadmapFormat)h->format;
+    roadmap->n_nodes     = (size_t)h->n_nodes;
+    roadmap->n_edges     = (size_t)h->n_edges;
+    roadmap->rho         = h->rho;
+    roadmap->nodes       = (const double*)(base + h->node_offset);
+    roadmap->edge_index  = (const uint64_t*)(base + h->index_offset);
+    roadmap->edge_target = (const uint32_t*)(base + h->target_offset);
+    roadmap->paths       = NULL;
+    roadmap->packed      = NULL;
+    if(h->format == DUBINS_ROADMAP_PACKED) {
+        roadmap->packed = (const DubinsPackedPath*)(base + h->edge_offset);
+    }
+    else {
+        roadmap->paths = (const DubinsPath*)(base + h->edge_offset);
+    }
+    roadmap->node_table.q   = roadmap->nodes;
+    roadmap->node_table.n   = roadmap->n_nodes;
+    roadmap->node_table.rho = roadmap->rho;
+    roadmap->storage        = m.data;
+    roadmap->storage_size   = m.size;
+    roadmap->storage_handle = m.handle;
+
+    if(roadmap->edge_index[0] != 0 || roadmap->edge_index[roadmap->n_nodes] != h->n_edges) {
+        dubins_roadmap_free(roadmap);
+        return EDUBFORMAT;
+    }
+    return EDUBOK;
+}
+
+void dubins_roadmap_free(DubinsRoadmap* roadmap)
+{
+    DubinsMapping m;
+    if(roadmap->storage != NULL) {
+        m.data = roadmap->storage;
+        m.size = roadmap->storage_size;
+        m.handle = roadmap->storage_handle;
+        dubins_unmap_file(&m);
+    }
+    memset(roadmap, 0, sizeof(*roadmap));
+}
+
+int dubins_roadmap_edge_path(const DubinsRoadmap* roadmap, size_t edge, DubinsPath* path)
+{
+    if(edge >= roadmap->n_edges) {
+        return EDUBPARAM;
+    }
+    if(roadmap->packed != NULL) {
+        return dubins_path_unpack(&roadmap->packed[edge], &roadmap->node_table, path);
+    }
+    *path = roadmap->paths[edge];
+    return EDUBOK;
+}
+
+double dubins_roadmap_edge_length(const DubinsRoadmap* roadmap, size_t edge)
+{
+    if(edge >= roadmap->n_edges) {
+        return INFINITY;
+    }
+    if(roadmap->packed != NULL) {
+        return dubins_packed_path_length(&roadmap->packed[edge], roadmap->rho);
+    }
+    /* the mapping is read-only, but dubins_path_length never writes */
+    return dubins_path_length((DubinsPath*)&roadmap->paths[edge]);
+}
+
+int dubins_roadmap_edge_sample(const DubinsRoadmap* roadmap, size_t edge, double t, double q[3])
+{
+    if(edge >= roadmap->n_edges) {
+        return EDUBPARAM;
+    }
+    if(roadmap->packed != NULL) {
+        return dubins_packed_path_sample(&roadmap->packed[edge], &roadmap->node_table, t, q);
+    }
+    return dubins_path_sample((DubinsPath*)&roadmap->paths[edge], t, q);
+}
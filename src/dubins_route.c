@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Streaming sampler over a chain of shortest paths.
+ */
+#include "dubins_internal.h"
+
+/* solve legs until the ring is full or the waypoints run out */
+static void fill_legs(DubinsRoute* route)
+{
+    double q[3];
+    size_t slot;
+    int err;
+    while( route->count < route->capacity && !route->waypoints_done ) {
+        if( route->next_waypoint(q, route->user_data) != 0 ) {
+            route->waypoints_done = 1;
+            break;
+        }
+        slot = (route->head + route->count) % route->capacity;
+        /* rho is checked by dubins_route_init, so only waypoints that are not
+         * finite fail; the route ends with the legs before them */
+        err = dubins_shortest_path(&route->legs[slot], route->last, q, route->rho);
+        if( err != EDUBOK ) {
+            route->error = err;
+            route->waypoints_done = 1;
+            break;
+        }
+        route->last[0] = q[0];
+        route->last[1] = q[1];
+        route->last[2] = q[2];
+        route->count++;
+    }
+}
+
+int dubins_route_init(DubinsRoute* route, DubinsWaypointCallback next_waypoint, void* user_data,
+                      double rho, double stepSize, DubinsPath* legs, size_t lookahead)
+{
+    if( rho <= 0.0 ) {
+        return EDUBBADRHO;
+    }
+    if( !(stepSize > 0) || legs == NULL || lookahead == 0 ) {
+        return EDUBPARAM;
+    }
+    route->next_waypoint = next_waypoint;
+    route->user_data = user_data;
+    route->rho = rho;
+    route->step = stepSize;
+    route->legs = legs;
+    route->capacity = lookahead;
+    route->head = 0;
+    route->count = 0;
+    route->sampling = 0;
+    route->leg = 0;
+    route->leg_start = 0.0;
+    route->carry = 0.0;
+    route->error = EDUBOK;
+    route->waypoints_done = (next_waypoint(route->last, user_data) != 0);
+    fill_legs(route);
+    return EDUBOK;
+}
+
+int dubins_route_next(DubinsRoute* route, double q[3], double* s)
+{
+    double t;
+    for( ;; ) {
+        if( route->sampling ) {
+            if( dubins_path_sampler_next(&route->sampler, q, &t) == EDUBOK ) {
+                if( s != NULL ) {
+                    *s = route->leg_start + t;
+                }
+                return EDUBOK;
+            }
+            /* the next sample lies this far into the following leg */
+            route->carry = route->sampler.t - route->sampler.length;
+            route->leg_start += route->sampler.length;
+            route->sampling = 0;
+            route->head = (route->head + 1) % route->capacity;
+            route->count--;
+            route->leg++;
+            fill_legs(route);
+        }
+        if( route->count == 0 ) {
+            return (route->error != EDUBOK) ? route->error : EDUBPARAM;
+        }
+        dubins_path_sampler_init(&route->sampler, &route->legs[route->head], route->step);
+        route->sampler.origin = route->carry;
+        route->sampling = 1;
+    }
+}
+
+size_t dubins_route_leg(const DubinsRoute* route)
+{
+    return route->leg;
+}
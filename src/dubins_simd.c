@@ -0,0 +1,417 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Vectorised block solvers and the runtime selection between them.
+ *
+ * Each supported instruction set instantiates dubins_simd_kernel.h with its
+ * own vector type.  On x86 the kernels are compiled with per-function target
+ * attributes so a single binary carries all of them, and the widest one the
+ * CPU supports is picked on first use.  WebAssembly modules built with
+ * -msimd128 always use the SIMD128 kernel.
+ */
+#include "dubins_internal.h"
+
+#if !defined(DUBINS_NO_SIMD)
+#if defined(__wasm_simd128__)
+#define DUBINS_HAVE_WASM_KERNELS
+#include <wasm_simd128.h>
+#elif defined(__EMSCRIPTEN__)
+/* scalar WebAssembly build, the module would not load if it used SIMD128 */
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define DUBINS_HAVE_X86_KERNELS
+#include <immintrin.h>
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define DUBINS_HAVE_X86_KERNELS
+#include <immintrin.h>
+#include <intrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define DUBINS_HAVE_NEON_KERNELS
+#include <arm_neon.h>
+#endif
+#endif
+
+#ifdef DUBINS_HAVE_X86_KERNELS
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define DUBINS_TARGET_SSE2
+#define DUBINS_TARGET_AVX2
+#define DUBINS_TARGET_AVX512
+#else
+#define DUBINS_TARGET_SSE2   __attribute__((target("sse2")))
+#define DUBINS_TARGET_AVX2   __attribute__((target("avx2")))
+#define DUBINS_TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+/* SSE2: 2 lanes, floor through a truncating conversion */
+#define V              __m128d
+#define VMASK          __m128d
+#define VLANES         2
+#define VLOAD          _mm_loadu_pd
+#define VSTORE         _mm_storeu_pd
+#define VSET1          _mm_set1_pd
+#define VADD           _mm_add_pd
+#define VSUB           _mm_sub_pd
+#define VMUL           _mm_mul_pd
+#define VDIV           _mm_div_pd
+#define VSQRT          _mm_sqrt_pd
+#define VABS(a)        _mm_andnot_pd(_mm_set1_pd(-0.0), (a))
+#define VFLOOR         dubins_floor_sse2
+#define VLT            _mm_cmplt_pd
+#define VLE            _mm_cmple_pd
+#define VGT            _mm_cmpgt_pd
+#define VGE            _mm_cmpge_pd
+#define VAND           _mm_and_pd
+#define VSEL(m, a, b)  _mm_or_pd(_mm_and_pd((m), (a)), _mm_andnot_pd((m), (b)))
+#define VCOPYSIGN(a, b) _mm_or_pd(VABS(a), _mm_and_pd(_mm_set1_pd(-0.0), (b)))
+#define DUBINS_KERNEL(fn) fn##_sse2
+#define DUBINS_KERNEL_TARGET DUBINS_TARGET_SSE2
+
+static DUBINS_TARGET_SSE2 __m128d dubins_floor_sse2(__m128d x)
+{
+    __m128d t = _mm_cvtepi32_pd(_mm_cvttpd_epi32(x));
+    return _mm_sub_pd(t, _mm_and_pd(_mm_cmpgt_pd(t, x), _mm_set1_pd(1.0)));
+}
+
+#include "dubins_simd_kernel.h"
+
+#undef V
+#undef VMASK
+#undef VLANES
+#undef VLOAD
+#undef VSTORE
+#undef VSET1
+#undef VADD
+#undef VSUB
+#undef VMUL
+#undef VDIV
+#undef VSQRT
+#undef VABS
+#undef VFLOOR
+#undef VLT
+#undef VLE
+#undef VGT
+#undef VGE
+#undef VAND
+#undef VSEL
+#undef VCOPYSIGN
+#undef DUBINS_KERNEL
+#undef DUBINS_KERNEL_TARGET
+
+/* AVX2: 4 lanes */
+#define V              __m256d
+#define VMASK          __m256d
+#define VLANES         4
+#define VLOAD          _mm256_loadu_pd
+#define VSTORE         _mm256_storeu_pd
+#define VSET1          _mm256_set1_pd
+#define VADD           _mm256_add_pd
+#define VSUB           _mm256_sub_pd
+#define VMUL           _mm256_mul_pd
+#define VDIV           _mm256_div_pd
+#define VSQRT          _mm256_sqrt_pd
+#define VABS(a)        _mm256_andnot_pd(_mm256_set1_pd(-0.0), (a))
+#define VFLOOR         _mm256_floor_pd
+#define VLT(a, b)      _mm256_cmp_pd((a), (b), _CMP_LT_OQ)
+#define VLE(a, b)      _mm256_cmp_pd((a), (b), _CMP_LE_OQ)
+#define VGT(a, b)      _mm256_cmp_pd((a), (b), _CMP_GT_OQ)
+#define VGE(a, b)      _mm256_cmp_pd((a), (b), _CMP_GE_OQ)
+#define VAND           _mm256_and_pd
+#define VSEL(m, a, b)  _mm256_blendv_pd((b), (a), (m))
+#define VCOPYSIGN(a, b) _mm256_or_pd(VABS(a), _mm256_and_pd(_mm256_set1_pd(-0.0), (b)))
+#define DUBINS_KERNEL(fn) fn##_avx2
+#define DUBINS_KERNEL_TARGET DUBINS_TARGET_AVX2
+
+#include "dubins_simd_kernel.h"
+
+#undef V
+#undef VMASK
+#undef VLANES
+#undef VLOAD
+#undef VSTORE
+#undef VSET1
+#undef VADD
+#undef VSUB
+#undef VMUL
+#undef VDIV
+#undef VSQRT
+#undef VABS
+#undef VFLOOR
+#undef VLT
+#undef VLE
+#undef VGT
+#undef VGE
+#undef VAND
+#undef VSEL
+#undef VCOPYSIGN
+#undef DUBINS_KERNEL
+#undef DUBINS_KERNEL_TARGET
+
+/* AVX-512: 8 lanes, comparisons produce mask registers */
+#define V              __m512d
+#define VMASK          __mmask8
+#define VLANES         8
+#define VLOAD          _mm512_loadu_pd
+#define VSTORE         _mm512_storeu_pd
+#define VSET1          _mm512_set1_pd
+#define VADD           _mm512_add_pd
+#define VSUB           _mm512_sub_pd
+#define VMUL           _mm512_mul_pd
+#define VDIV           _mm512_div_pd
+#define VSQRT          _mm512_sqrt_pd
+#define VABS           _mm512_abs_pd
+#define VFLOOR(a)      _mm512_roundscale_pd((a), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)
+#define VLT(a, b)      _mm512_cmp_pd_mask((a), (b), _CMP_LT_OQ)
+#define VLE(a, b)      _mm512_cmp_pd_mask((a), (b), _CMP_LE_OQ)
+#define VGT(a, b)      _mm512_cmp_pd_mask((a), (b), _CMP_GT_OQ)
+#define VGE(a, b)      _mm512_cmp_pd_mask((a), (b), _CMP_GE_OQ)
+#define VAND(m, n)     ((__mmask8)((m) & (n)))
+#define VSEL(m, a, b)  _mm512_mask_blend_pd((m), (b), (a))
+#define VCOPYSIGN(a, b) _mm512_castsi512_pd(_mm512_or_si512( \
+                            _mm512_castpd_si512(VABS(a)), \
+                            _mm512_and_si512(_mm512_castpd_si512(b), _mm512_castpd_si512(_mm512_set1_pd(-0.0)))))
+#define DUBINS_KERNEL(fn) fn##_avx512
+#define DUBINS_KERNEL_TARGET DUBINS_TARGET_AVX512
+
+#include "dubins_simd_kernel.h"
+
+#undef V
+#undef VMASK
+#undef VLANES
+#undef VLOAD
+#undef VSTORE
+#undef VSET1
+#undef VADD
+#undef VSUB
+#undef VMUL
+#undef VDIV
+#undef VSQRT
+#undef VABS
+#undef VFLOOR
+#undef VLT
+#undef VLE
+#undef VGT
+#undef VGE
+#undef VAND
+#undef VSEL
+#undef VCOPYSIGN
+#undef DUBINS_KERNEL
+#undef DUBINS_KERNEL_TARGET
+
+#endif /* DUBINS_HAVE_X86_KERNELS */
+
+#ifdef DUBINS_HAVE_NEON_KERNELS
+
+/* NEON (AArch64): 2 lanes, always available */
+#define V              float64x2_t
+#define VMASK          uint64x2_t
+#define VLANES         2
+#define VLOAD          vld1q_f64
+#define VSTORE         vst1q_f64
+#define VSET1          vdupq_n_f64
+#define VADD           vaddq_f64
+#define VSUB           vsubq_f64
+#define VMUL           vmulq_f64
+#define VDIV           vdivq_f64
+#define VSQRT          vsqrtq_f64
+#define VABS           vabsq_f64
+#define VFLOOR         vrndmq_f64
+#define VLT            vcltq_f64
+#define VLE            vcleq_f64
+#define VGT            vcgtq_f64
+#define VGE            vcgeq_f64
+#define VAND           vandq_u64
+#define VSEL           vbslq_f64
+#define VCOPYSIGN(a, b) vbslq_f64(vdupq_n_u64((uint64_t)1 << 63), (b), (a))
+#define DUBINS_KERNEL(fn) fn##_neon
+#define DUBINS_KERNEL_TARGET
+
+#include "dubins_simd_kernel.h"
+
+#endif /* DUBINS_HAVE_NEON_KERNELS */
+
+#ifdef DUBINS_HAVE_WASM_KERNELS
+
+/* WebAssembly SIMD128: 2 lanes, available whenever the module validated */
+#define V              v128_t
+#define VMASK          v128_t
+#define VLANES         2
+#define VLOAD          wasm_v128_load
+#define VSTORE         wasm_v128_store
+#define VSET1          wasm_f64x2_splat
+#define VADD           wasm_f64x2_add
+#define VSUB           wasm_f64x2_sub
+#define VMUL           wasm_f64x2_mul
+#define VDIV           wasm_f64x2_div
+#define VSQRT          wasm_f64x2_sqrt
+#define VABS           wasm_f64x2_abs
+#define VFLOOR         wasm_f64x2_floor
+#define VLT            wasm_f64x2_lt
+#define VLE            wasm_f64x2_le
+#define VGT            wasm_f64x2_gt
+#define VGE            wasm_f64x2_ge
+#define VAND           wasm_v128_and
+#define VSEL(m, a, b)  wasm_v128_bitselect((a), (b), (m))
+#define VCOPYSIGN(a, b) wasm_v128_bitselect((b), (a), wasm_f64x2_splat(-0.0))
+#define DUBINS_KERNEL(fn) fn##_wasm
+#define DUBINS_KERNEL_TARGET
+
+#include "dubins_simd_kernel.h"
+
+#endif /* DUBINS_HAVE_WASM_KERNELS */
+
+static int simd_supported(DubinsSimdLevel level)
+{
+    switch(level)
+    {
+    case DUBINS_SIMD_NONE:
+        return 1;
+#ifdef DUBINS_HAVE_X86_KERNELS
+#if defined(_MSC_VER) && !defined(__clang__)
+    case DUBINS_SIMD_SSE2:
+        return 1;
+    case DUBINS_SIMD_AVX2:
+    case DUBINS_SIMD_AVX512:
+    {
+        int regs[4];
+        unsigned long long xcr0;
+        __cpuid(regs, 1);
+        /* OSXSAVE and AVX */
+        if((regs[2] & (1 << 27)) == 0 || (regs[2] & (1 << 28)) == 0) {
+            return 0;
+        }
+        xcr0 = _xgetbv(0);
+        __cpuidex(regs, 7, 0);
+        if(level == DUBINS_SIMD_AVX2) {
+            return (xcr0 & 0x6) == 0x6 && (regs[1] & (1 << 5)) != 0;
+        }
+        return (xcr0 & 0xe6) == 0xe6 && (regs[1] & (1 << 16)) != 0;
+    }
+#else
+    case DUBINS_SIMD_SSE2:
+        return __builtin_cpu_supports("sse2");
+    case DUBINS_SIMD_AVX2:
+        return __builtin_cpu_supports("avx2");
+    case DUBINS_SIMD_AVX512:
+        return __builtin_cpu_supports("avx512f");
+#endif
+#endif
+#ifdef DUBINS_HAVE_NEON_KERNELS
+    case DUBINS_SIMD_NEON:
+        return 1;
+#endif
+#ifdef DUBINS_HAVE_WASM_KERNELS
+    case DUBINS_SIMD_WASM:
+        return 1;
+#endif
+    default:
+        return 0;
+    }
+}
+
+static DubinsSimdLevel simd_best_level(void)
+{
+    if(simd_supported(DUBINS_SIMD_AVX512)) {
+        return DUBINS_SIMD_AVX512;
+    }
+    if(simd_supported(DUBINS_SIMD_AVX2)) {
+        return DUBINS_SIMD_AVX2;
+    }
+    if(simd_supported(DUBINS_SIMD_SSE2)) {
+        return DUBINS_SIMD_SSE2;
+    }
+    if(simd_supported(DUBINS_SIMD_NEON)) {
+        return DUBINS_SIMD_NEON;
+    }
+    if(simd_supported(DUBINS_SIMD_WASM)) {
+        return DUBINS_SIMD_WASM;
+    }
+    return DUBINS_SIMD_NONE;
+}
+
+/*
+ * The level is read by every block solve, possibly from many threads at
+ * once, so it is accessed atomically.  Relaxed loads cost a plain move.
+ */
+#if defined(_MSC_VER)
+#include <windows.h>
+#define level_load(p)     (*(p))
+#define level_store(p, v) InterlockedExchange((volatile LONG*)(p), (LONG)(v))
+#define level_init(p, v)  InterlockedCompareExchange((volatile LONG*)(p), (LONG)(v), -1)
+#else
+#define level_load(p)     __atomic_load_n(p, __ATOMIC_RELAXED)
+#define level_store(p, v) __atomic_store_n(p, v, __ATOMIC_RELAXED)
+#define level_init(p, v)  __sync_bool_compare_and_swap(p, -1, v)
+#endif
+
+/* -1 until the first query, afterwards the level in use */
+static volatile int simd_level = -1;
+
+DubinsSimdLevel dubins_simd_level(void)
+{
+    int level = level_load(&simd_level);
+    if(level < 0) {
+        /* racing threads detect the same level, and a concurrent dubins_simd_set_level wins */
+        level_init(&simd_level, (int)simd_best_level());
+        level = level_load(&simd_level);
+    }
+    return (DubinsSimdLevel)level;
+}
+
+int dubins_simd_set_level(DubinsSimdLevel level)
+{
+    if(!simd_supported(level)) {
+        return EDUBPARAM;
+    }
+    level_store(&simd_level, (int)level);
+    return EDUBOK;
+}
+
+void dubins_words_block(const DubinsIntermediateBlock* blk, size_t n, unsigned words, DubinsBlockResult* res)
+{
+    switch(dubins_simd_level())
+    {
+#ifdef DUBINS_HAVE_X86_KERNELS
+    case DUBINS_SIMD_SSE2:
+        dubins_words_block_sse2(blk, n, words, res);
+        break;
+    case DUBINS_SIMD_AVX2:
+        dubins_words_block_avx2(blk, n, words, res);
+        break;
+    case DUBINS_SIMD_AVX512:
+        dubins_words_block_avx512(blk, n, words, res);
+        break;
+#endif
+#ifdef DUBINS_HAVE_NEON_KERNELS
+    case DUBINS_SIMD_NEON:
+        dubins_words_block_neon(blk, n, words, res);
+        break;
+#endif
+#ifdef DUBINS_HAVE_WASM_KERNELS
+    case DUBINS_SIMD_WASM:
+        dubins_words_block_wasm(blk, n, words, res);
+        break;
+#endif
+    default:
+        dubins_words_block_scalar(blk, n, words, res);
+    }
+}
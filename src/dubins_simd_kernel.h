@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Width-generic block solver for the six Dubins words.
+ *
+ * This file is included once per instruction set by dubins_simd.c, after
+ * defining the vector type and operations below.  It mirrors dubins_LSL and
+ * friends operation for operation, but evaluates VLANES problems at a time,
+ * replaces atan2 / acos with branch-free rational approximations and turns
+ * the feasibility tests into lane masks.
+ *
+ *   V, VMASK          - vector of doubles / comparison result
+ *   VLANES            - number of doubles in V
+ *   VLOAD, VSTORE     - unaligned load / store
+ *   VSET1             - broadcast a scalar
+ *   VADD, VSUB, VMUL, VDIV, VSQRT, VABS, VFLOOR
+ *   VLT, VLE, VGT, VGE
+ *   VAND              - intersection of two masks
+ *   VSEL(m, a, b)     - a where m is set, b elsewhere
+ *   VCOPYSIGN(a, b)   - |a| with the sign bit of b
+ *   DUBINS_KERNEL(fn) - decorates fn with the instruction set name
+ *   DUBINS_KERNEL_TARGET - function attributes enabling the instruction set
+ */
+
+/* Cephes atan coefficients, accurate to about 1 ulp on [0, 0.66] */
+#ifndef DUBINS_ATAN_COEFFS
+#define DUBINS_ATAN_COEFFS
+#define DUBINS_ATAN_P0 (-8.750608600031904122785E-1)
+#define DUBINS_ATAN_P1 (-1.615753718733365076637E1)
+#define DUBINS_ATAN_P2 (-7.500855792314704667340E1)
+#define DUBINS_ATAN_P3 (-1.228866684490136173410E2)
+#define DUBINS_ATAN_P4 (-6.485021904942025371773E1)
+#define DUBINS_ATAN_Q0 (2.485846490142306297962E1)
+#define DUBINS_ATAN_Q1 (1.650270098316988542046E2)
+#define DUBINS_ATAN_Q2 (4.328810604912902668951E2)
+#define DUBINS_ATAN_Q3 (4.853903996359136964868E2)
+#define DUBINS_ATAN_Q4 (1.945506571482613964425E2)
+#define DUBINS_ATAN_MOREBITS (6.123233995736765886130E-17)
+#endif
+
+/**
+ * Branch-free mod2pi, the same expression as fmodr
+ */
+static DUBINS_KERNEL_TARGET V DUBINS_KERNEL(v_mod2pi)(V theta)
+{
+    V twopi = VSET1(2 * M_PI);
+    return VSUB(theta, VMUL(twopi, VFLOOR(VDIV(theta, twopi))));
+}
+
+/**
+ * Branch-free atan2
+ *
+ * The ratio of the smaller to the larger magnitude is reduced to [-0.34, 0.66]
+ * and fed through the Cephes rational approximation, then the octant is
+ * restored with selects.
+ */
+static DUBINS_KERNEL_TARGET V DUBINS_KERNEL(v_atan2)(V y, V x)
+{
+    V zero = VSET1(0.0);
+    V one  = VSET1(1.0);
+    V ax = VABS(x);
+    V ay = VABS(y);
+    VMASK swap = VGT(ay, ax);
+    V num = VSEL(swap, ax, ay);
+    V den = VSEL(swap, ay, ax);
+    V r, z, zz, p, q, res;
+    VMASK big;
+
+    /* atan2(0, 0) is zero, avoid the 0/0 */
+    den = VSEL(VGT(den, zero), den, one);
+    r = VDIV(num, den);
+
+    big = VGT(r, VSET1(0.66));
+    z = VSEL(big, VDIV(VSUB(r, one), VADD(r, one)), r);
+    zz = VMUL(z, z);
+
+    p = VSET1(DUBINS_ATAN_P0);
+    p = VADD(VMUL(p, zz), VSET1(DUBINS_ATAN_P1));
+    p = VADD(VMUL(p, zz), VSET1(DUBINS_ATAN_P2));
+    p = VADD(VMUL(p, zz), VSET1(DUBINS_ATAN_P3));
+    p = VADD(VMUL(p, zz), VSET1(DUBINS_ATAN_P4));
+    q = VADD(zz, VSET1(DUBINS_ATAN_Q0));
+    q = VADD(VMUL(q, zz), VSET1(DUBINS_ATAN_Q1));
+    q = VADD(VMUL(q, zz), VSET1(DUBINS_ATAN_Q2));
+    q = VADD(VMUL(q, zz), VSET1(DUBINS_ATAN_Q3));
+    q = VADD(VMUL(q, zz), VSET1(DUBINS_ATAN_Q4));
+
+    res = VADD(VMUL(z, VDIV(VMUL(zz, p), q)), z);
+    res = VADD(res, VSEL(big, VSET1(M_PI_4 + 0.5 * DUBINS_ATAN_MOREBITS), zero));
+
+    /* undo the reductions: swapped axes, negative x, then the sign of y.  The
+     * sign bit of x decides, so that atan2(+-0, -0) is +-pi as in libm */
+    res = VSEL(swap, VSUB(VSET1(M_PI_2), res), res);
+    res = VSEL(VLT(VCOPYSIGN(one, x), zero), VSUB(VSET1(M_PI), res), res);
+    return VCOPYSIGN(res, y);
+}
+
+/**
+ * Branch-free acos, via atan2( sqrt(1 - x^2), x )
+ *
+ * Only valid for lanes where |x| <= 1, other lanes produce NaN
+ */
+static DUBINS_KERNEL_TARGET V DUBINS_KERNEL(v_acos)(V x)
+{
+    V one = VSET1(1.0);
+    return DUBINS_KERNEL(v_atan2)(VSQRT(VMUL(VSUB(one, x), VADD(one, x))), x);
+}
+
+/**
+ * Keep the word in the lanes where it is feasible and strictly shorter than
+ * the best word so far
+ */
+static DUBINS_KERNEL_TARGET void DUBINS_KERNEL(v_keep)(V* best_cost, V* best_word, V best_param[3],
+                                                       VMASK ok, V t, V p, V q, double word)
+{
+    V cost = VADD(VADD(t, p), q);
+    VMASK better = VAND(ok, VLT(cost, *best_cost));
+    *best_cost = VSEL(better, cost, *best_cost);
+    *best_word = VSEL(better, VSET1(word), *best_word);
+    best_param[0] = VSEL(better, t, best_param[0]);
+    best_param[1] = VSEL(better, p, best_param[1]);
+    best_param[2] = VSEL(better, q, best_param[2]);
+}
+
+static DUBINS_KERNEL_TARGET void DUBINS_KERNEL(dubins_words_block)(const DubinsIntermediateBlock* blk, size_t n,
+                                                                   unsigned words, DubinsBlockResult* res)
+{
+    size_t i, lane;
+    double word[VLANES];
+    V zero = VSET1(0.0);
+    V one  = VSET1(1.0);
+    V two  = VSET1(2.0);
+    V twopi = VSET1(2 * M_PI);
+
+    for( i = 0; i < n; i += VLANES ) {
+        V alpha = VLOAD(blk->alpha + i);
+        V beta  = VLOAD(blk->beta + i);
+        V d     = VLOAD(blk->d + i);
+        V sa    = VLOAD(blk->sa + i);
+        V sb    = VLOAD(blk->sb + i);
+        V ca    = VLOAD(blk->ca + i);
+        V cb    = VLOAD(blk->cb + i);
+        V c_ab  = VLOAD(blk->c_ab + i);
+        V d_sq  = VLOAD(blk->d_sq + i);
+        V best_cost = VSET1(INFINITY);
+        V best_word = VSET1(-1.0);
+        V best_param[3];
+        V tmp0, tmp1, p_sq, p, t, q, phi;
+
+        best_param[0] = best_param[1] = best_param[2] = zero;
+
+        if(words & DUBINS_WORD(LSL)) {
+            tmp0 = VSUB(VADD(d, sa), sb);
+            p_sq = VADD(VSUB(VADD(two, d_sq), VMUL(two, c_ab)), VMUL(VMUL(two, d), VSUB(sa, sb)));
+            tmp1 = DUBINS_KERNEL(v_atan2)(VSUB(cb, ca), tmp0);
+            t = DUBINS_KERNEL(v_mod2pi)(VSUB(tmp1, alpha));
+            p = VSQRT(p_sq);
+            q = DUBINS_KERNEL(v_mod2pi)(VSUB(beta, tmp1));
+            DUBINS_KERNEL(v_keep)(&best_cost, &best_word, best_param, VGE(p_sq, zero), t, p, q, LSL);
+        }
+        if(words & DUBINS_WORD(LSR)) {
+            p_sq = VADD(VADD(VADD(VSET1(-2.0), d_sq), VMUL(two, c_ab)), VMUL(VMUL(two, d), VADD(sa, sb)));
+            p = VSQRT(p_sq);
+            tmp0 = VSUB(DUBINS_KERNEL(v_atan2)(VSUB(VSUB(zero, ca), cb), VADD(VADD(d, sa), sb)),
+                        DUBINS_KERNEL(v_atan2)(VSET1(-2.0), p));
+            t = DUBINS_KERNEL(v_mod2pi)(VSUB(tmp0, alpha));
+            q = DUBINS_KERNEL(v_mod2pi)(VSUB(tmp0, DUBINS_KERNEL(v_mod2pi)(beta)));
+            DUBINS_KERNEL(v_keep)(&best_cost, &best_word, best_param, VGE(p_sq, zero), t, p, q, LSR);
+        }
+        if(words & DUBINS_WORD(RSL)) {
+            p_sq = VSUB(VADD(VADD(VSET1(-2.0), d_sq), VMUL(two, c_ab)), VMUL(VMUL(two, d), VADD(sa, sb)));
+            p = VSQRT(p_sq);
+            tmp0 = VSUB(DUBINS_KERNEL(v_atan2)(VADD(ca, cb), VSUB(VSUB(d, sa), sb)),
+                        DUBINS_KERNEL(v_atan2)(two, p));
+            t = DUBINS_KERNEL(v_mod2pi)(VSUB(alpha, tmp0));
+            q = DUBINS_KERNEL(v_mod2pi)(VSUB(beta, tmp0));
+            DUBINS_KERNEL(v_keep)(&best_cost, &best_word, best_param, VGE(p_sq, zero), t, p, q, RSL);
+        }
+        if(words & DUBINS_WORD(RSR)) {
+            tmp0 = VADD(VSUB(d, sa), sb);
+            p_sq = VADD(VSUB(VADD(two, d_sq), VMUL(two, c_ab)), VMUL(VMUL(two, d), VSUB(sb, sa)));
+            tmp1 = DUBINS_KERNEL(v_atan2)(VSUB(ca, cb), tmp0);
+            t = DUBINS_KERNEL(v_mod2pi)(VSUB(alpha, tmp1));
+            p = VSQRT(p_sq);
+            q = DUBINS_KERNEL(v_mod2pi)(VSUB(tmp1, beta));
+            DUBINS_KERNEL(v_keep)(&best_cost, &best_word, best_param, VGE(p_sq, zero), t, p, q, RSR);
+        }
+        if(words & DUBINS_WORD(RLR)) {
+            tmp0 = VDIV(VADD(VADD(VSUB(VSET1(6.0), d_sq), VMUL(two, c_ab)), VMUL(VMUL(two, d), VSUB(sa, sb))),
+                        VSET1(8.0));
+            phi = DUBINS_KERNEL(v_atan2)(VSUB(ca, cb), VADD(VSUB(d, sa), sb));
+            p = DUBINS_KERNEL(v_mod2pi)(VSUB(twopi, DUBINS_KERNEL(v_acos)(tmp0)));
+            t = DUBINS_KERNEL(v_mod2pi)(VADD(VSUB(alpha, phi), DUBINS_KERNEL(v_mod2pi)(VMUL(p, VSET1(0.5)))));
+            q = DUBINS_KERNEL(v_mod2pi)(VADD(VSUB(VSUB(alpha, beta), t), DUBINS_KERNEL(v_mod2pi)(p)));
+            DUBINS_KERNEL(v_keep)(&best_cost, &best_word, best_param, VLE(VABS(tmp0), one), t, p, q, RLR);
+        }
+        if(words & DUBINS_WORD(LRL)) {
+            tmp0 = VDIV(VADD(VADD(VSUB(VSET1(6.0), d_sq), VMUL(two, c_ab)), VMUL(VMUL(two, d), VSUB(sb, sa))),
+                        VSET1(8.0));
+            phi = DUBINS_KERNEL(v_atan2)(VSUB(ca, cb), VSUB(VADD(d, sa), sb));
+            p = DUBINS_KERNEL(v_mod2pi)(VSUB(twopi, DUBINS_KERNEL(v_acos)(tmp0)));
+            t = DUBINS_KERNEL(v_mod2pi)(VADD(VSUB(VSUB(zero, alpha), phi), VMUL(p, VSET1(0.5))));
+            q = DUBINS_KERNEL(v_mod2pi)(VADD(VSUB(VSUB(DUBINS_KERNEL(v_mod2pi)(beta), alpha), t),
+                                             DUBINS_KERNEL(v_mod2pi)(p)));
+            DUBINS_KERNEL(v_keep)(&best_cost, &best_word, best_param, VLE(VABS(tmp0), one), t, p, q, LRL);
+        }
+
+        VSTORE(res->cost + i, best_cost);
+        VSTORE(res->param[0] + i, best_param[0]);
+        VSTORE(res->param[1] + i, best_param[1]);
+        VSTORE(res->param[2] + i, best_param[2]);
+        VSTORE(word, best_word);
+        for( lane = 0; lane < VLANES; lane++ ) {
+            res->word[i + lane] = (int)word[lane];
+        }
+    }
+
+    /* problems that failed to set up never have a feasible word */
+    for( i = 0; i < n; i++ ) {
+        if(blk->errcode[i] != EDUBOK) {
+            res->cost[i] = INFINITY;
+            res->word[i] = -1;
+        }
+    }
+}
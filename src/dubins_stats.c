@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Opt-in solver counters.
+ *
+ * Every thread gets its own block of counters on first use, so the hot
+ * paths increment plain thread-local memory.  Blocks are pushed onto a
+ * lock-free list and never freed, so a snapshot still includes the work of
+ * threads that have exited.
+ */
+#include "dubins_internal.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef DUBINS_ENABLE_STATS
+
+#if defined(_MSC_VER)
+#include <windows.h>
+#include <intrin.h>
+#define DUBINS_THREAD_LOCAL __declspec(thread)
+#else
+#define DUBINS_THREAD_LOCAL __thread
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+#endif
+
+typedef struct DubinsStatsBlock
+{
+    DubinsStats stats;
+    struct DubinsStatsBlock* next;
+} DubinsStatsBlock;
+
+/* a shared fallback for threads whose block could not be allocated */
+static DubinsStatsBlock fallback;
+static DubinsStatsBlock* volatile blocks = &fallback;
+static DUBINS_THREAD_LOCAL DubinsStatsBlock* local;
+
+static int push_block(DubinsStatsBlock* block, DubinsStatsBlock* head)
+{
+    block->next = head;
+#if defined(_MSC_VER)
+    return InterlockedCompareExchangePointer((PVOID volatile*)&blocks, block, head) == head;
+#else
+    return __sync_bool_compare_and_swap(&blocks, head, block);
+#endif
+}
+
+DubinsStats* dubins_stats_local(void)
+{
+    DubinsStatsBlock* block = local;
+    if(block == NULL) {
+        block = (DubinsStatsBlock*)calloc(1, sizeof(DubinsStatsBlock));
+        if(block == NULL) {
+            block = &fallback;
+        }
+        else {
+            while(!push_block(block, blocks)) {
+            }
+        }
+        local = block;
+    }
+    return &block->stats;
+}
+
+#ifdef DUBINS_ENABLE_STATS_TIMING
+uint64_t dubins_stats_clock(void)
+{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+#endif
+}
+#endif
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_stats_snapshot(DubinsStats* stats)
+{
+    DubinsStatsBlock* block;
+    int i;
+    memset(stats, 0, sizeof(*stats));
+    for( block = blocks; block != NULL; block = block->next ) {
+        for( i = 0; i < 6; i++ ) {
+            stats->wins[i]        += block->stats.wins[i];
+            stats->word_calls[i]  += block->stats.word_calls[i];
+            stats->word_nopath[i] += block->stats.word_nopath[i];
+        }
+        stats->p_sq_rejects       += block->stats.p_sq_rejects;
+        stats->acos_rejects       += block->stats.acos_rejects;
+        stats->words_pruned       += block->stats.words_pruned;
+        stats->intermediate_calls += block->stats.intermediate_calls;
+        stats->intermediate_ticks += block->stats.intermediate_ticks;
+        stats->word_ticks         += block->stats.word_ticks;
+    }
+    return EDUBOK;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void dubins_stats_reset(void)
+{
+    DubinsStatsBlock* block;
+    for( block = blocks; block != NULL; block = block->next ) {
+        memset(&block->stats, 0, sizeof(block->stats));
+    }
+}
+
+#else
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_stats_snapshot(DubinsStats* stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    return EDUBPARAM;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void dubins_stats_reset(void)
+{
+}
+
+#endif
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2008-2018, Andrew Walker
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/*
+ * Trapezoidal timing of paths.
+ *
+ * The speed at the four segment boundaries is bounded by the limits of the
+ * neighbouring segments, by how fast the vehicle can speed up from the start
+ * (a forward pass) and by how fast it can slow down for the end (a backward
+ * pass).  Between two boundaries the speed then rises at accel towards the
+ * segment limit and falls at decel to the next boundary, so each segment is
+ * at most three phases of constant acceleration, and a time or a distance
+ * maps to a position in a constant number of steps.
+ */
+#include "dubins_internal.h"
+
+#define PHASES (9)
+
+static double min2(double a, double b)
+{
+    return (a < b) ? a : b;
+}
+
+static double clamp(double v, double lo, double hi)
+{
+    return (v < lo) ? lo : ((v > hi) ? hi : v);
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_trajectory_init(DubinsTrajectory* traj, DubinsPath* path, const DubinsSpeedProfile* profile)
+{
+    const SegmentType* types = DIRDATA[path->type];
+    double a = profile->accel;
+    double d = profile->decel;
+    double length[3], limit[3], open[3], b[4];
+    double qi[3];
+    double l, u, w, peak, s_acc, s_dec, s_cruise, t, s;
+    int k;
+
+    if(!(profile->straight_speed > 0) || !(profile->arc_speed > 0) || !(a > 0) || !(d > 0)
+       || !(profile->start_speed >= 0) || !(profile->end_speed >= 0)
+       || a == INFINITY || d == INFINITY || profile->start_speed == INFINITY || profile->end_speed == INFINITY) {
+        return EDUBPARAM;
+    }
+
+    traj->path = *path;
+
+    /* segment starts, exactly as dubins_path_sample finds them */
+    qi[0] = 0.0;
+    qi[1] = 0.0;
+    qi[2] = path->qi[2];
+    traj->qs[0][0] = qi[0];
+    traj->qs[0][1] = qi[1];
+    traj->qs[0][2] = qi[2];
+    dubins_segment(path->param[0], traj->qs[0], traj->qs[1], types[0]);
+    dubins_segment(path->param[1], traj->qs[1], traj->qs[2], types[1]);
+    traj->start[0] = 0.0;
+    traj->start[1] = path->param[0];
+    traj->start[2] = path->param[0] + path->param[1];
+
+    /* an empty segment must not limit the speed at its ends */
+    for( k = 0; k < 3; k++ ) {
+        length[k] = path->param[k] * path->rho;
+        limit[k] = (types[k] == S_SEG) ? profile->straight_speed : profile->arc_speed;
+        open[k] = (length[k] > 0) ? limit[k] : INFINITY;
+    }
+    b[0] = min2(profile->start_speed, open[0]);
+    b[1] = min2(open[0], open[1]);
+    b[2] = min2(open[1], open[2]);
+    b[3] = min2(profile->end_speed, open[2]);
+    for( k = 0; k < 3; k++ ) {
+        b[k + 1] = min2(b[k + 1], sqrt(b[k] * b[k] + 2 * a * length[k]));
+    }
+    for( k = 2; k >= 0; k-- ) {
+        b[k] = min2(b[k], sqrt(b[k + 1] * b[k + 1] + 2 * d * length[k]));
+    }
+
+    t = 0.0;
+    s = 0.0;
+    for( k = 0; k < 3; k++ ) {
+        l = length[k];
+        u = b[k];
+        w = b[k + 1];
+        /* the highest speed reachable between the boundaries, capped by the segment limit */
+        peak = min2(limit[k], sqrt((2 * a * d * l + d * u * u + a * w * w) / (a + d)));
+        peak = (peak > u) ? peak : u;
+        peak = (peak > w) ? peak : w;
+        s_acc = clamp((peak * peak - u * u) / (2 * a), 0.0, l);
+        s_dec = clamp((peak * peak - w * w) / (2 * d), 0.0, l - s_acc);
+        s_cruise = l - s_acc - s_dec;
+
+        traj->phase_t[3 * k] = t;
+        traj->phase_s[3 * k] = s;
+        traj->phase_v[3 * k] = u;
+        traj->phase_a[3 * k] = a;
+        t += (peak - u) / a;
+        s += s_acc;
+
+        traj->phase_t[3 * k + 1] = t;
+        traj->phase_s[3 * k + 1] = s;
+        traj->phase_v[3 * k + 1] = peak;
+        traj->phase_a[3 * k + 1] = 0.0;
+        t += (s_cruise > 0) ? s_cruise / peak : 0.0;
+        s += s_cruise;
+
+        traj->phase_t[3 * k + 2] = t;
+        traj->phase_s[3 * k + 2] = s;
+        traj->phase_v[3 * k + 2] = peak;
+        traj->phase_a[3 * k + 2] = -d;
+        t += (peak - w) / d;
+        s += s_dec;
+    }
+    traj->duration = t;
+    return EDUBOK;
+}
+
+EMSCRIPTEN_KEEPALIVE
+double dubins_trajectory_duration(const DubinsTrajectory* traj)
+{
+    return traj->duration;
+}
+
+/* the configuration, distance and speed at time t, which lies in phase p */
+static void evaluate(const DubinsTrajectory* traj, int p, double t, double q[3], double* s, double* speed)
+{
+    const SegmentType* types = DIRDATA[traj->path.type];
+    double tau = t - traj->phase_t[p];
+    double v0 = traj->phase_v[p];
+    double acc = traj->phase_a[p];
+    double dist = traj->phase_s[p] + tau * (v0 + 0.5 * acc * tau);
+    double length = dubins_path_length((DubinsPath*)&traj->path);
+    double tprime;
+    int j;
+
+    dist = clamp(dist, 0.0, length);
+    tprime = dist / traj->path.rho;
+    j = (tprime < traj->start[1]) ? 0 : ((tprime < traj->start[2]) ? 1 : 2);
+    /* subtract the segment lengths one at a time, as dubins_path_sample does */
+    if(j > 0) {
+        tprime -= traj->path.param[0];
+    }
+    if(j > 1) {
+        tprime -= traj->path.param[1];
+    }
+    dubins_segment(tprime, (double*)traj->qs[j], q, types[j]);
+    q[0] = q[0] * traj->path.rho + traj->path.qi[0];
+    q[1] = q[1] * traj->path.rho + traj->path.qi[1];
+    q[2] = mod2pi(q[2]);
+
+    if(s != NULL) {
+        *s = dist;
+    }
+    if(speed != NULL) {
+        *speed = clamp(v0 + acc * tau, 0.0, INFINITY);
+    }
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_trajectory_sample(const DubinsTrajectory* traj, double t, double q[3], double* s, double* speed)
+{
+    int p = PHASES - 1;
+    if(!(t >= 0) || t > traj->duration) {
+        return EDUBPARAM;
+    }
+    while(p > 0 && traj->phase_t[p] > t) {
+        p--;
+    }
+    evaluate(traj, p, t, q, s, speed);
+    return EDUBOK;
+}
+
+EMSCRIPTEN_KEEPALIVE
+int dubins_trajectory_time_at(const DubinsTrajectory* traj, double s, double* t)
+{
+    int p = PHASES - 1;
+    double ds, v0, root, denom;
+    if(!(s >= 0) || s > dubins_path_length((DubinsPath*)&traj->path)) {
+        return EDUBPARAM;
+    }
+    while(p > 0 && traj->phase_s[p] > s) {
+        p--;
+    }
+    /* solve ds = v0 tau + acc tau^2 / 2 in the form that stays accurate as acc goes to zero */
+    ds = s - traj->phase_s[p];
+    v0 = traj->phase_v[p];
+    root = sqrt(clamp(v0 * v0 + 2 * traj->phase_a[p] * ds, 0.0, INFINITY));
+    denom = v0 + root;
+    *t = traj->phase_t[p] + ((denom > 0) ? 2 * ds / denom : 0.0);
+    *t = min2(*t, traj->duration);
+    return EDUBOK;
+}
+
+EMSCRIPTEN_KEEPALIVE
+size_t dubins_trajectory_sample_into(const DubinsTrajectory* traj, double dt,
+                                     double* xs, double* ys, double* ths, double* ss, double* speeds,
+                                     size_t cap, size_t offset)
+{
+    double q[3];
+    double t;
+    size_t n;
+    int p = 0;
+    if(!(dt > 0)) {
+        return 0;
+    }
+    for( n = 0; n < cap; n++ ) {
+        t = (double)(offset + n) * dt;
+        if(t > traj->duration) {
+            break;
+        }
+        while(p < PHASES - 1 && traj->phase_t[p + 1] <= t) {
+            p++;
+        }
+        evaluate(traj, p, t, q, (ss != NULL) ? &ss[n] : NULL, (speeds != NULL) ? &speeds[n] : NULL);
+        if(xs != NULL) {
+            xs[n] = q[0];
+        }
+        if(ys != NULL) {
+            ys[n] = q[1];
+        }
+        if(ths != NULL) {
+            ths[n] = q[2];
+        }
+    }
+    return n;
+}
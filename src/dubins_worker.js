@@ -0,0 +1,60 @@
+/**
+ * Dubins batch worker
+ *
+ * Hosts one instance of the WASM module and solves the chunks posted by
+ * dubins_async.js.  Runs as a Node worker_threads worker or as a browser
+ * Web Worker.
+ *
+ * Messages in:  { init: { module, wasm, options } } once, then
+ *               { id, starts, ends, rho } for every chunk
+ * Messages out: { id, result: { length, type, errcode } } or { id, error }
+ */
+
+const isNode = typeof self === 'undefined'
+const port = isNode ? require('worker_threads').parentPort : self
+
+let dubins = null
+let pending = []
+
+function post(message, transfer) {
+    port.postMessage(message, transfer)
+}
+
+function solve(message) {
+    try {
+        let result = dubins.shortest_path_batch(message.starts, message.ends, message.rho)
+        /* the wrapper copies its results out of the heap, so they can be handed over */
+        post({ id: message.id, result: result },
+             [result.length.buffer, result.type.buffer, result.errcode.buffer])
+    } catch (e) {
+        post({ id: message.id, error: String(e && e.message || e) })
+    }
+}
+
+function init(options) {
+    let factory
+    if (isNode) {
+        factory = require(options.module || './dubins_loader.js')
+    } else {
+        importScripts(options.module || 'dubins.js')
+        factory = self.Dubins
+    }
+    let moduleOptions = Object.assign({}, options.options)
+    if (options.wasm) moduleOptions.locateFile = (f) => (/\.wasm$/.test(f) ? options.wasm : f)
+    /* emscripten modules are thenables, so take the module in a callback
+     * rather than resolving a promise with it */
+    factory(moduleOptions).then((module) => {
+        dubins = module
+        pending.forEach(solve)
+        pending = null
+    })
+}
+
+function onMessage(message) {
+    if (message.init) init(message.init)
+    else if (dubins) solve(message)
+    else pending.push(message)
+}
+
+if (isNode) port.on('message', onMessage)
+else port.onmessage = (e) => onMessage(e.data)
@@ -0,0 +1,229 @@
+extern "C" {
+#include "dubins.h"
+}
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+#include "gtest/gtest.h"
+
+class BatchTests : public ::testing::Test
+{
+public:
+    void SetUp()
+    {
+        srand(1234);
+        configure_inputs(200);
+    }
+
+    double uniform(double lo, double hi)
+    {
+        return lo + (hi - lo) * (rand() / (double)RAND_MAX);
+    }
+
+    void configure_inputs(size_t n)
+    {
+        x0.resize(n); y0.resize(n); th0.resize(n);
+        x1.resize(n); y1.resize(n); th1.resize(n);
+        rho.resize(n);
+        for(size_t i = 0; i < n; i++) {
+            x0[i]  = uniform(-10.0, 10.0);
+            y0[i]  = uniform(-10.0, 10.0);
+            th0[i] = uniform(-M_PI, M_PI);
+            x1[i]  = uniform(-10.0, 10.0);
+            y1[i]  = uniform(-10.0, 10.0);
+            th1[i] = uniform(-M_PI, M_PI);
+            rho[i] = uniform(0.5, 3.0);
+        }
+        in.x0 = &x0[0]; in.y0 = &y0[0]; in.th0 = &th0[0];
+        in.x1 = &x1[0]; in.y1 = &y1[0]; in.th1 = &th1[0];
+        in.rho = &rho[0];
+        in.rho_shared = 0.0;
+    }
+
+    void configure_outputs(size_t n)
+    {
+        length.assign(n, 0.0);
+        type.assign(n, LSL);
+        errcode.assign(n, -1);
+        for(int j = 0; j < 3; j++) {
+            param[j].assign(n, 0.0);
+            out.param[j] = &param[j][0];
+        }
+        out.length = &length[0];
+        out.type = &type[0];
+        out.errcode = &errcode[0];
+    }
+
+protected:
+    std::vector<double> x0, y0, th0, x1, y1, th1, rho;
+    std::vector<double> length, param[3];
+    std::vector<DubinsPathType> type;
+    std::vector<int> errcode;
+    DubinsBatchInput in;
+    DubinsBatchOutput out;
+};
+
+TEST_F(BatchTests, matchesShortestPath)
+{
+    size_t n = x0.size();
+    configure_outputs(n);
+    int err = dubins_shortest_path_batch(&in, &out, n);
+    ASSERT_EQ(err, EDUBOK);
+
+    for(size_t i = 0; i < n; i++) {
+        double q0[3] = { x0[i], y0[i], th0[i] };
+        double q1[3] = { x1[i], y1[i], th1[i] };
+        DubinsPath path;
+        ASSERT_EQ(dubins_shortest_path(&path, q0, q1, rho[i]), errcode[i]);
+        ASSERT_EQ(path.type, type[i]);
+        ASSERT_NEAR(dubins_path_length(&path), length[i], 1e-12);
+        for(int j = 0; j < 3; j++) {
+            ASSERT_NEAR(path.param[j], param[j][i], 1e-12);
+        }
+    }
+}
+
+TEST_F(BatchTests, sharedTurningRadius)
+{
+    size_t n = x0.size();
+    configure_outputs(n);
+    in.rho = NULL;
+    in.rho_shared = 2.0;
+    int err = dubins_shortest_path_batch(&in, &out, n);
+    ASSERT_EQ(err, EDUBOK);
+
+    for(size_t i = 0; i < n; i++) {
+        double q0[3] = { x0[i], y0[i], th0[i] };
+        double q1[3] = { x1[i], y1[i], th1[i] };
+        DubinsPath path;
+        dubins_shortest_path(&path, q0, q1, 2.0);
+        ASSERT_NEAR(dubins_path_length(&path), length[i], 1e-12);
+    }
+}
+
+TEST_F(BatchTests, invalidTurningRadius)
+{
+    size_t n = x0.size();
+    configure_outputs(n);
+    rho[3] = -1.0;
+    int err = dubins_shortest_path_batch(&in, &out, n);
+    ASSERT_EQ(err, EDUBBADRHO);
+    ASSERT_EQ(errcode[3], EDUBBADRHO);
+    ASSERT_EQ(length[3], INFINITY);
+    ASSERT_EQ(errcode[4], EDUBOK);
+}
+
+TEST_F(BatchTests, optionalOutputs)
+{
+    size_t n = x0.size();
+    configure_outputs(n);
+    DubinsBatchOutput partial;
+    partial.length = &length[0];
+    partial.type = NULL;
+    partial.param[0] = partial.param[1] = partial.param[2] = NULL;
+    partial.errcode = NULL;
+    int err = dubins_shortest_path_batch(&in, &partial, n);
+    ASSERT_EQ(err, EDUBOK);
+    ASSERT_GT(length[n-1], 0.0);
+}
+
+TEST_F(BatchTests, shortestLengthMatchesShortestPath)
+{
+    for(size_t i = 0; i < x0.size(); i++) {
+        double q0[3] = { x0[i], y0[i], th0[i] };
+        double q1[3] = { x1[i], y1[i], th1[i] };
+        DubinsPath path;
+        double length;
+        ASSERT_EQ(dubins_shortest_path(&path, q0, q1, rho[i]), EDUBOK);
+        ASSERT_EQ(dubins_shortest_length(&length, q0, q1, rho[i]), EDUBOK);
+        ASSERT_DOUBLE_EQ(dubins_path_length(&path), length);
+    }
+}
+
+TEST_F(BatchTests, shortestLengthBatch)
+{
+    size_t n = x0.size();
+    configure_outputs(n);
+    DubinsSimdLevel original = dubins_simd_level();
+    DubinsSimdLevel levels[] = { DUBINS_SIMD_NONE, original };
+    for(int l = 0; l < 2; l++) {
+        dubins_simd_set_level(levels[l]);
+        rho[5] = 0.0;
+        int err = dubins_shortest_length_batch(&in, &length[0], &errcode[0], n);
+        ASSERT_EQ(err, EDUBBADRHO);
+        ASSERT_EQ(errcode[5], EDUBBADRHO);
+        ASSERT_EQ(length[5], INFINITY);
+        rho[5] = 1.0;
+
+        for(size_t i = 0; i < n; i++) {
+            if(i == 5) {
+                continue;
+            }
+            double q0[3] = { x0[i], y0[i], th0[i] };
+            double q1[3] = { x1[i], y1[i], th1[i] };
+            double expected;
+            dubins_shortest_length(&expected, q0, q1, rho[i]);
+            ASSERT_EQ(errcode[i], EDUBOK);
+            ASSERT_NEAR(length[i], expected, 1e-9);
+        }
+    }
+    dubins_simd_set_level(original);
+}
+
+TEST_F(BatchTests, shortestLengthBatchPrunedBlocks)
+{
+    /* long pairs whose headings all lie in the same quadrants, so every
+     * block of the vector path runs only a few words */
+    size_t n = 100;
+    configure_inputs(n);
+    for(size_t i = 0; i < n; i++) {
+        x0[i] = y0[i] = y1[i] = 0.0;
+        x1[i] = 20.0 + i;
+        th0[i] = 0.2 + 0.01 * i;
+        th1[i] = 0.5 + 0.005 * i;
+    }
+    configure_outputs(n);
+    DubinsSimdLevel original = dubins_simd_level();
+    DubinsSimdLevel levels[] = { DUBINS_SIMD_NONE, original };
+    for(int l = 0; l < 2; l++) {
+        dubins_simd_set_level(levels[l]);
+        ASSERT_EQ(dubins_shortest_length_batch(&in, &length[0], &errcode[0], n), EDUBOK);
+        for(size_t i = 0; i < n; i++) {
+            double q0[3] = { x0[i], y0[i], th0[i] };
+            double q1[3] = { x1[i], y1[i], th1[i] };
+            double expected;
+            ASSERT_EQ(dubins_shortest_length(&expected, q0, q1, rho[i]), EDUBOK);
+            ASSERT_NEAR(length[i], expected, 1e-9);
+        }
+    }
+    dubins_simd_set_level(original);
+}
+
+TEST_F(BatchTests, interleavedConfigurations)
+{
+    size_t n = x0.size();
+    std::vector<double> q0s(3 * n), q1s(3 * n);
+    std::vector<DubinsPath> paths(n);
+    for(size_t i = 0; i < n; i++) {
+        q0s[3*i] = x0[i]; q0s[3*i+1] = y0[i]; q0s[3*i+2] = th0[i];
+        q1s[3*i] = x1[i]; q1s[3*i+1] = y1[i]; q1s[3*i+2] = th1[i];
+    }
+    errcode.assign(n, -1);
+    ASSERT_EQ(dubins_shortest_path_many(&paths[0], &q0s[0], &q1s[0], 1.5, &errcode[0], n), EDUBOK);
+    for(size_t i = 0; i < n; i++) {
+        DubinsPath path;
+        dubins_shortest_path(&path, &q0s[3*i], &q1s[3*i], 1.5);
+        ASSERT_EQ(errcode[i], EDUBOK);
+        ASSERT_EQ(paths[i].type, path.type);
+        ASSERT_EQ(paths[i].rho, 1.5);
+        for(int j = 0; j < 3; j++) {
+            ASSERT_EQ(paths[i].qi[j], path.qi[j]);
+            ASSERT_NEAR(paths[i].param[j], path.param[j], 1e-12);
+        }
+    }
+    ASSERT_EQ(dubins_shortest_path_many(&paths[0], &q0s[0], &q1s[0], 0.0, NULL, n), EDUBBADRHO);
+}
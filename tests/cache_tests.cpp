@@ -0,0 +1,200 @@
+extern "C" {
+#include "dubins_cache.h"
+}
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <random>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "random_configs.h"
+
+class CacheTests : public ::testing::Test
+{
+public:
+    void SetUp()
+    {
+        pairs = RandomConfigs(24, 8.0).pairs(300);
+    }
+
+protected:
+    std::vector<ConfigPair> pairs;
+    const double rho = 1.25;
+};
+
+static void expectSamePath(const DubinsPath& a, const DubinsPath& b)
+{
+    EXPECT_EQ(a.type, b.type);
+    EXPECT_EQ(a.rho, b.rho);
+    for(int i = 0; i < 3; i++) {
+        EXPECT_EQ(a.qi[i], b.qi[i]);
+        EXPECT_EQ(a.param[i], b.param[i]);
+    }
+}
+
+TEST_F(CacheTests, rejectsBadParameters)
+{
+    EXPECT_EQ(dubins_path_cache_create(64, -1.0), nullptr);
+    EXPECT_EQ(dubins_path_cache_create(64, NAN), nullptr);
+}
+
+TEST_F(CacheTests, exactHitsMatchSolver)
+{
+    DubinsPathCache* cache = dubins_path_cache_create(65536, 0.0);
+    ASSERT_NE(cache, nullptr);
+    for(int round = 0; round < 2; round++) {
+        for(auto& pair : pairs) {
+            DubinsPath expected, path;
+            ASSERT_EQ(dubins_shortest_path(&expected, pair.q0, pair.q1, rho), EDUBOK);
+            ASSERT_EQ(dubins_shortest_path_cached(cache, &path, pair.q0, pair.q1, rho), EDUBOK);
+            expectSamePath(path, expected);
+        }
+    }
+    DubinsPathCacheStats stats;
+    dubins_path_cache_stats(cache, &stats);
+    EXPECT_EQ(stats.misses, pairs.size());
+    EXPECT_EQ(stats.insertions, pairs.size());
+    EXPECT_EQ(stats.hits, pairs.size());
+    EXPECT_EQ(stats.evictions, 0u);
+
+    dubins_path_cache_clear(cache);
+    dubins_path_cache_stats(cache, &stats);
+    EXPECT_EQ(stats.hits + stats.misses + stats.insertions + stats.evictions, 0u);
+    DubinsPath path;
+    ASSERT_EQ(dubins_shortest_path_cached(cache, &path, pairs[0].q0, pairs[0].q1, rho), EDUBOK);
+    dubins_path_cache_stats(cache, &stats);
+    EXPECT_EQ(stats.misses, 1u);
+    dubins_path_cache_destroy(cache);
+}
+
+TEST_F(CacheTests, wordsAndErrorsAreCachedSeparately)
+{
+    DubinsPathCache* cache = dubins_path_cache_create(65536, 0.0);
+    ASSERT_NE(cache, nullptr);
+    for(int round = 0; round < 2; round++) {
+        for(auto& pair : pairs) {
+            for(int w = LSL; w <= LRL; w++) {
+                DubinsPath expected, path;
+                int expected_err = dubins_path(&expected, pair.q0, pair.q1, rho, (DubinsPathType)w);
+                ASSERT_EQ(dubins_path_cached(cache, &path, pair.q0, pair.q1, rho, (DubinsPathType)w),
+                          expected_err);
+                if(expected_err == EDUBOK) {
+                    expectSamePath(path, expected);
+                }
+            }
+            DubinsPath other;
+            ASSERT_EQ(dubins_path_cached(cache, &other, pair.q0, pair.q1, 2 * rho, LSL), EDUBOK);
+            EXPECT_EQ(other.rho, 2 * rho);
+        }
+    }
+    DubinsPathCacheStats stats;
+    dubins_path_cache_stats(cache, &stats);
+    EXPECT_EQ(stats.misses, 7 * pairs.size());
+    EXPECT_EQ(stats.hits, 7 * pairs.size());
+    dubins_path_cache_destroy(cache);
+}
+
+TEST_F(CacheTests, toleranceSharesEntries)
+{
+    DubinsPathCache* cache = dubins_path_cache_create(64, 0.01);
+    ASSERT_NE(cache, nullptr);
+    double q0[3] = { 1.001, 2.001, 0.501 };
+    double q1[3] = { 6.001, -3.001, 2.001 };
+    double near0[3] = { 1.008, 2.004, 0.501 + 2 * M_PI };
+    DubinsPath first, second;
+    ASSERT_EQ(dubins_shortest_path_cached(cache, &first, q0, q1, rho), EDUBOK);
+    ASSERT_EQ(dubins_shortest_path_cached(cache, &second, near0, q1, rho), EDUBOK);
+    DubinsPathCacheStats stats;
+    dubins_path_cache_stats(cache, &stats);
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(second.type, first.type);
+    for(int i = 0; i < 3; i++) {
+        EXPECT_EQ(second.param[i], first.param[i]);
+        EXPECT_EQ(second.qi[i], near0[i]);
+    }
+
+    double far0[3] = { 1.011, 2.001, 0.501 };
+    ASSERT_EQ(dubins_shortest_path_cached(cache, &second, far0, q1, rho), EDUBOK);
+    dubins_path_cache_stats(cache, &stats);
+    EXPECT_EQ(stats.misses, 2u);
+    dubins_path_cache_destroy(cache);
+}
+
+TEST_F(CacheTests, evictsWhenFull)
+{
+    DubinsPathCache* cache = dubins_path_cache_create(8, 0.0);
+    ASSERT_NE(cache, nullptr);
+    for(int round = 0; round < 3; round++) {
+        for(auto& pair : pairs) {
+            DubinsPath expected, path;
+            ASSERT_EQ(dubins_shortest_path(&expected, pair.q0, pair.q1, rho), EDUBOK);
+            ASSERT_EQ(dubins_shortest_path_cached(cache, &path, pair.q0, pair.q1, rho), EDUBOK);
+            expectSamePath(path, expected);
+        }
+    }
+    DubinsPathCacheStats stats;
+    dubins_path_cache_stats(cache, &stats);
+    EXPECT_EQ(stats.hits + stats.misses, 3 * pairs.size());
+    EXPECT_EQ(stats.insertions, stats.misses);
+    EXPECT_EQ(stats.evictions, stats.insertions - 8);
+    dubins_path_cache_destroy(cache);
+}
+
+TEST_F(CacheTests, recentlyUsedEntriesSurvive)
+{
+    DubinsPathCache* cache = dubins_path_cache_create(8, 0.0);
+    ASSERT_NE(cache, nullptr);
+    DubinsPath path;
+    for(size_t i = 0; i < pairs.size(); i++) {
+        /* the hot pair is touched between every insertion, so CLOCK keeps it */
+        ASSERT_EQ(dubins_shortest_path_cached(cache, &path, pairs[0].q0, pairs[0].q1, rho), EDUBOK);
+        ASSERT_EQ(dubins_shortest_path_cached(cache, &path, pairs[i].q0, pairs[i].q1, rho), EDUBOK);
+    }
+    DubinsPathCacheStats stats;
+    dubins_path_cache_stats(cache, &stats);
+    EXPECT_EQ(stats.misses, pairs.size());
+    dubins_path_cache_destroy(cache);
+}
+
+TEST_F(CacheTests, concurrentUseMatchesSolver)
+{
+    DubinsPathCache* cache = dubins_path_cache_create(64, 0.0);
+    ASSERT_NE(cache, nullptr);
+    std::vector<DubinsPath> expected(pairs.size());
+    for(size_t i = 0; i < pairs.size(); i++) {
+        ASSERT_EQ(dubins_shortest_path(&expected[i], pairs[i].q0, pairs[i].q1, rho), EDUBOK);
+    }
+
+    const int n_threads = 4;
+    std::vector<int> mismatches(n_threads, 0);
+    std::vector<std::thread> threads;
+    for(int t = 0; t < n_threads; t++) {
+        threads.emplace_back([&, t]() {
+            std::mt19937 gen(t);
+            std::uniform_int_distribution<size_t> pick(0, pairs.size() - 1);
+            for(int i = 0; i < 20000; i++) {
+                size_t j = pick(gen);
+                DubinsPath path;
+                if(dubins_shortest_path_cached(cache, &path, pairs[j].q0, pairs[j].q1, rho) != EDUBOK
+                   || path.type != expected[j].type || path.param[0] != expected[j].param[0]
+                   || path.param[1] != expected[j].param[1] || path.param[2] != expected[j].param[2]
+                   || path.qi[0] != expected[j].qi[0]) {
+                    mismatches[t]++;
+                }
+            }
+        });
+    }
+    for(auto& thread : threads) {
+        thread.join();
+    }
+    for(int t = 0; t < n_threads; t++) {
+        EXPECT_EQ(mismatches[t], 0);
+    }
+    DubinsPathCacheStats stats;
+    dubins_path_cache_stats(cache, &stats);
+    EXPECT_EQ(stats.hits + stats.misses, (uint64_t)n_threads * 20000);
+    dubins_path_cache_destroy(cache);
+}
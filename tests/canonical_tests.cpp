@@ -0,0 +1,172 @@
+extern "C" {
+#include "dubins.h"
+}
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "random_configs.h"
+
+class CanonicalTests : public ::testing::Test
+{
+public:
+    void SetUp()
+    {
+        pairs = RandomConfigs(25, 10.0).pairs(1000);
+    }
+
+protected:
+    std::vector<ConfigPair> pairs;
+    const double rho = 1.5;
+};
+
+static double angleDiff(double a, double b)
+{
+    return fabs(remainder(a - b, 2 * M_PI));
+}
+
+TEST_F(CanonicalTests, mirrorTypeSwapsTurns)
+{
+    EXPECT_EQ(dubins_mirror_type(LSL), RSR);
+    EXPECT_EQ(dubins_mirror_type(LSR), RSL);
+    EXPECT_EQ(dubins_mirror_type(RLR), LRL);
+    for(int w = LSL; w <= LRL; w++) {
+        EXPECT_EQ(dubins_mirror_type(dubins_mirror_type((DubinsPathType)w)), w);
+    }
+}
+
+TEST_F(CanonicalTests, invariantUnderRigidMotion)
+{
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<double> shift(-100.0, 100.0);
+    std::uniform_real_distribution<double> angle(0.0, 2 * M_PI);
+    for(auto& pair : pairs) {
+        double r = angle(gen), tx = shift(gen), ty = shift(gen);
+        double c = cos(r), s = sin(r);
+        double m0[3] = { c * pair.q0[0] - s * pair.q0[1] + tx, s * pair.q0[0] + c * pair.q0[1] + ty, pair.q0[2] + r };
+        double m1[3] = { c * pair.q1[0] - s * pair.q1[1] + tx, s * pair.q1[0] + c * pair.q1[1] + ty, pair.q1[2] + r };
+        DubinsCanonicalPair a, b;
+        ASSERT_EQ(dubins_canonicalize(&a, pair.q0, pair.q1, rho), EDUBOK);
+        ASSERT_EQ(dubins_canonicalize(&b, m0, m1, rho), EDUBOK);
+        EXPECT_GE(a.alpha, 0.0);
+        EXPECT_LE(a.alpha, M_PI);
+        EXPECT_NEAR(a.d, b.d, 1e-9);
+        EXPECT_LT(angleDiff(a.alpha, b.alpha), 1e-9);
+        EXPECT_LT(angleDiff(a.beta, b.beta), 1e-9);
+    }
+}
+
+TEST_F(CanonicalTests, reflectionSharesCanonicalForm)
+{
+    for(auto& pair : pairs) {
+        double m0[3] = { pair.q0[0], -pair.q0[1], -pair.q0[2] };
+        double m1[3] = { pair.q1[0], -pair.q1[1], -pair.q1[2] };
+        DubinsCanonicalPair a, b;
+        ASSERT_EQ(dubins_canonicalize(&a, pair.q0, pair.q1, rho), EDUBOK);
+        ASSERT_EQ(dubins_canonicalize(&b, m0, m1, rho), EDUBOK);
+        EXPECT_NE(a.mirrored, b.mirrored);
+        EXPECT_NEAR(a.d, b.d, 1e-12);
+        EXPECT_LT(angleDiff(a.alpha, b.alpha), 1e-9);
+        EXPECT_LT(angleDiff(a.beta, b.beta), 1e-9);
+    }
+}
+
+TEST_F(CanonicalTests, shortestMatchesSolver)
+{
+    for(auto& pair : pairs) {
+        DubinsCanonicalPair canonical;
+        DubinsPathType type;
+        double param[3];
+        DubinsPath expected, path;
+        ASSERT_EQ(dubins_shortest_path(&expected, pair.q0, pair.q1, rho), EDUBOK);
+        ASSERT_EQ(dubins_canonicalize(&canonical, pair.q0, pair.q1, rho), EDUBOK);
+        ASSERT_EQ(dubins_canonical_shortest(&canonical, &type, param), EDUBOK);
+        ASSERT_EQ(dubins_canonical_attach(&path, &canonical, type, param, pair.q0, rho), EDUBOK);
+        if(!canonical.mirrored) {
+            EXPECT_EQ(path.type, expected.type);
+            for(int i = 0; i < 3; i++) {
+                EXPECT_EQ(path.param[i], expected.param[i]);
+                EXPECT_EQ(path.qi[i], expected.qi[i]);
+            }
+        }
+        EXPECT_NEAR(dubins_path_length(&path), dubins_path_length(&expected), 1e-9);
+
+        double end[3];
+        ASSERT_EQ(dubins_path_endpoint(&path, end), EDUBOK);
+        EXPECT_NEAR(end[0], pair.q1[0], 1e-8);
+        EXPECT_NEAR(end[1], pair.q1[1], 1e-8);
+        EXPECT_LT(angleDiff(end[2], pair.q1[2]), 1e-8);
+    }
+}
+
+TEST_F(CanonicalTests, wordsMatchSolver)
+{
+    for(auto& pair : pairs) {
+        DubinsCanonicalPair canonical;
+        ASSERT_EQ(dubins_canonicalize(&canonical, pair.q0, pair.q1, rho), EDUBOK);
+        for(int w = LSL; w <= LRL; w++) {
+            DubinsPathType word = (DubinsPathType)w;
+            DubinsPathType asked = canonical.mirrored ? dubins_mirror_type(word) : word;
+            DubinsPath expected, path;
+            double param[3];
+            int expected_err = dubins_path(&expected, pair.q0, pair.q1, rho, word);
+            ASSERT_EQ(dubins_canonical_word(&canonical, asked, param), expected_err);
+            if(expected_err != EDUBOK) {
+                continue;
+            }
+            ASSERT_EQ(dubins_canonical_attach(&path, &canonical, asked, param, pair.q0, rho), EDUBOK);
+            EXPECT_EQ(path.type, word);
+            for(int i = 0; i < 3; i++) {
+                EXPECT_NEAR(path.param[i], expected.param[i], 1e-9);
+            }
+        }
+    }
+}
+
+TEST_F(CanonicalTests, mirroredPairsShareOneSolve)
+{
+    for(auto& pair : pairs) {
+        double m0[3] = { pair.q0[0] + 3.0, 7.0 - pair.q0[1], -pair.q0[2] };
+        double m1[3] = { pair.q1[0] + 3.0, 7.0 - pair.q1[1], -pair.q1[2] };
+        DubinsCanonicalPair a, b;
+        DubinsPathType type;
+        double param[3];
+        ASSERT_EQ(dubins_canonicalize(&a, pair.q0, pair.q1, rho), EDUBOK);
+        ASSERT_EQ(dubins_canonicalize(&b, m0, m1, rho), EDUBOK);
+        ASSERT_EQ(dubins_canonical_shortest(&a, &type, param), EDUBOK);
+
+        DubinsPath path;
+        double end[3];
+        ASSERT_EQ(dubins_canonical_attach(&path, &b, type, param, m0, rho), EDUBOK);
+        ASSERT_EQ(dubins_path_endpoint(&path, end), EDUBOK);
+        EXPECT_NEAR(end[0], m1[0], 1e-7);
+        EXPECT_NEAR(end[1], m1[1], 1e-7);
+        EXPECT_LT(angleDiff(end[2], m1[2]), 1e-7);
+    }
+}
+
+TEST_F(CanonicalTests, tiesOnTheLine)
+{
+    double q0[3] = { 0.0, 0.0, 0.0 };
+    double q1[3] = { 5.0, 0.0, 1.5 * M_PI };
+    DubinsCanonicalPair canonical;
+    ASSERT_EQ(dubins_canonicalize(&canonical, q0, q1, 1.0), EDUBOK);
+    EXPECT_TRUE(canonical.mirrored);
+    EXPECT_EQ(canonical.alpha, 0.0);
+    EXPECT_NEAR(canonical.beta, 0.5 * M_PI, 1e-12);
+}
+
+TEST_F(CanonicalTests, rejectsBadInput)
+{
+    DubinsCanonicalPair canonical;
+    DubinsPath path;
+    double param[3] = { 1.0, 1.0, 1.0 };
+    EXPECT_EQ(dubins_canonicalize(&canonical, pairs[0].q0, pairs[0].q1, 0.0), EDUBBADRHO);
+    ASSERT_EQ(dubins_canonicalize(&canonical, pairs[0].q0, pairs[0].q1, rho), EDUBOK);
+    EXPECT_EQ(dubins_canonical_attach(&path, &canonical, LSL, param, pairs[0].q0, -1.0), EDUBBADRHO);
+    EXPECT_EQ(dubins_canonical_attach(&path, &canonical, (DubinsPathType)6, param, pairs[0].q0, rho), EDUBPARAM);
+}
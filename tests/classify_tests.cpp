@@ -0,0 +1,70 @@
+extern "C" {
+#include "dubins.h"
+}
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <stdlib.h>
+#include "gtest/gtest.h"
+
+class ClassifyTests : public ::testing::Test
+{
+public:
+    void SetUp()
+    {
+        srand(99);
+    }
+
+    double uniform(double lo, double hi)
+    {
+        return lo + (hi - lo) * (rand() / (double)RAND_MAX);
+    }
+
+    void verify(double a, double b, double d)
+    {
+        double q0[3] = { 0.0, 0.0, a };
+        double q1[3] = { d, 0.0, b };
+        DubinsPath full, classified;
+        int err = dubins_shortest_path_scan(&full, q0, q1, 1.0, DUBINS_SCAN_VERIFY);
+        ASSERT_NE(err, EDUBVERIFY) << "a " << a << " b " << b << " d " << d;
+        dubins_shortest_path_scan(&full, q0, q1, 1.0, DUBINS_SCAN_FULL);
+        dubins_shortest_path(&classified, q0, q1, 1.0);
+        ASSERT_EQ(full.type, classified.type);
+    }
+};
+
+TEST_F(ClassifyTests, randomConfigurations)
+{
+    for(int i = 0; i < 100000; i++) {
+        verify(uniform(0, 2 * M_PI), uniform(0, 2 * M_PI), uniform(0.0, 20.0));
+    }
+}
+
+TEST_F(ClassifyTests, nearCriticalDistance)
+{
+    for(int i = 0; i < 100000; i++) {
+        verify(uniform(0, 2 * M_PI), uniform(0, 2 * M_PI), uniform(3.9, 4.5));
+    }
+}
+
+TEST_F(ClassifyTests, quadrantBoundaries)
+{
+    for(int i = 0; i < 8; i++) {
+        for(int j = 0; j < 8; j++) {
+            for(double d = 0.0; d < 10.0; d += 0.25) {
+                verify(i * M_PI / 4, j * M_PI / 4, d);
+                verify(i * M_PI / 4 + 1e-9, j * M_PI / 4 - 1e-9, d);
+            }
+        }
+    }
+}
+
+TEST_F(ClassifyTests, invalidTurningRadius)
+{
+    double q0[3] = { 0.0, 0.0, 0.0 };
+    double q1[3] = { 1.0, 0.0, 0.0 };
+    DubinsPath path;
+    ASSERT_EQ(dubins_shortest_path_scan(&path, q0, q1, 0.0, DUBINS_SCAN_VERIFY), EDUBBADRHO);
+}
@@ -0,0 +1,264 @@
+extern "C" {
+#include "dubins_collision.h"
+}
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "random_configs.h"
+
+static double segment_distance(double px, double py, double ax, double ay, double bx, double by)
+{
+    double dx = bx - ax, dy = by - ay;
+    double u = ((px - ax) * dx + (py - ay) * dy) / (dx * dx + dy * dy);
+    u = fmax(0.0, fmin(1.0, u));
+    return hypot(ax + u * dx - px, ay + u * dy - py);
+}
+
+// signed distance from a point to each kind of obstacle, negative inside
+static double distance(const DubinsCircle& c, double x, double y)
+{
+    return hypot(x - c.x, y - c.y) - c.r;
+}
+
+static double distance(const DubinsBox& b, double x, double y)
+{
+    double dx = fmax(b.x_min - x, x - b.x_max);
+    double dy = fmax(b.y_min - y, y - b.y_max);
+    if(dx <= 0 && dy <= 0) {
+        return fmax(dx, dy);
+    }
+    return hypot(fmax(dx, 0.0), fmax(dy, 0.0));
+}
+
+static double distance(const DubinsPolygon& p, double x, double y)
+{
+    double d = INFINITY;
+    bool inside = false;
+    for(size_t i = 0, j = p.n - 1; i < p.n; j = i++) {
+        const double* a = &p.xy[2 * j];
+        const double* b = &p.xy[2 * i];
+        d = fmin(d, segment_distance(x, y, a[0], a[1], b[0], b[1]));
+        if(((b[1] > y) != (a[1] > y)) && (x < (a[0] - b[0]) * (y - b[1]) / (a[1] - b[1]) + b[0])) {
+            inside = !inside;
+        }
+    }
+    return inside ? -d : d;
+}
+
+// positions along a path at 1e-3 steps, and its end
+static std::vector<double> sample_path(DubinsPath& path)
+{
+    double len = dubins_path_length(&path);
+    std::vector<double> xy;
+    double q[3];
+    for(double t = 0; t <= len; t += 1e-3) {
+        dubins_path_sample(&path, t, q);
+        xy.push_back(q[0]);
+        xy.push_back(q[1]);
+    }
+    dubins_path_sample(&path, len, q);
+    xy.push_back(q[0]);
+    xy.push_back(q[1]);
+    return xy;
+}
+
+template <typename Shape>
+static double closest_sample(const std::vector<double>& xy, const Shape& shape)
+{
+    double best = INFINITY;
+    for(size_t i = 0; i < xy.size(); i += 2) {
+        best = fmin(best, distance(shape, xy[i], xy[i + 1]));
+    }
+    return best;
+}
+
+template <typename Shape>
+static void check_against_sampling(DubinsPath& path, const std::vector<double>& xy,
+                                   const DubinsObstacles& obstacles, const Shape& shape)
+{
+    double closest = closest_sample(xy, shape);
+    int collides = dubins_path_collides(&path, &obstacles, NULL);
+    if(closest < -1e-6) {
+        ASSERT_EQ(collides, 1);
+    }
+    else if(closest > 1e-3) {
+        ASSERT_EQ(collides, 0);
+    }
+}
+
+class CollisionTests : public ::testing::Test
+{
+public:
+    void SetUp()
+    {
+        RandomConfigs configs(31, 5.0);
+        for(int i = 0; i < 60; i++) {
+            double q0[3], q1[3];
+            configs.next(q0);
+            configs.next(q1);
+            DubinsPath path;
+            dubins_shortest_path(&path, q0, q1, 1.0);
+            paths.push_back(path);
+            samples.push_back(sample_path(path));
+        }
+        for(int i = 0; i < 20; i++) {
+            DubinsCircle c = { configs.position(), configs.position(), configs.uniform(0.1, 2.0) };
+            circles.push_back(c);
+            double x = configs.position(), y = configs.position();
+            DubinsBox b = { x, y, x + configs.uniform(0.1, 2.0), y + configs.uniform(0.1, 2.0) };
+            boxes.push_back(b);
+            std::vector<double> v;
+            double cx = configs.position(), cy = configs.position(), r = configs.uniform(0.1, 2.0);
+            // a concave star
+            for(int k = 0; k < 10; k++) {
+                double rk = (k % 2) ? r : r / 3;
+                v.push_back(cx + rk * cos(k * M_PI / 5));
+                v.push_back(cy + rk * sin(k * M_PI / 5));
+            }
+            vertices.push_back(v);
+        }
+    }
+
+protected:
+    std::vector<DubinsPath> paths;
+    // the positions of each path, sampled once for every obstacle test
+    std::vector<std::vector<double>> samples;
+    std::vector<DubinsCircle> circles;
+    std::vector<DubinsBox> boxes;
+    std::vector<std::vector<double>> vertices;
+};
+
+TEST_F(CollisionTests, circlesMatchSampling)
+{
+    for(size_t i = 0; i < paths.size(); i++) {
+        for(auto& c : circles) {
+            DubinsObstacles obstacles = { &c, 1, NULL, 0, NULL, 0 };
+            check_against_sampling(paths[i], samples[i], obstacles, c);
+        }
+    }
+}
+
+TEST_F(CollisionTests, boxesMatchSampling)
+{
+    for(size_t i = 0; i < paths.size(); i++) {
+        for(auto& b : boxes) {
+            DubinsObstacles obstacles = { NULL, 0, &b, 1, NULL, 0 };
+            check_against_sampling(paths[i], samples[i], obstacles, b);
+        }
+    }
+}
+
+TEST_F(CollisionTests, polygonsMatchSampling)
+{
+    for(size_t i = 0; i < paths.size(); i++) {
+        for(auto& v : vertices) {
+            DubinsPolygon p = { v.data(), v.size() / 2 };
+            DubinsObstacles obstacles = { NULL, 0, NULL, 0, &p, 1 };
+            check_against_sampling(paths[i], samples[i], obstacles, p);
+        }
+    }
+}
+
+TEST_F(CollisionTests, thinObstacles)
+{
+    // a straight path passing through a wall far thinner than any sample spacing
+    double q0[3] = { 0, 0, 0 };
+    double q1[3] = { 10, 0, 0 };
+    DubinsPath path;
+    ASSERT_EQ(dubins_shortest_path(&path, q0, q1, 1.0), EDUBOK);
+    DubinsBox wall = { 5.0, -1.0, 5.0 + 1e-9, 1.0 };
+    DubinsCircle dot = { 3.0, 1e-7, 1e-6 };
+    double tri[6] = { 7.0, -1e-9, 7.5, -2.0, 6.5, -2.0 };
+    DubinsPolygon spike = { tri, 3 };
+    DubinsObstacles walls = { NULL, 0, &wall, 1, NULL, 0 };
+    DubinsObstacles dots = { &dot, 1, NULL, 0, NULL, 0 };
+    DubinsObstacles spikes = { NULL, 0, NULL, 0, &spike, 1 };
+    DubinsCollision hit;
+    ASSERT_EQ(dubins_path_collides(&path, &walls, &hit), 1);
+    ASSERT_EQ(hit.kind, DUBINS_OBSTACLE_BOX);
+    ASSERT_EQ(hit.segment, 1);
+    ASSERT_EQ(dubins_path_collides(&path, &dots, NULL), 1);
+    ASSERT_EQ(dubins_path_collides(&path, &spikes, NULL), 0);
+    tri[1] = 0.0;
+    ASSERT_EQ(dubins_path_collides(&path, &spikes, NULL), 1);
+}
+
+TEST_F(CollisionTests, firstHit)
+{
+    // an LSL path, with obstacles on its last arc and its first
+    double q0[3] = { 0, 3, M_PI };
+    double q1[3] = { 0, -3, 0 };
+    DubinsPath path;
+    ASSERT_EQ(dubins_path(&path, q0, q1, 1.0, LSL), EDUBOK);
+    DubinsCircle cs[2] = { { -0.6, -2.8, 0.1 }, { -0.84, 2.54, 0.1 } };
+    DubinsObstacles obstacles = { cs, 2, NULL, 0, NULL, 0 };
+    DubinsCollision hit;
+    ASSERT_EQ(dubins_path_collides(&path, &obstacles, &hit), 1);
+    ASSERT_EQ(hit.segment, 0);
+    ASSERT_EQ(hit.index, 1u);
+    obstacles.n_circles = 1;
+    ASSERT_EQ(dubins_path_collides(&path, &obstacles, &hit), 1);
+    ASSERT_EQ(hit.segment, 2);
+    ASSERT_EQ(hit.index, 0u);
+
+    DubinsObstacles none = { NULL, 0, NULL, 0, NULL, 0 };
+    ASSERT_EQ(dubins_path_collides(&path, &none, &hit), 0);
+}
+
+TEST_F(CollisionTests, boundsAreTight)
+{
+    std::vector<DubinsBox> batch(paths.size());
+    dubins_path_bounds_batch(paths.data(), paths.size(), batch.data());
+    for(size_t i = 0; i < paths.size(); i++) {
+        DubinsPath& path = paths[i];
+        DubinsBox box;
+        DubinsCircle circle;
+        dubins_path_bounds(&path, &box);
+        dubins_path_bounding_circle(&path, &circle);
+        ASSERT_EQ(batch[i].x_min, box.x_min);
+        ASSERT_EQ(batch[i].y_max, box.y_max);
+
+        DubinsBox sampled = { INFINITY, INFINITY, -INFINITY, -INFINITY };
+        double len = dubins_path_length(&path);
+        double q[3], far = 0;
+        for(double t = 0; t <= len; t += 1e-3) {
+            dubins_path_sample(&path, t, q);
+            ASSERT_GE(q[0], box.x_min - 1e-9);
+            ASSERT_LE(q[0], box.x_max + 1e-9);
+            ASSERT_GE(q[1], box.y_min - 1e-9);
+            ASSERT_LE(q[1], box.y_max + 1e-9);
+            sampled.x_min = fmin(sampled.x_min, q[0]);
+            sampled.x_max = fmax(sampled.x_max, q[0]);
+            sampled.y_min = fmin(sampled.y_min, q[1]);
+            sampled.y_max = fmax(sampled.y_max, q[1]);
+            far = fmax(far, hypot(q[0] - circle.x, q[1] - circle.y));
+        }
+        ASSERT_NEAR(sampled.x_min, box.x_min, 1e-3);
+        ASSERT_NEAR(sampled.x_max, box.x_max, 1e-3);
+        ASSERT_NEAR(sampled.y_min, box.y_min, 1e-3);
+        ASSERT_NEAR(sampled.y_max, box.y_max, 1e-3);
+        ASSERT_LE(far, circle.r + 1e-9);
+        ASSERT_NEAR(far, circle.r, 1e-3);
+        ASSERT_LE(circle.r, hypot(box.x_max - box.x_min, box.y_max - box.y_min) / 2 + 1e-9);
+
+        // the segment boxes cover the path box
+        DubinsBox seg;
+        DubinsBox merged = { INFINITY, INFINITY, -INFINITY, -INFINITY };
+        for(int s = 0; s < 3; s++) {
+            ASSERT_EQ(dubins_segment_bounds(&path, s, &seg), EDUBOK);
+            merged.x_min = fmin(merged.x_min, seg.x_min);
+            merged.x_max = fmax(merged.x_max, seg.x_max);
+            merged.y_min = fmin(merged.y_min, seg.y_min);
+            merged.y_max = fmax(merged.y_max, seg.y_max);
+        }
+        ASSERT_EQ(merged.x_min, box.x_min);
+        ASSERT_EQ(merged.x_max, box.x_max);
+        ASSERT_EQ(merged.y_min, box.y_min);
+        ASSERT_EQ(merged.y_max, box.y_max);
+        ASSERT_EQ(dubins_segment_bounds(&path, 3, &seg), EDUBPARAM);
+    }
+}
@@ -1,5 +1,6 @@
 const path = require('path')
 const Dubins = require('../dist/dubins.js');
+const loader = require('../src/dubins_loader.js');
 
 const DubinsWASMFile = path.resolve(__dirname, '../dist/dubins.wasm');
 
@@ -84,14 +85,18 @@ const sampleMock = [
 ];
 
 
-describe('Dubins JS Wrapper', () => {
+/* both flavours built by gulp build, the SIMD128 + threads one included */
+const flavours = [
+    ['scalar', '../dist/dubins.js'],
+    ['simd', '../dist/dubins.simd.js'],
+];
+
+describe.each(flavours)('Dubins JS Wrapper (%s)', (flavour, file) => {
     let dubins = null;
     beforeAll(() => {
-        return Dubins({
+        return require(file)({
             'ENVIRONMENT': 'NODE',
-            locateFile: (f) => {
-                return (f === 'dubins.wasm' && DubinsWASMFile);
-            }
+            locateFile: (f) => path.resolve(__dirname, '../dist', f)
         }).then((module) => { dubins = module })
     })
 
@@ -100,6 +105,7 @@ describe('Dubins JS Wrapper', () => {
         expect(dubins.shortest_path).toBeDefined();
         expect(dubins.path_length).toBeDefined();
         expect(dubins.sample).toBeDefined();
+        expect(dubins.sampleMany).toBeDefined();
     })
     test('Creating a new path', () => {
         let path = dubins.shortest_path([0, 0, 0], [200, 200, Math.PI], 50);
@@ -107,6 +113,10 @@ describe('Dubins JS Wrapper', () => {
         expect(path.type).toBeDefined();
         expect(path.length).toBeGreaterThan(0);
     })
+    test('Errors return the code', () => {
+        /* EDUBBADRHO, and the path allocated for the result is released */
+        expect(dubins.shortest_path([0, 0, 0], [1, 0, 0], -1)).toBe(3);
+    })
     test('Sampling path', () => {
         let path = dubins.shortest_path([0, 0, 0], [4,4,3.142], 1);
         for (var i = 0, j=0; i < path.length; i += 0.1, j++) {
@@ -118,4 +128,150 @@ describe('Dubins JS Wrapper', () => {
             expect(rho).toBeCloseTo(trho, 6);
         }
     })
-})
\ No newline at end of file
+    test('Samples are copied out of the heap', () => {
+        let path = dubins.shortest_path([0, 0, 0], [4,4,3.142], 1);
+        let first = dubins.sample(path, 1.0);
+        let second = dubins.sample(path, 2.0);
+        expect(first[0]).toBeCloseTo(sampleMock[10][0], 6);
+        expect(second[0]).toBeCloseTo(sampleMock[20][0], 6);
+    })
+    test('Sampling path in bulk', () => {
+        let path = dubins.shortest_path([0, 0, 0], [4,4,3.142], 1);
+        let samples = dubins.sampleMany(path, 0.1);
+        expect(samples.length).toBe(3 * sampleMock.length);
+        for (let j = 0; j < sampleMock.length; j++) {
+            let [tx,ty,trho] = sampleMock[j];
+            expect(samples[3*j]).toBeCloseTo(tx, 6);
+            expect(samples[3*j+1]).toBeCloseTo(ty, 6);
+            expect(samples[3*j+2]).toBeCloseTo(trho, 6);
+        }
+
+        let into = new Float64Array(3 * 10);
+        let part = dubins.sampleMany(path, 0.1, into, 5);
+        expect(part.length).toBe(30);
+        expect(part[0]).toBeCloseTo(sampleMock[5][0], 6);
+        expect(dubins.sampleMany(path, 0).length).toBe(0);
+    })
+    test('Sampling in chunks matches one call', () => {
+        /* the length is an exact multiple of the step, so the last sample is the one at risk */
+        let path = dubins.shortest_path([0, 0, 0], [1, 0, 0], 1);
+        let whole = Float64Array.from(dubins.sampleMany(path, 0.1));
+        let chunks = [];
+        let chunk = new Float64Array(3 * 3);
+        for (let offset = 0; ; ) {
+            let part = dubins.sampleMany(path, 0.1, chunk, offset);
+            if (part.length === 0) break;
+            chunks.push(...part);
+            offset += part.length / 3;
+        }
+        expect(whole.length).toBe(3 * 10);
+        expect(chunks).toEqual(Array.from(whole));
+        path.release();
+    })
+    test('Path fields use the C layout', () => {
+        let path = dubins.shortest_path([1, 2, 0.5], [200, 200, Math.PI], 50);
+        expect(path.qi).toEqual([1, 2, 0.5]);
+        expect(path.rho).toBe(50);
+        expect(path.type).toBeGreaterThanOrEqual(0);
+        expect(path.type).toBeLessThanOrEqual(5);
+        let [p0, p1, p2] = path.param;
+        expect((p0 + p1 + p2) * 50).toBeCloseTo(path.length, 9);
+        path.release();
+    })
+    test('Path pool solves in bulk', () => {
+        let pool = new dubins.DubinsPathArray(8);
+        let starts = Float64Array.from([0, 0, 0, 1, 1, 1]);
+        let ends = Float64Array.from([4, 4, 3.142, 10, -3, 0]);
+        let errcodes = pool.shortest_path_many(starts, ends, 1);
+        expect(Array.from(errcodes)).toEqual([0, 0]);
+        expect(pool.count).toBe(2);
+
+        let single = dubins.shortest_path([1, 1, 1], [10, -3, 0], 1);
+        expect(pool.get(1).length).toBeCloseTo(single.length, 12);
+        expect(pool.get(1).type).toBe(single.type);
+        single.release();
+
+        pool.reset();
+        expect(pool.count).toBe(0);
+        expect(() => pool.get(0)).toThrow(RangeError);
+        expect(() => pool.shortest_path_many(new Float64Array(27), new Float64Array(27), 1)).toThrow(RangeError);
+        pool.release();
+    })
+    test('Batch and matrix wrappers', () => {
+        let starts = Float64Array.from([0, 0, 0, 1, 1, 1, 5, 5, 2]);
+        let ends = Float64Array.from([4, 4, 3.142, 10, -3, 0, -2, 7, 1]);
+        let batch = dubins.shortest_path_batch(starts, ends, 1.5);
+        let matrix = dubins.distance_matrix(starts, ends, 1.5);
+        expect(batch.length.length).toBe(3);
+        expect(matrix.length).toBe(9);
+        for (let i = 0; i < 3; i++) {
+            let single = dubins.shortest_path(Array.from(starts.subarray(3*i, 3*i+3)),
+                                              Array.from(ends.subarray(3*i, 3*i+3)), 1.5);
+            expect(batch.errcode[i]).toBe(0);
+            expect(batch.type[i]).toBe(single.type);
+            expect(batch.length[i]).toBeCloseTo(single.length, 9);
+            expect(matrix[4 * i]).toBeCloseTo(single.length, 9);
+            single.release();
+        }
+    })
+})
+
+describe('Dubins loader', () => {
+    test('Feature detection', () => {
+        expect(typeof loader.supportsSimd()).toBe('boolean');
+        expect(typeof loader.supportsThreads()).toBe('boolean');
+    })
+    test('Node runs the SIMD flavour', () => {
+        expect(loader.supportsSimd()).toBe(true);
+        expect(loader.supportsThreads()).toBe(true);
+    })
+})
+
+describe('Dubins async batches', () => {
+    const DubinsAsync = require('../src/dubins_async.js');
+    let pool = null;
+    let dubins = null;
+    beforeAll(() => {
+        pool = DubinsAsync.createPool({
+            workers: 2,
+            chunkSize: 2,
+            module: path.resolve(__dirname, '../dist/dubins.js'),
+            wasm: DubinsWASMFile,
+        });
+        return Dubins({
+            'ENVIRONMENT': 'NODE',
+            locateFile: (f) => {
+                return (f === 'dubins.wasm' && DubinsWASMFile);
+            }
+        }).then((module) => { dubins = module })
+    })
+    afterAll(() => pool.terminate())
+
+    test('Chunks match the synchronous batch', () => {
+        let starts = Float64Array.from([0, 0, 0, 1, 1, 1, 5, 5, 2, 3, -1, 4, 0, 2, 6]);
+        let ends = Float64Array.from([4, 4, 3.142, 10, -3, 0, -2, 7, 1, 8, 8, 0, -5, -5, 3]);
+        let chunks = [];
+        return pool.solveBatch(starts, ends, 1.5, { onChunk: (c) => chunks.push(c.begin) }).then((result) => {
+            let batch = dubins.shortest_path_batch(starts, ends, 1.5);
+            expect(chunks.sort()).toEqual([0, 2, 4]);
+            expect(Array.from(result.type)).toEqual(Array.from(batch.type));
+            expect(Array.from(result.errcode)).toEqual(Array.from(batch.errcode));
+            for (let i = 0; i < 5; i++) expect(result.length[i]).toBeCloseTo(batch.length[i], 12);
+            /* the inputs stay usable, only chunk copies are transferred */
+            expect(starts.length).toBe(15);
+        })
+    })
+    test('Mismatched inputs reject', () => {
+        return expect(pool.solveBatch(new Float64Array(6), new Float64Array(3), 1)).rejects.toThrow(RangeError);
+    })
+    test('Loads as a plain browser script', () => {
+        const fs = require('fs');
+        const vm = require('vm');
+        let context = { navigator: { hardwareConcurrency: 2 } };
+        context.self = context;
+        context.window = context;
+        vm.runInNewContext(fs.readFileSync(path.resolve(__dirname, '../src/dubins_async.js'), 'utf8'), context);
+        expect(typeof context.DubinsAsync.createPool).toBe('function');
+        expect(typeof context.DubinsAsync.solveBatch).toBe('function');
+    })
+})
@@ -0,0 +1,126 @@
+extern "C" {
+#include "dubins.h"
+#include "dubins_fixed.h"
+}
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+
+static double fromFixed(int32_t v)
+{
+    return v / 65536.0;
+}
+
+static double fromAngle(uint32_t theta)
+{
+    return theta * (2 * M_PI / 4294967296.0);
+}
+
+TEST(FixedTests, sincosMatchesLibm)
+{
+    double worst = 0;
+    for(uint64_t a = 0; a < (1ull << 32); a += 104729) {
+        int32_t s, c;
+        dubins_fixed_sincos((uint32_t)a, &s, &c);
+        double r = fromAngle((uint32_t)a);
+        worst = std::max(worst, fabs(s / 1073741824.0 - sin(r)));
+        worst = std::max(worst, fabs(c / 1073741824.0 - cos(r)));
+    }
+    EXPECT_LE(worst, ldexp(1.0, -25));
+}
+
+TEST(FixedTests, samplesWithinDocumentedBound)
+{
+    std::mt19937 gen(28);
+    const double rhos[] = { 0.01, 0.2, 1.5, 40.0 };
+    for(double rho : rhos) {
+        std::uniform_real_distribution<double> pos(-50 * rho, 50 * rho);
+        std::uniform_real_distribution<double> angle(-10.0, 10.0);
+        for(int i = 0; i < 300; i++) {
+            double q0[3] = { pos(gen), pos(gen), angle(gen) };
+            double q1[3] = { pos(gen), pos(gen), angle(gen) };
+            DubinsPath path;
+            DubinsFixedPath fixed;
+            ASSERT_EQ(dubins_shortest_path(&path, q0, q1, rho), EDUBOK);
+            ASSERT_EQ(dubins_path_to_fixed(&path, &fixed), EDUBOK);
+            int32_t length = dubins_fixed_path_length(&fixed);
+            EXPECT_NEAR(fromFixed(length), dubins_path_length(&path), 1.0 / 65536);
+            for(int k = 0; k <= 64; k++) {
+                int32_t t = (int32_t)((int64_t)length * k / 64);
+                double s = std::min(fromFixed(t), dubins_path_length(&path));
+                DubinsFixedConfig q;
+                double expect[3];
+                ASSERT_EQ(dubins_fixed_path_sample(&fixed, t, &q), EDUBOK);
+                ASSERT_EQ(dubins_path_sample(&path, s, expect), EDUBOK);
+                double bound = 4.0 / 65536 + ldexp(rho + s, -24);
+                EXPECT_NEAR(fromFixed(q.x), expect[0], bound);
+                EXPECT_NEAR(fromFixed(q.y), expect[1], bound);
+                EXPECT_NEAR(remainder(fromAngle(q.theta) - expect[2], 2 * M_PI), 0.0,
+                            1.0 / 65536 / rho + ldexp(1.0, -26));
+            }
+        }
+    }
+}
+
+TEST(FixedTests, sampleIntoMatchesSample)
+{
+    double q0[3] = { 3.0, -2.0, 0.4 };
+    double q1[3] = { -6.0, 9.0, 2.8 };
+    DubinsPath path;
+    DubinsFixedPath fixed;
+    ASSERT_EQ(dubins_shortest_path(&path, q0, q1, 2.0), EDUBOK);
+    ASSERT_EQ(dubins_path_to_fixed(&path, &fixed), EDUBOK);
+
+    int32_t step = 65536 / 10;
+    size_t total = ((size_t)dubins_fixed_path_length(&fixed) + step - 1) / step;
+    std::vector<DubinsFixedConfig> all(total + 4);
+    ASSERT_EQ(dubins_fixed_path_sample_into(&fixed, step, all.data(), all.size(), 0), total);
+
+    /* in pieces */
+    std::vector<DubinsFixedConfig> piece(7);
+    size_t offset = 0;
+    size_t n;
+    while((n = dubins_fixed_path_sample_into(&fixed, step, piece.data(), piece.size(), offset)) > 0) {
+        for(size_t i = 0; i < n; i++) {
+            DubinsFixedConfig q;
+            ASSERT_EQ(dubins_fixed_path_sample(&fixed, (int32_t)((offset + i) * step), &q), EDUBOK);
+            EXPECT_EQ(piece[i].x, all[offset + i].x);
+            EXPECT_EQ(piece[i].y, q.y);
+            EXPECT_EQ(piece[i].theta, q.theta);
+        }
+        offset += n;
+    }
+    EXPECT_EQ(offset, total);
+    EXPECT_EQ(dubins_fixed_path_sample_into(&fixed, 0, all.data(), all.size(), 0), 0u);
+}
+
+TEST(FixedTests, rejectsOutOfRange)
+{
+    double q0[3] = { 0.0, 0.0, 0.0 };
+    double q1[3] = { 10.0, 0.0, 0.0 };
+    DubinsPath path;
+    DubinsFixedPath fixed;
+    DubinsFixedConfig q;
+    ASSERT_EQ(dubins_shortest_path(&path, q0, q1, 1.0), EDUBOK);
+    ASSERT_EQ(dubins_path_to_fixed(&path, &fixed), EDUBOK);
+    EXPECT_EQ(dubins_fixed_path_sample(&fixed, -1, &q), EDUBPARAM);
+    EXPECT_EQ(dubins_fixed_path_sample(&fixed, dubins_fixed_path_length(&fixed) + 1, &q), EDUBPARAM);
+    ASSERT_EQ(dubins_fixed_path_sample(&fixed, dubins_fixed_path_length(&fixed), &q), EDUBOK);
+    EXPECT_NEAR(fromFixed(q.x), 10.0, 4.0 / 65536);
+
+    DubinsPath far = path;
+    far.qi[0] = 32760.0;
+    EXPECT_EQ(dubins_path_to_fixed(&far, &fixed), EDUBPARAM);
+    DubinsPath tiny = path;
+    tiny.rho = 1e-6;
+    EXPECT_EQ(dubins_path_to_fixed(&tiny, &fixed), EDUBPARAM);
+    DubinsPath bad = path;
+    bad.qi[2] = NAN;
+    EXPECT_EQ(dubins_path_to_fixed(&bad, &fixed), EDUBPARAM);
+}
@@ -0,0 +1,132 @@
+extern "C" {
+#include "dubins.h"
+}
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "random_configs.h"
+
+class HeadingTests : public ::testing::Test
+{
+public:
+    void SetUp()
+    {
+        RandomConfigs configs(99, 6.0);
+        for(int i = 0; i < 200; i++) {
+            Query query;
+            configs.next(query.q0);
+            query.x1 = configs.position();
+            query.y1 = configs.position();
+            queries.push_back(query);
+        }
+        for(int i = 0; i < 360; i++) {
+            headings.push_back(i * M_PI / 180);
+        }
+    }
+
+protected:
+    struct Query
+    {
+        double q0[3];
+        double x1;
+        double y1;
+    };
+    std::vector<Query> queries;
+    std::vector<double> headings;
+};
+
+TEST_F(HeadingTests, matchesBruteForce)
+{
+    for(auto& query : queries) {
+        double best = INFINITY;
+        size_t best_i = 0;
+        DubinsPath expected;
+        for(size_t i = 0; i < headings.size(); i++) {
+            double q1[3] = { query.x1, query.y1, headings[i] };
+            DubinsPath path;
+            ASSERT_EQ(dubins_shortest_path(&path, query.q0, q1, 1.5), EDUBOK);
+            if(dubins_path_length(&path) < best) {
+                best = dubins_path_length(&path);
+                best_i = i;
+                expected = path;
+            }
+        }
+
+        DubinsPath path;
+        size_t index;
+        ASSERT_EQ(dubins_shortest_path_headings(&path, query.q0, query.x1, query.y1,
+                                                headings.data(), headings.size(), 1.5, &index), EDUBOK);
+        ASSERT_NEAR(dubins_path_length(&path), best, 1e-9);
+        if(index != best_i) {
+            // only a tie between headings may pick a different one
+            double q1[3] = { query.x1, query.y1, headings[index] };
+            DubinsPath other;
+            ASSERT_EQ(dubins_shortest_path(&other, query.q0, q1, 1.5), EDUBOK);
+            ASSERT_NEAR(dubins_path_length(&other), best, 1e-9);
+        }
+        else {
+            ASSERT_EQ(path.type, expected.type);
+        }
+        ASSERT_EQ(path.qi[2], query.q0[2]);
+        ASSERT_EQ(path.rho, 1.5);
+
+        double q[3];
+        ASSERT_EQ(dubins_path_endpoint(&path, q), EDUBOK);
+        ASSERT_NEAR(q[0], query.x1, 1e-6);
+        ASSERT_NEAR(q[1], query.y1, 1e-6);
+    }
+}
+
+TEST_F(HeadingTests, range)
+{
+    for(auto& query : queries) {
+        DubinsPath from_set, from_range;
+        size_t index;
+        double heading;
+        ASSERT_EQ(dubins_shortest_path_headings(&from_set, query.q0, query.x1, query.y1,
+                                                headings.data(), 181, 1.0, &index), EDUBOK);
+        ASSERT_EQ(dubins_shortest_path_heading_range(&from_range, query.q0, query.x1, query.y1,
+                                                     0.0, M_PI, 181, 1.0, &heading), EDUBOK);
+        ASSERT_NEAR(dubins_path_length(&from_range), dubins_path_length(&from_set), 1e-9);
+        double q1[3] = { query.x1, query.y1, heading };
+        DubinsPath check;
+        ASSERT_EQ(dubins_shortest_path(&check, query.q0, q1, 1.0), EDUBOK);
+        ASSERT_NEAR(dubins_path_length(&check), dubins_path_length(&from_range), 1e-9);
+    }
+}
+
+TEST_F(HeadingTests, freeHeadingIsOptimal)
+{
+    std::vector<double> dense;
+    for(int i = 0; i < 3600; i++) {
+        dense.push_back(i * M_PI / 1800);
+    }
+    for(auto& query : queries) {
+        DubinsPath sampled, analytic;
+        ASSERT_EQ(dubins_shortest_path_headings(&sampled, query.q0, query.x1, query.y1,
+                                                dense.data(), dense.size(), 1.0, NULL), EDUBOK);
+        ASSERT_EQ(dubins_shortest_path_free_heading(&analytic, query.q0, query.x1, query.y1, 1.0), EDUBOK);
+        double len = dubins_path_length(&analytic);
+        ASSERT_LE(len, dubins_path_length(&sampled) + 1e-9);
+        ASSERT_GE(len, dubins_path_length(&sampled) - 2e-3);
+
+        double q[3];
+        ASSERT_EQ(dubins_path_sample(&analytic, len, q), EDUBOK);
+        ASSERT_NEAR(q[0], query.x1, 1e-9);
+        ASSERT_NEAR(q[1], query.y1, 1e-9);
+    }
+}
+
+TEST_F(HeadingTests, errors)
+{
+    DubinsPath path;
+    double q0[3] = { 0, 0, 0 };
+    ASSERT_EQ(dubins_shortest_path_headings(&path, q0, 1, 1, headings.data(), 0, 1.0, NULL), EDUBPARAM);
+    ASSERT_EQ(dubins_shortest_path_headings(&path, q0, 1, 1, headings.data(), 10, -1.0, NULL), EDUBBADRHO);
+    ASSERT_EQ(dubins_shortest_path_heading_range(&path, q0, 1, 1, 0, 1, 0, 1.0, NULL), EDUBPARAM);
+    ASSERT_EQ(dubins_shortest_path_free_heading(&path, q0, 1, 1, 0.0), EDUBBADRHO);
+}
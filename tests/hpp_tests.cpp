@@ -0,0 +1,129 @@
+#include "dubins.hpp"
+
+#include "gtest/gtest.h"
+#include "random_configs.h"
+
+static_assert(dubins::word_traits<LSR>::third == dubins::segment::right, "segment table");
+static_assert(dubins::word_traits<RLR>::ccc && !dubins::word_traits<RSL>::ccc, "word classes");
+static_assert(dubins::fixed_radius<double, 1, 4>::inverse == 4.0, "folded inverse");
+
+class HppTests : public ::testing::Test
+{
+public:
+    void SetUp()
+    {
+        pairs = RandomConfigs(1234, 10.0, -7.0, 7.0).pairs(500);
+    }
+
+protected:
+    std::vector<ConfigPair> pairs;
+};
+
+static void expectSamePath(const DubinsPath& expected, const dubins::path<double>& actual)
+{
+    EXPECT_EQ(expected.type, actual.type);
+    for(int i = 0; i < 3; i++) {
+        EXPECT_EQ(expected.qi[i], actual.qi[i]);
+        EXPECT_EQ(expected.param[i], actual.param[i]);
+    }
+    EXPECT_EQ(expected.rho, actual.rho);
+}
+
+TEST_F(HppTests, shortestPathMatchesC)
+{
+    for(auto& p : pairs) {
+        DubinsPath expected;
+        dubins::path<double> actual;
+        ASSERT_EQ(dubins_shortest_path(&expected, p.q0, p.q1, 1.5), EDUBOK);
+        ASSERT_EQ(dubins::shortest_path(actual, p.q0, p.q1, 1.5), EDUBOK);
+        expectSamePath(expected, actual);
+        EXPECT_EQ(dubins_path_length(&expected), actual.length());
+    }
+}
+
+template <DubinsPathType W>
+static void checkWord(const double q0[3], const double q1[3], double rho)
+{
+    DubinsPath expected;
+    dubins::path<double> actual;
+    int err = dubins_path(&expected, const_cast<double*>(q0), const_cast<double*>(q1), rho, W);
+    ASSERT_EQ(dubins::solve<W>(actual, q0, q1, rho), err);
+    if(err == EDUBOK) {
+        expectSamePath(expected, actual);
+    }
+}
+
+TEST_F(HppTests, wordsMatchC)
+{
+    for(auto& p : pairs) {
+        checkWord<LSL>(p.q0, p.q1, 0.75);
+        checkWord<LSR>(p.q0, p.q1, 0.75);
+        checkWord<RSL>(p.q0, p.q1, 0.75);
+        checkWord<RSR>(p.q0, p.q1, 0.75);
+        checkWord<RLR>(p.q0, p.q1, 0.75);
+        checkWord<LRL>(p.q0, p.q1, 0.75);
+    }
+}
+
+TEST_F(HppTests, sampleMatchesC)
+{
+    for(auto& p : pairs) {
+        DubinsPath c;
+        ASSERT_EQ(dubins_shortest_path(&c, p.q0, p.q1, 2.0), EDUBOK);
+        dubins::path<double> cpp = dubins::from_c(c);
+        double length = dubins_path_length(&c);
+        for(int i = 0; i <= 16; i++) {
+            double t = length * i / 16;
+            double expected[3], actual[3];
+            ASSERT_EQ(dubins_path_sample(&c, t, expected), EDUBOK);
+            ASSERT_EQ(dubins::sample(cpp, t, actual), EDUBOK);
+            EXPECT_EQ(expected[0], actual[0]);
+            EXPECT_EQ(expected[1], actual[1]);
+            EXPECT_EQ(expected[2], actual[2]);
+        }
+        double q[3];
+        EXPECT_EQ(dubins::sample(cpp, length * 1.01, q), EDUBPARAM);
+    }
+}
+
+TEST_F(HppTests, fixedRadiusMatchesC)
+{
+    /* a power of two radius, so the folded inverse is exact */
+    dubins::fixed_radius<double, 1, 2> radius;
+    for(auto& p : pairs) {
+        DubinsPath expected;
+        dubins::path<double> actual;
+        ASSERT_EQ(dubins_shortest_path(&expected, p.q0, p.q1, 0.5), EDUBOK);
+        ASSERT_EQ(dubins::shortest_path(actual, p.q0, p.q1, radius), EDUBOK);
+        expectSamePath(expected, actual);
+
+        double t = actual.length() / 3;
+        double qc[3], qf[3];
+        ASSERT_EQ(dubins_path_sample(&expected, t, qc), EDUBOK);
+        ASSERT_EQ(dubins::sample(actual, t, qf, radius), EDUBOK);
+        EXPECT_EQ(qc[0], qf[0]);
+        EXPECT_EQ(qc[1], qf[1]);
+    }
+}
+
+TEST_F(HppTests, floatCloseToDouble)
+{
+    for(auto& p : pairs) {
+        float q0[3] = { (float)p.q0[0], (float)p.q0[1], (float)p.q0[2] };
+        float q1[3] = { (float)p.q1[0], (float)p.q1[1], (float)p.q1[2] };
+        dubins::path<float> f;
+        dubins::path<double> d;
+        ASSERT_EQ(dubins::shortest_path(f, q0, q1, 1.0f), EDUBOK);
+        ASSERT_EQ(dubins::shortest_path(d, p.q0, p.q1, 1.0), EDUBOK);
+        EXPECT_NEAR(f.length(), d.length(), 1e-3 * (1 + d.length()));
+    }
+}
+
+TEST(HppErrors, invalidRadius)
+{
+    double q0[3] = { 0, 0, 0 };
+    double q1[3] = { 1, 0, 0 };
+    dubins::path<double> p;
+    EXPECT_EQ(dubins::shortest_path(p, q0, q1, -1.0), EDUBBADRHO);
+    EXPECT_EQ(dubins::solve<LSL>(p, q0, q1, 0.0), EDUBBADRHO);
+}
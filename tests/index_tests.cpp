@@ -0,0 +1,204 @@
+extern "C" {
+#include "dubins_index.h"
+}
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "gtest/gtest.h"
+#include "random_configs.h"
+
+class IndexTests : public ::testing::Test
+{
+public:
+    void SetUp()
+    {
+        RandomConfigs random(23, 20.0);
+        configs.resize(600);
+        for(size_t i = 0; i < configs.size(); i++) {
+            random.next(configs[i].q);
+        }
+        queries.resize(50);
+        for(size_t i = 0; i < queries.size(); i++) {
+            random.next(queries[i].q);
+        }
+        index = dubins_index_create(rho, 0.0);
+        ASSERT_NE(index, nullptr);
+    }
+
+    void TearDown()
+    {
+        dubins_index_destroy(index);
+    }
+
+    /* (length, id) of every configuration in the first n, sorted */
+    std::vector<std::pair<double, size_t>> bruteForce(double q[3], DubinsIndexDirection direction, size_t n)
+    {
+        std::vector<std::pair<double, size_t>> all;
+        for(size_t i = 0; i < n; i++) {
+            double length;
+            if(direction == DUBINS_INDEX_FROM_QUERY) {
+                EXPECT_EQ(dubins_shortest_length(&length, q, configs[i].q, rho), EDUBOK);
+            }
+            else {
+                EXPECT_EQ(dubins_shortest_length(&length, configs[i].q, q, rho), EDUBOK);
+            }
+            all.push_back(std::make_pair(length, i));
+        }
+        std::sort(all.begin(), all.end());
+        return all;
+    }
+
+protected:
+    struct Config
+    {
+        double q[3];
+    };
+    const double rho = 1.5;
+    std::vector<Config> configs;
+    std::vector<Config> queries;
+    DubinsIndex* index;
+};
+
+TEST_F(IndexTests, rejectsBadParameters)
+{
+    EXPECT_EQ(dubins_index_create(0.0, 1.0), nullptr);
+    EXPECT_EQ(dubins_index_create(1.0, -1.0), nullptr);
+    double bad[3] = { NAN, 0.0, 0.0 };
+    EXPECT_EQ(dubins_index_insert(index, bad, nullptr), EDUBPARAM);
+    EXPECT_EQ(dubins_index_size(index), 0u);
+    EXPECT_EQ(dubins_index_config(index, 0), nullptr);
+}
+
+TEST_F(IndexTests, emptyIndex)
+{
+    size_t ids[4], n_found = 99;
+    double lengths[4];
+    EXPECT_EQ(dubins_index_knn(index, queries[0].q, DUBINS_INDEX_FROM_QUERY, 4, ids, lengths, &n_found), EDUBOK);
+    EXPECT_EQ(n_found, 0u);
+    EXPECT_EQ(dubins_index_radius(index, queries[0].q, DUBINS_INDEX_FROM_QUERY, 100.0, ids, lengths, 4, &n_found), EDUBOK);
+    EXPECT_EQ(n_found, 0u);
+}
+
+TEST_F(IndexTests, insertNumbersConfigurations)
+{
+    for(size_t i = 0; i < configs.size(); i++) {
+        size_t id;
+        ASSERT_EQ(dubins_index_insert(index, configs[i].q, &id), EDUBOK);
+        EXPECT_EQ(id, i);
+    }
+    EXPECT_EQ(dubins_index_size(index), configs.size());
+    for(size_t i = 0; i < configs.size(); i++) {
+        const double* q = dubins_index_config(index, i);
+        ASSERT_NE(q, nullptr);
+        EXPECT_EQ(q[0], configs[i].q[0]);
+        EXPECT_EQ(q[1], configs[i].q[1]);
+        EXPECT_EQ(q[2], configs[i].q[2]);
+    }
+}
+
+TEST_F(IndexTests, knnMatchesBruteForceWhileGrowing)
+{
+    const size_t k = 7;
+    size_t inserted = 0;
+    for(size_t step : { 1, 5, 30, 200, 600 }) {
+        for(; inserted < step; inserted++) {
+            ASSERT_EQ(dubins_index_insert(index, configs[inserted].q, nullptr), EDUBOK);
+        }
+        for(auto& query : queries) {
+            for(DubinsIndexDirection direction : { DUBINS_INDEX_FROM_QUERY, DUBINS_INDEX_TO_QUERY }) {
+                auto expected = bruteForce(query.q, direction, inserted);
+                size_t ids[k], n_found;
+                double lengths[k];
+                ASSERT_EQ(dubins_index_knn(index, query.q, direction, k, ids, lengths, &n_found), EDUBOK);
+                ASSERT_EQ(n_found, std::min(k, inserted));
+                for(size_t i = 0; i < n_found; i++) {
+                    EXPECT_EQ(ids[i], expected[i].second);
+                    EXPECT_EQ(lengths[i], expected[i].first);
+                }
+            }
+        }
+    }
+}
+
+TEST_F(IndexTests, radiusMatchesBruteForce)
+{
+    for(auto& config : configs) {
+        ASSERT_EQ(dubins_index_insert(index, config.q, nullptr), EDUBOK);
+    }
+    std::vector<size_t> ids(configs.size());
+    std::vector<double> lengths(configs.size());
+    for(auto& query : queries) {
+        for(double radius : { 0.0, 5.0, 12.0, 30.0 }) {
+            auto expected = bruteForce(query.q, DUBINS_INDEX_TO_QUERY, configs.size());
+            std::vector<std::pair<double, size_t>> within;
+            for(auto& e : expected) {
+                if(e.first <= radius) {
+                    within.push_back(e);
+                }
+            }
+
+            size_t n_found;
+            ASSERT_EQ(dubins_index_radius(index, query.q, DUBINS_INDEX_TO_QUERY, radius,
+                                          ids.data(), lengths.data(), ids.size(), &n_found), EDUBOK);
+            ASSERT_EQ(n_found, within.size());
+            std::vector<std::pair<double, size_t>> found;
+            for(size_t i = 0; i < n_found; i++) {
+                found.push_back(std::make_pair(lengths[i], ids[i]));
+            }
+            std::sort(found.begin(), found.end());
+            EXPECT_EQ(found, within);
+
+            /* without lengths, the bounds alone may accept some matches */
+            ASSERT_EQ(dubins_index_radius(index, query.q, DUBINS_INDEX_TO_QUERY, radius,
+                                          ids.data(), nullptr, ids.size(), &n_found), EDUBOK);
+            ASSERT_EQ(n_found, within.size());
+            std::vector<size_t> found_ids(ids.begin(), ids.begin() + n_found);
+            std::vector<size_t> within_ids;
+            for(auto& e : within) {
+                within_ids.push_back(e.second);
+            }
+            std::sort(found_ids.begin(), found_ids.end());
+            std::sort(within_ids.begin(), within_ids.end());
+            EXPECT_EQ(found_ids, within_ids);
+        }
+    }
+}
+
+TEST_F(IndexTests, radiusCountsBeyondCapacity)
+{
+    for(auto& config : configs) {
+        ASSERT_EQ(dubins_index_insert(index, config.q, nullptr), EDUBOK);
+    }
+    size_t ids[3], n_found;
+    double lengths[3];
+    ASSERT_EQ(dubins_index_radius(index, queries[0].q, DUBINS_INDEX_FROM_QUERY, 1000.0,
+                                  ids, lengths, 3, &n_found), EDUBOK);
+    EXPECT_EQ(n_found, configs.size());
+}
+
+TEST_F(IndexTests, distantOutliers)
+{
+    DubinsIndex* small = dubins_index_create(rho, 0.5);
+    ASSERT_NE(small, nullptr);
+    double a[3] = { 0.0, 0.0, 0.0 };
+    double b[3] = { 1e6, -1e6, 1.0 };
+    double c[3] = { 3.0, 0.0, M_PI };
+    ASSERT_EQ(dubins_index_insert(small, a, nullptr), EDUBOK);
+    ASSERT_EQ(dubins_index_insert(small, b, nullptr), EDUBOK);
+    ASSERT_EQ(dubins_index_insert(small, c, nullptr), EDUBOK);
+
+    double q[3] = { 1e6 + 1.0, -1e6, 0.0 };
+    size_t ids[3], n_found;
+    double lengths[3];
+    ASSERT_EQ(dubins_index_knn(small, q, DUBINS_INDEX_FROM_QUERY, 3, ids, lengths, &n_found), EDUBOK);
+    ASSERT_EQ(n_found, 3u);
+    EXPECT_EQ(ids[0], 1u);
+    EXPECT_LE(lengths[0], lengths[1]);
+    EXPECT_LE(lengths[1], lengths[2]);
+    dubins_index_destroy(small);
+}
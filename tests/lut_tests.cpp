@@ -0,0 +1,191 @@
+extern "C" {
+#include "dubins_lut.h"
+}
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gtest/gtest.h"
+
+class LutTests : public ::testing::Test
+{
+public:
+    void SetUp()
+    {
+        srand(4321);
+        ASSERT_EQ(dubins_lut_build(&lut, 32, 32, 24, 8.0), EDUBOK);
+    }
+
+    void TearDown()
+    {
+        dubins_lut_free(&lut);
+    }
+
+    double uniform(double lo, double hi)
+    {
+        return lo + (hi - lo) * (rand() / (double)RAND_MAX);
+    }
+
+protected:
+    DubinsLut lut;
+};
+
+TEST_F(LutTests, estimateWithinVertexError)
+{
+    /* at the vertices the only error is the float rounding of the residual */
+    for(unsigned ia = 0; ia < lut.n_alpha; ia += 5) {
+        for(unsigned id = 0; id < lut.n_d; id += 3) {
+            double d = id * lut.d_max / (lut.n_d - 1);
+            double q0[3] = { 0, 0, ia * 2 * M_PI / lut.n_alpha };
+            double q1[3] = { d, 0, 0 };
+            double estimate, exact;
+            ASSERT_EQ(dubins_lut_estimate(&lut, &estimate, NULL, NULL, q0, q1, 1.0), EDUBOK);
+            ASSERT_EQ(dubins_shortest_length(&exact, q0, q1, 1.0), EDUBOK);
+            ASSERT_NEAR(estimate, exact, 1e-5);
+        }
+    }
+}
+
+TEST_F(LutTests, errorBoundIsReported)
+{
+    ASSERT_GT(lut.max_error, 0.0);
+    for(int i = 0; i < 1000; i++) {
+        double rho = uniform(0.5, 2.0);
+        double q0[3] = { uniform(-5, 5), uniform(-5, 5), uniform(-M_PI, M_PI) };
+        double q1[3] = { uniform(-5, 5), uniform(-5, 5), uniform(-M_PI, M_PI) };
+        double estimate, error;
+        DubinsPathType type;
+        ASSERT_EQ(dubins_lut_estimate(&lut, &estimate, &error, &type, q0, q1, rho), EDUBOK);
+        ASSERT_GE(error, 0.0);
+        ASSERT_LE(error, lut.max_error * rho * (1 + 1e-5) + 1e-6);
+        ASSERT_GE(type, LSL);
+        ASSERT_LE(type, LRL);
+        ASSERT_GT(estimate, 0.0);
+    }
+}
+
+TEST_F(LutTests, estimateWithinReportedError)
+{
+    for(int i = 0; i < 20000; i++) {
+        double rho = uniform(0.5, 2.0);
+        double q0[3] = { uniform(-5, 5), uniform(-5, 5), uniform(-M_PI, M_PI) };
+        double q1[3] = { uniform(-5, 5), uniform(-5, 5), uniform(-M_PI, M_PI) };
+        double estimate, error, exact;
+        ASSERT_EQ(dubins_lut_estimate(&lut, &estimate, &error, NULL, q0, q1, rho), EDUBOK);
+        ASSERT_EQ(dubins_shortest_length(&exact, q0, q1, rho), EDUBOK);
+        ASSERT_LE(fabs(estimate - exact), error + 1e-9);
+    }
+}
+
+TEST_F(LutTests, wordChangeCellsAreExact)
+{
+    /* some cells must straddle a change of word, query the centre of each */
+    int found = 0;
+    for(unsigned ia = 0; ia < lut.n_alpha; ia++) {
+        for(unsigned ib = 0; ib < lut.n_beta; ib += 7) {
+            for(unsigned id = 0; id + 1 < lut.n_d; id += 5) {
+                if(lut.cell_error[(ia * lut.n_beta + ib) * (lut.n_d - 1) + id] < INFINITY) {
+                    continue;
+                }
+                double q0[3] = { 0, 0, (ia + 0.5) * 2 * M_PI / lut.n_alpha };
+                double q1[3] = { (id + 0.5) * lut.d_max / (lut.n_d - 1), 0, (ib + 0.5) * 2 * M_PI / lut.n_beta };
+                double estimate, error;
+                DubinsPathType type;
+                DubinsPath path;
+                ASSERT_EQ(dubins_lut_estimate(&lut, &estimate, &error, &type, q0, q1, 1.0), EDUBOK);
+                ASSERT_EQ(dubins_shortest_path(&path, q0, q1, 1.0), EDUBOK);
+                ASSERT_DOUBLE_EQ(estimate, dubins_path_length(&path));
+                ASSERT_EQ(error, 0.0);
+                ASSERT_EQ(type, path.type);
+                found++;
+            }
+        }
+    }
+    ASSERT_GT(found, 0);
+}
+
+TEST_F(LutTests, beyondGridIsExact)
+{
+    double q0[3] = { 0, 0, 0.3 };
+    double q1[3] = { 20, 4, 1.2 };
+    double estimate, error, exact;
+    DubinsPathType type;
+    DubinsPath path;
+    ASSERT_EQ(dubins_lut_estimate(&lut, &estimate, &error, &type, q0, q1, 1.0), EDUBOK);
+    ASSERT_EQ(dubins_shortest_path(&path, q0, q1, 1.0), EDUBOK);
+    exact = dubins_path_length(&path);
+    ASSERT_DOUBLE_EQ(estimate, exact);
+    ASSERT_EQ(error, 0.0);
+    ASSERT_EQ(type, path.type);
+}
+
+TEST_F(LutTests, saveAndMap)
+{
+    const char* filename = "lut_tests.bin";
+    DubinsLut mapped;
+    ASSERT_EQ(dubins_lut_save(&lut, filename), EDUBOK);
+    ASSERT_EQ(dubins_lut_map(&mapped, filename), EDUBOK);
+    ASSERT_EQ(mapped.n_alpha, lut.n_alpha);
+    ASSERT_EQ(mapped.n_d, lut.n_d);
+    ASSERT_EQ(mapped.max_error, lut.max_error);
+    ASSERT_EQ((size_t)mapped.residual % 64, (size_t)0);
+    for(int i = 0; i < 100; i++) {
+        double q0[3] = { uniform(-5, 5), uniform(-5, 5), uniform(-M_PI, M_PI) };
+        double q1[3] = { uniform(-5, 5), uniform(-5, 5), uniform(-M_PI, M_PI) };
+        double a, b;
+        ASSERT_EQ(dubins_lut_estimate(&lut, &a, NULL, NULL, q0, q1, 1.0), EDUBOK);
+        ASSERT_EQ(dubins_lut_estimate(&mapped, &b, NULL, NULL, q0, q1, 1.0), EDUBOK);
+        ASSERT_EQ(a, b);
+    }
+    dubins_lut_free(&mapped);
+    remove(filename);
+}
+
+TEST_F(LutTests, rejectsOverflowingDimensions)
+{
+    /* 2^31 x 2^31 x 4 vertices wrap the unchecked counts to zero, and every offset to 128 */
+    const char* filename = "lut_tests_overflow.bin";
+    DubinsLut other;
+    char header[128];
+    uint32_t dims[3] = { 1u << 31, 1u << 31, 4 };
+    uint64_t offsets[4] = { 128, 128, 128, 128 };
+    ASSERT_EQ(dubins_lut_save(&lut, filename), EDUBOK);
+    FILE* fp = fopen(filename, "rb");
+    ASSERT_EQ(fread(header, 1, sizeof(header), fp), sizeof(header));
+    fclose(fp);
+    memcpy(header + 16, dims, sizeof(dims));
+    memcpy(header + 48, offsets, sizeof(offsets));
+    fp = fopen(filename, "wb");
+    fwrite(header, 1, sizeof(header), fp);
+    fclose(fp);
+    ASSERT_EQ(dubins_lut_map(&other, filename), EDUBFORMAT);
+    remove(filename);
+
+    ASSERT_EQ(dubins_lut_build(&other, 1u << 31, 1u << 31, 4, 4.0), EDUBNOMEM);
+}
+
+TEST_F(LutTests, invalidInputs)
+{
+    DubinsLut other;
+    double q0[3] = { 0, 0, 0 };
+    double q1[3] = { 1, 0, 0 };
+    double estimate;
+    ASSERT_EQ(dubins_lut_build(&other, 0, 8, 8, 4.0), EDUBPARAM);
+    ASSERT_EQ(dubins_lut_build(&other, 8, 8, 1, 4.0), EDUBPARAM);
+    ASSERT_EQ(dubins_lut_build(&other, 8, 8, 8, -1.0), EDUBPARAM);
+    ASSERT_EQ(dubins_lut_estimate(&lut, &estimate, NULL, NULL, q0, q1, -1.0), EDUBBADRHO);
+    ASSERT_EQ(dubins_lut_map(&other, "lut_tests_missing.bin"), EDUBIO);
+
+    const char* filename = "lut_tests_bad.bin";
+    FILE* fp = fopen(filename, "wb");
+    ASSERT_TRUE(fp != NULL);
+    fputs("definitely not a lookup table, but long enough to hold a header.....", fp);
+    fputs("definitely not a lookup table, but long enough to hold a header.....", fp);
+    fclose(fp);
+    ASSERT_EQ(dubins_lut_map(&other, filename), EDUBFORMAT);
+    remove(filename);
+}
@@ -0,0 +1,126 @@
+extern "C" {
+#include "dubins.h"
+}
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+#include "gtest/gtest.h"
+
+class MatrixTests : public ::testing::Test
+{
+public:
+    void SetUp()
+    {
+        srand(2468);
+        configure(from, fx, fy, fth, 37);
+        configure(to, tx, ty, tth, 150);
+    }
+
+    double uniform(double lo, double hi)
+    {
+        return lo + (hi - lo) * (rand() / (double)RAND_MAX);
+    }
+
+    void configure(DubinsConfigSet& set, std::vector<double>& x, std::vector<double>& y,
+                   std::vector<double>& th, size_t n)
+    {
+        x.resize(n); y.resize(n); th.resize(n);
+        for(size_t i = 0; i < n; i++) {
+            x[i]  = uniform(-10.0, 10.0);
+            y[i]  = uniform(-10.0, 10.0);
+            th[i] = uniform(-M_PI, M_PI);
+        }
+        set.x = &x[0]; set.y = &y[0]; set.th = &th[0];
+    }
+
+    void configure_outputs(size_t n)
+    {
+        length.assign(n, 0.0);
+        type.assign(n, LSL);
+        errcode.assign(n, -1);
+        for(int j = 0; j < 3; j++) {
+            param[j].assign(n, 0.0);
+            out.param[j] = &param[j][0];
+        }
+        out.length = &length[0];
+        out.type = &type[0];
+        out.errcode = &errcode[0];
+    }
+
+protected:
+    std::vector<double> fx, fy, fth, tx, ty, tth;
+    std::vector<double> length, param[3];
+    std::vector<DubinsPathType> type;
+    std::vector<int> errcode;
+    DubinsConfigSet from, to;
+    DubinsBatchOutput out;
+};
+
+TEST_F(MatrixTests, matchesShortestPath)
+{
+    size_t n_from = fx.size(), n_to = tx.size();
+    double rho = 1.5;
+    configure_outputs(n_from * n_to);
+    ASSERT_EQ(dubins_distance_matrix(&from, n_from, &to, n_to, rho, &out), EDUBOK);
+
+    for(size_t i = 0; i < n_from; i++) {
+        for(size_t j = 0; j < n_to; j++) {
+            size_t k = i * n_to + j;
+            double q0[3] = { fx[i], fy[i], fth[i] };
+            double q1[3] = { tx[j], ty[j], tth[j] };
+            DubinsPath path;
+            ASSERT_EQ(dubins_shortest_path(&path, q0, q1, rho), EDUBOK);
+            ASSERT_EQ(errcode[k], EDUBOK);
+            ASSERT_NEAR(dubins_path_length(&path), length[k], 1e-9);
+            ASSERT_NEAR((param[0][k] + param[1][k] + param[2][k]) * rho, length[k], 1e-9);
+        }
+    }
+}
+
+TEST_F(MatrixTests, rowRangesMatchWholeMatrix)
+{
+    size_t n_from = fx.size(), n_to = tx.size();
+    configure_outputs(n_from * n_to);
+    ASSERT_EQ(dubins_distance_matrix(&from, n_from, &to, n_to, 2.0, &out), EDUBOK);
+    std::vector<double> whole = length;
+
+    length.assign(n_from * n_to, 0.0);
+    ASSERT_EQ(dubins_distance_matrix_rows(&from, &to, n_to, 2.0, &out, 20, n_from), EDUBOK);
+    ASSERT_EQ(dubins_distance_matrix_rows(&from, &to, n_to, 2.0, &out, 0, 20), EDUBOK);
+    for(size_t k = 0; k < whole.size(); k++) {
+        ASSERT_EQ(whole[k], length[k]);
+    }
+}
+
+TEST_F(MatrixTests, coincidentConfigurations)
+{
+    configure_outputs(1);
+    ASSERT_EQ(dubins_distance_matrix(&from, 1, &from, 1, 1.0, &out), EDUBOK);
+    ASSERT_NEAR(length[0], 0.0, 1e-9);
+}
+
+TEST_F(MatrixTests, invalidTurningRadius)
+{
+    size_t n_from = fx.size(), n_to = tx.size();
+    configure_outputs(n_from * n_to);
+    ASSERT_EQ(dubins_distance_matrix(&from, n_from, &to, n_to, -1.0, &out), EDUBBADRHO);
+    ASSERT_EQ(errcode[0], EDUBBADRHO);
+    ASSERT_EQ(length[n_from * n_to - 1], INFINITY);
+}
+
+TEST_F(MatrixTests, lengthOnly)
+{
+    size_t n_from = fx.size(), n_to = tx.size();
+    configure_outputs(n_from * n_to);
+    DubinsBatchOutput partial;
+    partial.length = &length[0];
+    partial.type = NULL;
+    partial.param[0] = partial.param[1] = partial.param[2] = NULL;
+    partial.errcode = NULL;
+    ASSERT_EQ(dubins_distance_matrix(&from, n_from, &to, n_to, 1.0, &partial), EDUBOK);
+    ASSERT_GT(length[n_from * n_to - 1], 0.0);
+}
@@ -2,6 +2,10 @@ extern "C" {
 #include "dubins.h"
 }
 
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
 #include "gtest/gtest.h"
 
 struct Inputs
@@ -299,7 +303,72 @@ TEST_P(MonteCarloTests, Simple)
     }
 }
 
+TEST_P(MonteCarloTests, Vectorised)
+{
+    const DubinsSimdLevel levels[] = { DUBINS_SIMD_NONE, DUBINS_SIMD_SSE2, DUBINS_SIMD_AVX2,
+                                       DUBINS_SIMD_AVX512, DUBINS_SIMD_NEON };
+    DubinsSimdLevel original = dubins_simd_level();
+
+    DubinsBatchInput in = { &q0[0], &q0[1], &q0[2], &q1[0], &q1[1], &q1[2], NULL, turning_radius };
+    for(size_t l = 0; l < sizeof(levels) / sizeof(levels[0]); l++) {
+        if(dubins_simd_set_level(levels[l]) != 0) {
+            continue;
+        }
+        double length, p[3];
+        int code;
+        DubinsBatchOutput out = { &length, NULL, { &p[0], &p[1], &p[2] }, &code };
+        dubins_path_batch(&in, &out, 1, GetParam().inputs.word);
+        if(code != 0) {
+            code = 1;
+        }
+        ASSERT_EQ(code, GetParam().outputs.errcode) << "level " << levels[l];
+
+        if(code == 0)
+        {
+            for(int i = 0; i < 3; i++) {
+                ASSERT_NEAR(p[i], GetParam().outputs.params[i], 1e-8) << "level " << levels[l];
+            }
+            ASSERT_NEAR(length, GetParam().outputs.length, 1e-8) << "level " << levels[l];
+        }
+    }
+    dubins_simd_set_level(original);
+}
+
+TEST_P(MonteCarloTests, ClassifiedScan)
+{
+    DubinsPath path;
+    int code = dubins_shortest_path_scan(&path, q0, q1, turning_radius, DUBINS_SCAN_VERIFY);
+    ASSERT_NE(code, EDUBVERIFY);
+}
+
+TEST_P(MonteCarloTests, SinglePrecision)
+{
+    // the accuracy contract of the float engine against the double solver
+    float f0[3] = { (float)q0[0], (float)q0[1], (float)q0[2] };
+    float f1[3] = { (float)q1[0], (float)q1[1], (float)q1[2] };
+    DubinsPath path;
+    DubinsPathF pathf;
+    int code = dubins_path(&path, q0, q1, turning_radius, GetParam().inputs.word);
+    int codef = dubins_path_f(&pathf, f0, f1, (float)turning_radius, GetParam().inputs.word);
+    ASSERT_EQ(codef, code);
+
+    if(code == 0)
+    {
+        double len = dubins_path_length(&path);
+        ASSERT_NEAR(dubins_path_length_f(&pathf), len, 1e-5 * (1 + len));
+        for(int i = 0; i < 8; i++) {
+            double t = len * i / 8;
+            double q[3];
+            float qf[3];
+            ASSERT_EQ(dubins_path_sample(&path, t, q), EDUBOK);
+            ASSERT_EQ(dubins_path_sample_f(&pathf, (float)t, qf), EDUBOK);
+            ASSERT_NEAR(qf[0], q[0], 1e-4);
+            ASSERT_NEAR(qf[1], q[1], 1e-4);
+            ASSERT_NEAR(remainder(qf[2] - q[2], 2 * M_PI), 0.0, 1e-4);
+        }
+    }
+}
+
 INSTANTIATE_TEST_CASE_P(Simple,
                         MonteCarloTests,
                         ::testing::ValuesIn(params));
-
@@ -0,0 +1,78 @@
+extern "C" {
+#include "dubins.h"
+}
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+
+TEST(PackedTests, isCompact)
+{
+    ASSERT_EQ(sizeof(DubinsPackedPath), 16u);
+    ASSERT_LE(sizeof(DubinsPackedPath) * 3, sizeof(DubinsPath));
+}
+
+TEST(PackedTests, roundTrip)
+{
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> pos(-20.0, 20.0);
+    std::uniform_real_distribution<double> angle(0.0, 2 * M_PI);
+    std::vector<double> q(3 * 100);
+    for(auto& v : q) {
+        v = pos(gen);
+    }
+    DubinsNodeTable nodes = { q.data(), 100, 1.5 };
+    for(uint32_t i = 0; i < 100; i++) {
+        double* q0 = &q[3 * i];
+        double q1[3] = { pos(gen), pos(gen), angle(gen) };
+        DubinsPath path, unpacked;
+        DubinsPackedPath packed;
+        ASSERT_EQ(dubins_shortest_path(&path, q0, q1, nodes.rho), EDUBOK);
+        ASSERT_EQ(dubins_path_pack(&path, i, &packed), EDUBOK);
+        ASSERT_EQ(dubins_packed_path_node(&packed), i);
+        ASSERT_EQ(dubins_packed_path_type(&packed), path.type);
+        ASSERT_EQ(dubins_path_unpack(&packed, &nodes, &unpacked), EDUBOK);
+        ASSERT_EQ(unpacked.type, path.type);
+        ASSERT_EQ(unpacked.rho, path.rho);
+        for(int j = 0; j < 3; j++) {
+            ASSERT_EQ(unpacked.qi[j], path.qi[j]);
+            ASSERT_NEAR(unpacked.param[j], path.param[j], 1e-6);
+        }
+
+        double len = dubins_path_length(&path);
+        ASSERT_NEAR(dubins_packed_path_length(&packed, nodes.rho), len, 1e-6 * len);
+        for(int k = 0; k < 10; k++) {
+            double t = len * k / 10;
+            double expected[3], actual[3];
+            ASSERT_EQ(dubins_path_sample(&path, t, expected), EDUBOK);
+            ASSERT_EQ(dubins_packed_path_sample(&packed, &nodes, t, actual), EDUBOK);
+            ASSERT_NEAR(actual[0], expected[0], 1e-5);
+            ASSERT_NEAR(actual[1], expected[1], 1e-5);
+        }
+    }
+}
+
+TEST(PackedTests, nodeRange)
+{
+    double q0[3] = { 0, 0, 0 };
+    double q1[3] = { 4, 0, 0 };
+    DubinsPath path;
+    DubinsPackedPath packed;
+    DubinsNodeTable nodes = { q0, 1, 1.0 };
+    double q[3];
+    ASSERT_EQ(dubins_shortest_path(&path, q0, q1, 1.0), EDUBOK);
+    ASSERT_EQ(dubins_path_pack(&path, 1u << 29, &packed), EDUBPARAM);
+    ASSERT_EQ(dubins_path_pack(&path, (1u << 29) - 1, &packed), EDUBOK);
+    ASSERT_EQ(dubins_packed_path_node(&packed), (1u << 29) - 1);
+    ASSERT_EQ(dubins_path_unpack(&packed, &nodes, &path), EDUBPARAM);
+    ASSERT_EQ(dubins_packed_path_sample(&packed, &nodes, 0.0, q), EDUBPARAM);
+
+    ASSERT_EQ(dubins_path_pack(&path, 0, &packed), EDUBOK);
+    ASSERT_EQ(dubins_packed_path_sample(&packed, &nodes, 2.0, q), EDUBOK);
+    ASSERT_NEAR(q[0], 2.0, 1e-8);
+    ASSERT_EQ(dubins_packed_path_sample(&packed, &nodes, 5.0, q), EDUBPARAM);
+}
@@ -0,0 +1,144 @@
+extern "C" {
+#include "dubins.h"
+}
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <stdlib.h>
+#include <vector>
+#include "gtest/gtest.h"
+
+class ParallelTests : public ::testing::TestWithParam<unsigned>
+{
+public:
+    void SetUp()
+    {
+        srand(1357);
+        size_t n = 20000;
+        x0.resize(n); y0.resize(n); th0.resize(n);
+        x1.resize(n); y1.resize(n); th1.resize(n);
+        rho.resize(n);
+        for(size_t i = 0; i < n; i++) {
+            x0[i]  = uniform(-10.0, 10.0);
+            y0[i]  = uniform(-10.0, 10.0);
+            th0[i] = uniform(-M_PI, M_PI);
+            x1[i]  = uniform(-10.0, 10.0);
+            y1[i]  = uniform(-10.0, 10.0);
+            th1[i] = uniform(-M_PI, M_PI);
+            rho[i] = uniform(0.5, 3.0);
+        }
+        in.x0 = &x0[0]; in.y0 = &y0[0]; in.th0 = &th0[0];
+        in.x1 = &x1[0]; in.y1 = &y1[0]; in.th1 = &th1[0];
+        in.rho = &rho[0];
+        in.rho_shared = 0.0;
+        pool = dubins_thread_pool_create(GetParam());
+        ASSERT_TRUE(pool != NULL);
+    }
+
+    void TearDown()
+    {
+        dubins_thread_pool_destroy(pool);
+    }
+
+    double uniform(double lo, double hi)
+    {
+        return lo + (hi - lo) * (rand() / (double)RAND_MAX);
+    }
+
+    struct Results
+    {
+        std::vector<double> length, param[3];
+        std::vector<DubinsPathType> type;
+        std::vector<int> errcode;
+        DubinsBatchOutput out;
+
+        explicit Results(size_t n) : length(n, 0.0), type(n, LSL), errcode(n, -1)
+        {
+            for(int j = 0; j < 3; j++) {
+                param[j].assign(n, 0.0);
+                out.param[j] = &param[j][0];
+            }
+            out.length = &length[0];
+            out.type = &type[0];
+            out.errcode = &errcode[0];
+        }
+    };
+
+    void expect_same(const Results& a, const Results& b)
+    {
+        for(size_t i = 0; i < a.length.size(); i++) {
+            ASSERT_EQ(a.length[i], b.length[i]);
+            ASSERT_EQ(a.type[i], b.type[i]);
+            ASSERT_EQ(a.errcode[i], b.errcode[i]);
+            for(int j = 0; j < 3; j++) {
+                ASSERT_EQ(a.param[j][i], b.param[j][i]);
+            }
+        }
+    }
+
+protected:
+    std::vector<double> x0, y0, th0, x1, y1, th1, rho;
+    DubinsBatchInput in;
+    DubinsThreadPool* pool;
+};
+
+TEST_P(ParallelTests, poolSize)
+{
+    if(GetParam() > 0) {
+        ASSERT_LE(dubins_thread_pool_size(pool), GetParam());
+    }
+    ASSERT_GE(dubins_thread_pool_size(pool), 1u);
+    ASSERT_EQ(dubins_thread_pool_size(NULL), 1u);
+}
+
+TEST_P(ParallelTests, shortestPathMatchesSequential)
+{
+    size_t n = x0.size();
+    Results sequential(n), parallel(n);
+    ASSERT_EQ(dubins_shortest_path_batch(&in, &sequential.out, n), EDUBOK);
+    for(int repeat = 0; repeat < 3; repeat++) {
+        ASSERT_EQ(dubins_shortest_path_batch_parallel(&in, &parallel.out, n, pool), EDUBOK);
+        expect_same(sequential, parallel);
+    }
+}
+
+TEST_P(ParallelTests, firstErrorIsDeterministic)
+{
+    size_t n = x0.size();
+    Results sequential(n), parallel(n);
+    rho[19000] = -1.0;
+    rho[7777] = 0.0;
+    ASSERT_EQ(dubins_path_batch(&in, &sequential.out, n, RLR), EDUBNOPATH);
+    ASSERT_EQ(dubins_path_batch_parallel(&in, &parallel.out, n, RLR, pool), EDUBNOPATH);
+    expect_same(sequential, parallel);
+
+    for(size_t i = 0; i < 7000; i++) {
+        rho[i] = 100.0;
+    }
+    ASSERT_EQ(dubins_shortest_path_batch_parallel(&in, &parallel.out, n, pool), EDUBBADRHO);
+    ASSERT_EQ(parallel.errcode[7777], EDUBBADRHO);
+    ASSERT_EQ(parallel.errcode[19000], EDUBBADRHO);
+    ASSERT_EQ(dubins_path_batch_parallel(&in, &parallel.out, n, (DubinsPathType)6, pool), EDUBPARAM);
+}
+
+TEST_P(ParallelTests, distanceMatrixMatchesSequential)
+{
+    DubinsConfigSet from = { &x0[0], &y0[0], &th0[0] };
+    DubinsConfigSet to = { &x1[0], &y1[0], &th1[0] };
+    size_t n_from = 101, n_to = 130;
+    Results sequential(n_from * n_to), parallel(n_from * n_to);
+    ASSERT_EQ(dubins_distance_matrix(&from, n_from, &to, n_to, 1.5, &sequential.out), EDUBOK);
+    ASSERT_EQ(dubins_distance_matrix_parallel(&from, n_from, &to, n_to, 1.5, &parallel.out, pool), EDUBOK);
+    expect_same(sequential, parallel);
+}
+
+TEST_P(ParallelTests, emptyBatch)
+{
+    Results parallel(1);
+    ASSERT_EQ(dubins_shortest_path_batch_parallel(&in, &parallel.out, 0, pool), EDUBOK);
+    ASSERT_EQ(parallel.errcode[0], -1);
+}
+
+INSTANTIATE_TEST_CASE_P(Threads, ParallelTests, ::testing::Values(0u, 1u, 2u, 3u, 8u));
@@ -0,0 +1,63 @@
+#ifndef DUBINS_TESTS_RANDOM_CONFIGS_H
+#define DUBINS_TESTS_RANDOM_CONFIGS_H
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <random>
+#include <vector>
+
+/* a start and a goal configuration */
+struct ConfigPair
+{
+    double q0[3];
+    double q1[3];
+};
+
+/*
+ * Seeded random configurations for the property tests, with positions
+ * uniform in [-extent, extent] and headings uniform in [angle_lo, angle_hi)
+ */
+class RandomConfigs
+{
+public:
+    RandomConfigs(unsigned seed, double extent, double angle_lo = 0.0, double angle_hi = 2 * M_PI)
+        : gen(seed), pos(-extent, extent), angle(angle_lo, angle_hi)
+    {
+    }
+
+    void next(double q[3])
+    {
+        q[0] = pos(gen);
+        q[1] = pos(gen);
+        q[2] = angle(gen);
+    }
+
+    std::vector<ConfigPair> pairs(size_t n)
+    {
+        std::vector<ConfigPair> result(n);
+        for(size_t i = 0; i < n; i++) {
+            next(result[i].q0);
+            next(result[i].q1);
+        }
+        return result;
+    }
+
+    double position()
+    {
+        return pos(gen);
+    }
+
+    double uniform(double lo, double hi)
+    {
+        return std::uniform_real_distribution<double>(lo, hi)(gen);
+    }
+
+private:
+    std::mt19937 gen;
+    std::uniform_real_distribution<double> pos;
+    std::uniform_real_distribution<double> angle;
+};
+
+#endif
@@ -0,0 +1,187 @@
+extern "C" {
+#include "dubins_roadmap.h"
+}
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "gtest/gtest.h"
+
+class RoadmapTests : public ::testing::TestWithParam<DubinsRoadmapFormat>
+{
+public:
+    void SetUp()
+    {
+        rho = 1.25;
+        // a 5x5 grid of nodes, each connected to its right and upper neighbours
+        for(int i = 0; i < 5; i++) {
+            for(int j = 0; j < 5; j++) {
+                nodes.push_back(i * 3.0);
+                nodes.push_back(j * 3.0);
+                nodes.push_back((i + 2 * j) * 0.7);
+            }
+        }
+        for(uint32_t n = 0; n < 25; n++) {
+            uint32_t right = n + 5, up = n + 1;
+            if(right < 25) {
+                add_edge(n, right);
+            }
+            if(n % 5 != 4) {
+                add_edge(n, up);
+            }
+        }
+    }
+
+    void add_edge(uint32_t from, uint32_t to)
+    {
+        DubinsPath path;
+        ASSERT_EQ(dubins_shortest_path(&path, &nodes[3 * from], &nodes[3 * to], rho), EDUBOK);
+        sources.push_back(from);
+        targets.push_back(to);
+        paths.push_back(path);
+    }
+
+    int save(const char* filename)
+    {
+        return dubins_roadmap_save(filename, GetParam(), nodes.data(), nodes.size() / 3, rho,
+                                   sources.data(), targets.data(), paths.data(), paths.size());
+    }
+
+protected:
+    double rho;
+    std::vector<double> nodes;
+    std::vector<uint32_t> sources;
+    std::vector<uint32_t> targets;
+    std::vector<DubinsPath> paths;
+};
+
+TEST_P(RoadmapTests, saveAndMap)
+{
+    const char* filename = "roadmap_tests.bin";
+    DubinsRoadmap roadmap;
+    ASSERT_EQ(save(filename), EDUBOK);
+    ASSERT_EQ(dubins_roadmap_map(&roadmap, filename), EDUBOK);
+
+    ASSERT_EQ(roadmap.format, GetParam());
+    ASSERT_EQ(roadmap.n_nodes, 25u);
+    ASSERT_EQ(roadmap.n_edges, paths.size());
+    ASSERT_EQ(roadmap.rho, rho);
+    for(size_t i = 0; i < nodes.size(); i++) {
+        ASSERT_EQ(roadmap.nodes[i], nodes[i]);
+    }
+    for(uint32_t n = 0; n < 25; n++) {
+        for(uint64_t e = roadmap.edge_index[n]; e < roadmap.edge_index[n + 1]; e++) {
+            ASSERT_EQ(sources[e], n);
+        }
+    }
+    if(GetParam() == DUBINS_ROADMAP_PATHS) {
+        // full paths are usable in place
+        ASSERT_EQ(roadmap.paths[3].type, paths[3].type);
+        ASSERT_EQ(roadmap.paths[3].param[1], paths[3].param[1]);
+    }
+
+    double tolerance = GetParam() == DUBINS_ROADMAP_PATHS ? 0.0 : 1e-5;
+    for(size_t e = 0; e < paths.size(); e++) {
+        ASSERT_EQ(roadmap.edge_target[e], targets[e]);
+        double len = dubins_path_length(&paths[e]);
+        ASSERT_NEAR(dubins_roadmap_edge_length(&roadmap, e), len, tolerance);
+
+        DubinsPath path;
+        ASSERT_EQ(dubins_roadmap_edge_path(&roadmap, e, &path), EDUBOK);
+        ASSERT_EQ(path.type, paths[e].type);
+        ASSERT_EQ(path.qi[2], paths[e].qi[2]);
+
+        double expected[3], actual[3];
+        ASSERT_EQ(dubins_path_sample(&paths[e], len / 2, expected), EDUBOK);
+        ASSERT_EQ(dubins_roadmap_edge_sample(&roadmap, e, len / 2, actual), EDUBOK);
+        ASSERT_NEAR(actual[0], expected[0], tolerance);
+        ASSERT_NEAR(actual[1], expected[1], tolerance);
+    }
+
+    double q[3];
+    DubinsPath path;
+    ASSERT_EQ(dubins_roadmap_edge_path(&roadmap, paths.size(), &path), EDUBPARAM);
+    ASSERT_EQ(dubins_roadmap_edge_sample(&roadmap, paths.size(), 0.0, q), EDUBPARAM);
+    ASSERT_EQ(dubins_roadmap_edge_length(&roadmap, paths.size()), INFINITY);
+
+    dubins_roadmap_free(&roadmap);
+    remove(filename);
+}
+
+TEST_P(RoadmapTests, rejectsBadInput)
+{
+    const char* filename = "roadmap_tests_bad.bin";
+    std::swap(sources[0], sources[10]);
+    ASSERT_EQ(save(filename), EDUBPARAM);
+    std::swap(sources[0], sources[10]);
+    targets[2] = 25;
+    ASSERT_EQ(save(filename), EDUBPARAM);
+    remove(filename);
+}
+
+TEST_P(RoadmapTests, rejectsBadFiles)
+{
+    DubinsRoadmap roadmap;
+    ASSERT_EQ(dubins_roadmap_map(&roadmap, "roadmap_tests_missing.bin"), EDUBIO);
+
+    const char* filename = "roadmap_tests_truncated.bin";
+    ASSERT_EQ(save(filename), EDUBOK);
+    std::vector<char> contents(4096);
+    FILE* fp = fopen(filename, "rb");
+    size_t size = fread(contents.data(), 1, contents.size(), fp);
+    fclose(fp);
+    fp = fopen(filename, "wb");
+    fwrite(contents.data(), 1, size / 2, fp);
+    fclose(fp);
+    ASSERT_EQ(dubins_roadmap_map(&roadmap, filename), EDUBFORMAT);
+
+    fp = fopen(filename, "wb");
+    fputs("not a roadmap, but long enough to hold a header of the expected size.....................", fp);
+    fclose(fp);
+    ASSERT_EQ(dubins_roadmap_map(&roadmap, filename), EDUBFORMAT);
+    remove(filename);
+}
+
+TEST_P(RoadmapTests, rejectsOverflowingCounts)
+{
+    /* a header whose edge count wraps the unchecked layout back to a small file */
+    const char* filename = "roadmap_tests_overflow.bin";
+    ASSERT_EQ(save(filename), EDUBOK);
+    std::vector<char> contents(320, 0);
+    FILE* fp = fopen(filename, "rb");
+    ASSERT_EQ(fread(contents.data(), 1, 128, fp), (size_t)128);
+    fclose(fp);
+
+    uint32_t record;
+    memcpy(&record, contents.data() + 20, sizeof(record));
+    uint64_t n_nodes = 1, n_edges = UINT64_MAX / (4 + record) + 1;
+    uint64_t offsets[5];
+    offsets[0] = 128;
+    offsets[1] = (offsets[0] + n_nodes * 24 + 63) / 64 * 64;
+    offsets[2] = (offsets[1] + (n_nodes + 1) * 8 + 63) / 64 * 64;
+    offsets[3] = (offsets[2] + n_edges * 4 + 63) / 64 * 64;
+    offsets[4] = (offsets[3] + n_edges * record + 63) / 64 * 64;
+    if(offsets[4] > contents.size()) {
+        contents.resize(offsets[4]);
+    }
+    memcpy(contents.data() + 24, &n_nodes, sizeof(n_nodes));
+    memcpy(contents.data() + 32, &n_edges, sizeof(n_edges));
+    memcpy(contents.data() + 48, offsets, sizeof(offsets));
+    uint64_t index[2] = { 0, n_edges };
+    memcpy(contents.data() + offsets[1], index, sizeof(index));
+    fp = fopen(filename, "wb");
+    fwrite(contents.data(), 1, contents.size(), fp);
+    fclose(fp);
+
+    DubinsRoadmap roadmap;
+    ASSERT_EQ(dubins_roadmap_map(&roadmap, filename), EDUBFORMAT);
+    remove(filename);
+}
+
+INSTANTIATE_TEST_CASE_P(Formats,
+                        RoadmapTests,
+                        ::testing::Values(DUBINS_ROADMAP_PATHS, DUBINS_ROADMAP_PACKED));
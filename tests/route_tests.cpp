@@ -0,0 +1,146 @@
+extern "C" {
+#include "dubins.h"
+}
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <vector>
+#include "gtest/gtest.h"
+
+struct Waypoints
+{
+    std::vector<double> q;
+    size_t taken;
+};
+
+static int next_waypoint(double q[3], void* user_data)
+{
+    Waypoints* w = (Waypoints*)user_data;
+    if(3 * w->taken >= w->q.size()) {
+        return 1;
+    }
+    for(int i = 0; i < 3; i++) {
+        q[i] = w->q[3 * w->taken + i];
+    }
+    w->taken++;
+    return 0;
+}
+
+class RouteTests : public ::testing::Test
+{
+public:
+    void SetUp()
+    {
+        rho = 1.0;
+        waypoints.taken = 0;
+        // a zig-zag with legs both longer and shorter than the step
+        for(int i = 0; i < 200; i++) {
+            waypoints.q.push_back(i * 2.5);
+            waypoints.q.push_back((i % 2) * 3.0);
+            waypoints.q.push_back((i % 3) * 0.5);
+        }
+    }
+
+protected:
+    double rho;
+    Waypoints waypoints;
+};
+
+TEST_F(RouteTests, continuousAcrossLegs)
+{
+    std::vector<DubinsPath> legs;
+    std::vector<double> starts;
+    double total = 0;
+    for(size_t i = 0; i + 1 < waypoints.q.size() / 3; i++) {
+        DubinsPath path;
+        ASSERT_EQ(dubins_shortest_path(&path, &waypoints.q[3 * i], &waypoints.q[3 * i + 3], rho), EDUBOK);
+        legs.push_back(path);
+        starts.push_back(total);
+        total += dubins_path_length(&path);
+    }
+
+    const double step = 0.7;
+    DubinsPath ring[4];
+    DubinsRoute route;
+    ASSERT_EQ(dubins_route_init(&route, next_waypoint, &waypoints, rho, step, ring, 4), EDUBOK);
+    ASSERT_LE(waypoints.taken, 5u);
+
+    double q[3], s;
+    size_t n = 0;
+    while(dubins_route_next(&route, q, &s) == EDUBOK) {
+        size_t leg = dubins_route_leg(&route);
+        ASSERT_LT(leg, legs.size());
+        // memory and work stay bounded by the lookahead
+        ASSERT_LE(waypoints.taken, leg + 2 + 4);
+        ASSERT_NEAR(s, n * step, 1e-9 * (1 + s));
+        ASSERT_GE(s, starts[leg] - 1e-9);
+
+        double expected[3];
+        ASSERT_EQ(dubins_path_sample(&legs[leg], s - starts[leg], expected), EDUBOK);
+        ASSERT_NEAR(q[0], expected[0], 1e-8);
+        ASSERT_NEAR(q[1], expected[1], 1e-8);
+        ASSERT_NEAR(remainder(q[2] - expected[2], 2 * M_PI), 0.0, 1e-8);
+        n++;
+    }
+    ASSERT_EQ(n, (size_t)ceil(total / step));
+    ASSERT_EQ(dubins_route_next(&route, q, &s), EDUBPARAM);
+}
+
+TEST_F(RouteTests, shortRoutes)
+{
+    DubinsPath ring[1];
+    DubinsRoute route;
+    double q[3];
+
+    waypoints.q.resize(0);
+    ASSERT_EQ(dubins_route_init(&route, next_waypoint, &waypoints, rho, 1.0, ring, 1), EDUBOK);
+    ASSERT_EQ(dubins_route_next(&route, q, NULL), EDUBPARAM);
+
+    waypoints.q = { 1.0, 2.0, 0.0 };
+    waypoints.taken = 0;
+    ASSERT_EQ(dubins_route_init(&route, next_waypoint, &waypoints, rho, 1.0, ring, 1), EDUBOK);
+    ASSERT_EQ(dubins_route_next(&route, q, NULL), EDUBPARAM);
+
+    waypoints.q = { 0.0, 0.0, 0.0, 4.0, 0.0, 0.0 };
+    waypoints.taken = 0;
+    ASSERT_EQ(dubins_route_init(&route, next_waypoint, &waypoints, rho, 1.0, ring, 1), EDUBOK);
+    for(int i = 0; i < 4; i++) {
+        ASSERT_EQ(dubins_route_next(&route, q, NULL), EDUBOK);
+        ASSERT_NEAR(q[0], i, 1e-12);
+    }
+    ASSERT_EQ(dubins_route_next(&route, q, NULL), EDUBPARAM);
+}
+
+TEST_F(RouteTests, invalidParameters)
+{
+    DubinsPath ring[2];
+    DubinsRoute route;
+    ASSERT_EQ(dubins_route_init(&route, next_waypoint, &waypoints, -1.0, 1.0, ring, 2), EDUBBADRHO);
+    ASSERT_EQ(dubins_route_init(&route, next_waypoint, &waypoints, rho, 0.0, ring, 2), EDUBPARAM);
+    ASSERT_EQ(dubins_route_init(&route, next_waypoint, &waypoints, rho, 1.0, ring, 0), EDUBPARAM);
+    ASSERT_EQ(waypoints.taken, 0u);
+}
+
+TEST_F(RouteTests, unreachableWaypointEndsRoute)
+{
+    DubinsPath ring[3];
+    DubinsRoute route;
+    double q[3];
+
+    waypoints.q = { 0.0, 0.0, 0.0, 4.0, 0.0, 0.0, NAN, 0.0, 0.0, 8.0, 0.0, 0.0 };
+    for(size_t lookahead = 1; lookahead <= 3; lookahead++) {
+        waypoints.taken = 0;
+        ASSERT_EQ(dubins_route_init(&route, next_waypoint, &waypoints, rho, 1.0, ring, lookahead), EDUBOK);
+        for(int i = 0; i < 4; i++) {
+            ASSERT_EQ(dubins_route_next(&route, q, NULL), EDUBOK);
+            ASSERT_NEAR(q[0], i, 1e-12);
+        }
+        int err = dubins_route_next(&route, q, NULL);
+        EXPECT_NE(err, EDUBOK);
+        EXPECT_NE(err, EDUBPARAM);
+        EXPECT_EQ(dubins_route_next(&route, q, NULL), err);
+        EXPECT_EQ(waypoints.taken, 3u);
+    }
+}
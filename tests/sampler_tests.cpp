@@ -0,0 +1,178 @@
+extern "C" {
+#include "dubins.h"
+}
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <stdlib.h>
+#include "gtest/gtest.h"
+
+class SamplerTests : public ::testing::Test
+{
+public:
+    void SetUp()
+    {
+        srand(9753);
+    }
+
+    double uniform(double lo, double hi)
+    {
+        return lo + (hi - lo) * (rand() / (double)RAND_MAX);
+    }
+
+    void random_path(DubinsPath* path)
+    {
+        double q0[3] = { uniform(-10, 10), uniform(-10, 10), uniform(-M_PI, M_PI) };
+        double q1[3] = { uniform(-10, 10), uniform(-10, 10), uniform(-M_PI, M_PI) };
+        ASSERT_EQ(dubins_shortest_path(path, q0, q1, uniform(0.5, 3.0)), EDUBOK);
+    }
+
+    void expect_close(double a[3], double b[3], double tolerance)
+    {
+        ASSERT_NEAR(a[0], b[0], tolerance);
+        ASSERT_NEAR(a[1], b[1], tolerance);
+        ASSERT_NEAR(remainder(a[2] - b[2], 2 * M_PI), 0.0, tolerance);
+    }
+};
+
+TEST_F(SamplerTests, matchesPathSample)
+{
+    for(int i = 0; i < 200; i++) {
+        DubinsPath path;
+        DubinsPathSampler sampler;
+        double q[3], expected[3], t;
+        double step = uniform(0.01, 0.5);
+        size_t count = 0;
+        random_path(&path);
+        ASSERT_EQ(dubins_path_sampler_init(&sampler, &path, step), EDUBOK);
+        while(dubins_path_sampler_next(&sampler, q, &t) == EDUBOK) {
+            ASSERT_EQ(t, count * step);
+            ASSERT_EQ(dubins_path_sample(&path, t, expected), EDUBOK);
+            expect_close(q, expected, 1e-10);
+            count++;
+        }
+        ASSERT_GE(count * step, dubins_path_length(&path));
+        ASSERT_GT(count, (size_t)0);
+    }
+}
+
+TEST_F(SamplerTests, driftStaysBoundedOnFineSteps)
+{
+    double q0[3] = { 0, 0, 0 };
+    double q1[3] = { 0.5, 0.5, M_PI };
+    DubinsPath path;
+    DubinsPathSampler sampler;
+    double q[3], expected[3], t;
+    ASSERT_EQ(dubins_path(&path, q0, q1, 100.0, LRL), EDUBOK);
+    ASSERT_EQ(dubins_path_sampler_init(&sampler, &path, 1e-3), EDUBOK);
+    while(dubins_path_sampler_next(&sampler, q, &t) == EDUBOK) {
+        dubins_path_sample(&path, t, expected);
+        expect_close(q, expected, 1e-9);
+    }
+}
+
+TEST_F(SamplerTests, invalidStep)
+{
+    DubinsPath path;
+    DubinsPathSampler sampler;
+    random_path(&path);
+    ASSERT_EQ(dubins_path_sampler_init(&sampler, &path, 0.0), EDUBPARAM);
+    ASSERT_EQ(dubins_path_sampler_init(&sampler, &path, -1.0), EDUBPARAM);
+}
+
+TEST_F(SamplerTests, exhausted)
+{
+    DubinsPath path;
+    DubinsPathSampler sampler;
+    double q[3];
+    random_path(&path);
+    ASSERT_EQ(dubins_path_sampler_init(&sampler, &path, 2 * dubins_path_length(&path)), EDUBOK);
+    ASSERT_EQ(dubins_path_sampler_next(&sampler, q, NULL), EDUBOK);
+    ASSERT_EQ(dubins_path_sampler_next(&sampler, q, NULL), EDUBPARAM);
+    ASSERT_EQ(dubins_path_sampler_next(&sampler, q, NULL), EDUBPARAM);
+}
+
+TEST_F(SamplerTests, sampleIntoMatchesSampler)
+{
+    DubinsPath path;
+    DubinsPathSampler sampler;
+    double xs[4096], ys[4096], ths[4096], ts[4096], q[3], t;
+    random_path(&path);
+    size_t n = dubins_path_sample_into(&path, 0.05, xs, ys, ths, ts, 4096, 0);
+    ASSERT_GT(n, (size_t)0);
+    ASSERT_LT(n, (size_t)4096);
+    dubins_path_sampler_init(&sampler, &path, 0.05);
+    for(size_t i = 0; i < n; i++) {
+        ASSERT_EQ(dubins_path_sampler_next(&sampler, q, &t), EDUBOK);
+        ASSERT_EQ(xs[i], q[0]);
+        ASSERT_EQ(ys[i], q[1]);
+        ASSERT_EQ(ths[i], q[2]);
+        ASSERT_EQ(ts[i], t);
+    }
+    ASSERT_EQ(dubins_path_sampler_next(&sampler, q, &t), EDUBPARAM);
+}
+
+TEST_F(SamplerTests, sampleIntoResumes)
+{
+    DubinsPath path;
+    static double whole[3][4096], part[3][4096], ts[4096];
+    random_path(&path);
+    size_t n = dubins_path_sample_into(&path, 0.03, whole[0], whole[1], whole[2], NULL, 4096, 0);
+    ASSERT_LT(n, (size_t)4096);
+    size_t written = 0, count;
+    while((count = dubins_path_sample_into(&path, 0.03, part[0] + written, part[1] + written,
+                                           part[2] + written, ts + written, 7, written)) > 0) {
+        written += count;
+    }
+    ASSERT_EQ(written, n);
+    for(size_t i = 0; i < n; i++) {
+        ASSERT_NEAR(ts[i], i * 0.03, 1e-12);
+        double a[3] = { whole[0][i], whole[1][i], whole[2][i] };
+        double b[3] = { part[0][i], part[1][i], part[2][i] };
+        expect_close(a, b, 1e-10);
+    }
+}
+
+TEST_F(SamplerTests, sampleIntoResumesAtExactMultiple)
+{
+    /* a running sum of 0.1 stays below 1 after ten steps, 10 * 0.1 does not */
+    double q0[3] = { 0, 0, 0 };
+    double q1[3] = { 1, 0, 0 };
+    double whole[3 * 32], part[3 * 32], ts[32], tparts[32];
+    DubinsPath path;
+    ASSERT_EQ(dubins_shortest_path(&path, q0, q1, 1.0), EDUBOK);
+    ASSERT_EQ(dubins_path_length(&path), 1.0);
+    size_t n = dubins_path_sample_into_interleaved(&path, 0.1, whole, ts, 32, 0);
+    size_t written = 0, count;
+    while((count = dubins_path_sample_into_interleaved(&path, 0.1, part + 3 * written, tparts + written,
+                                                       3, written)) > 0) {
+        written += count;
+    }
+    ASSERT_EQ(n, (size_t)10);
+    ASSERT_EQ(written, n);
+    for(size_t i = 0; i < n; i++) {
+        ASSERT_EQ(ts[i], i * 0.1);
+        ASSERT_EQ(tparts[i], ts[i]);
+        ASSERT_EQ(part[3 * i], whole[3 * i]);
+        ASSERT_EQ(part[3 * i + 1], whole[3 * i + 1]);
+        ASSERT_EQ(part[3 * i + 2], whole[3 * i + 2]);
+    }
+}
+
+TEST_F(SamplerTests, sampleIntoInterleaved)
+{
+    DubinsPath path;
+    double xs[512], ys[512], ths[512], qs[3 * 512];
+    random_path(&path);
+    size_t n = dubins_path_sample_into(&path, 0.1, xs, ys, ths, NULL, 512, 3);
+    ASSERT_EQ(dubins_path_sample_into_interleaved(&path, 0.1, qs, NULL, 512, 3), n);
+    for(size_t i = 0; i < n; i++) {
+        ASSERT_EQ(qs[3 * i], xs[i]);
+        ASSERT_EQ(qs[3 * i + 1], ys[i]);
+        ASSERT_EQ(qs[3 * i + 2], ths[i]);
+    }
+    ASSERT_EQ(dubins_path_sample_into(&path, 0.0, xs, ys, ths, NULL, 512, 0), (size_t)0);
+    ASSERT_EQ(dubins_path_sample_into(&path, 0.1, xs, ys, ths, NULL, 512, 1000000), (size_t)0);
+}
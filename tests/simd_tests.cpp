@@ -0,0 +1,179 @@
+extern "C" {
+#include "dubins.h"
+}
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <stdlib.h>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+
+class SimdTests : public ::testing::TestWithParam<DubinsSimdLevel>
+{
+public:
+    void SetUp()
+    {
+        original = dubins_simd_level();
+        if(dubins_simd_set_level(GetParam()) != 0) {
+            supported = false;
+            return;
+        }
+        supported = true;
+
+        srand(4321);
+        size_t n = 1000;
+        x0.resize(n); y0.resize(n); th0.resize(n);
+        x1.resize(n); y1.resize(n); th1.resize(n);
+        for(size_t i = 0; i < n; i++) {
+            x0[i]  = uniform(-5.0, 5.0);
+            y0[i]  = uniform(-5.0, 5.0);
+            th0[i] = uniform(-2 * M_PI, 2 * M_PI);
+            x1[i]  = uniform(-5.0, 5.0);
+            y1[i]  = uniform(-5.0, 5.0);
+            th1[i] = uniform(-2 * M_PI, 2 * M_PI);
+        }
+        /* coincident positions exercise the d == 0 special case */
+        x1[7] = x0[7];
+        y1[7] = y0[7];
+        in.x0 = &x0[0]; in.y0 = &y0[0]; in.th0 = &th0[0];
+        in.x1 = &x1[0]; in.y1 = &y1[0]; in.th1 = &th1[0];
+        in.rho = NULL;
+        in.rho_shared = 1.0;
+
+        length.assign(n, 0.0);
+        type.assign(n, LSL);
+        errcode.assign(n, -1);
+        for(int j = 0; j < 3; j++) {
+            param[j].assign(n, 0.0);
+            out.param[j] = &param[j][0];
+        }
+        out.length = &length[0];
+        out.type = &type[0];
+        out.errcode = &errcode[0];
+    }
+
+    void TearDown()
+    {
+        dubins_simd_set_level(original);
+    }
+
+    double uniform(double lo, double hi)
+    {
+        return lo + (hi - lo) * (rand() / (double)RAND_MAX);
+    }
+
+protected:
+    DubinsSimdLevel original;
+    bool supported;
+    std::vector<double> x0, y0, th0, x1, y1, th1;
+    std::vector<double> length, param[3];
+    std::vector<DubinsPathType> type;
+    std::vector<int> errcode;
+    DubinsBatchInput in;
+    DubinsBatchOutput out;
+};
+
+TEST_P(SimdTests, shortestPathMatchesScalar)
+{
+    if(!supported) {
+        return;
+    }
+    size_t n = x0.size();
+    ASSERT_EQ(dubins_shortest_path_batch(&in, &out, n), EDUBOK);
+
+    for(size_t i = 0; i < n; i++) {
+        double q0[3] = { x0[i], y0[i], th0[i] };
+        double q1[3] = { x1[i], y1[i], th1[i] };
+        DubinsPath path;
+        ASSERT_EQ(dubins_shortest_path(&path, q0, q1, 1.0), errcode[i]);
+        ASSERT_EQ(path.type, type[i]) << "pair " << i;
+        ASSERT_NEAR(dubins_path_length(&path), length[i], 1e-9) << "pair " << i;
+    }
+}
+
+TEST_P(SimdTests, eachWordMatchesScalar)
+{
+    if(!supported) {
+        return;
+    }
+    size_t n = x0.size();
+    for(int w = 0; w < 6; w++) {
+        dubins_path_batch(&in, &out, n, (DubinsPathType)w);
+        for(size_t i = 0; i < n; i++) {
+            double q0[3] = { x0[i], y0[i], th0[i] };
+            double q1[3] = { x1[i], y1[i], th1[i] };
+            DubinsPath path;
+            int err = dubins_path(&path, q0, q1, 1.0, (DubinsPathType)w);
+            ASSERT_EQ(err, errcode[i]) << "word " << w << " pair " << i;
+            if(err == EDUBOK) {
+                for(int j = 0; j < 3; j++) {
+                    /* a parameter on the 0 / 2pi seam may legitimately land on either side */
+                    double diff = fabs(path.param[j] - param[j][i]);
+                    ASSERT_TRUE(diff < 1e-9 || fabs(diff - 2 * M_PI) < 1e-9)
+                        << "word " << w << " pair " << i << " segment " << j;
+                }
+            }
+        }
+    }
+}
+
+TEST_P(SimdTests, partialBlock)
+{
+    if(!supported) {
+        return;
+    }
+    /* sizes that leave a partial vector at the end of the last block */
+    const size_t sizes[] = { 1, 3, 63, 65, 131 };
+    for(size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        size_t n = sizes[s];
+        ASSERT_EQ(dubins_shortest_path_batch(&in, &out, n), EDUBOK);
+        for(size_t i = 0; i < n; i++) {
+            double q0[3] = { x0[i], y0[i], th0[i] };
+            double q1[3] = { x1[i], y1[i], th1[i] };
+            DubinsPath path;
+            dubins_shortest_path(&path, q0, q1, 1.0);
+            ASSERT_NEAR(dubins_path_length(&path), length[i], 1e-9);
+        }
+    }
+}
+
+TEST_P(SimdTests, levelChangesDuringConcurrentBatches)
+{
+    if(!supported) {
+        return;
+    }
+    /* solvers on other threads read the level while this one switches it */
+    size_t n = x0.size();
+    std::vector<double> lengths[2];
+    std::vector<std::thread> solvers;
+    for(int k = 0; k < 2; k++) {
+        lengths[k].assign(n, 0.0);
+        solvers.push_back(std::thread([this, n, &lengths, k]() {
+            for(int r = 0; r < 20; r++) {
+                dubins_shortest_length_batch(&in, &lengths[k][0], NULL, n);
+            }
+        }));
+    }
+    for(int r = 0; r < 200; r++) {
+        dubins_simd_set_level((r % 2) ? GetParam() : DUBINS_SIMD_NONE);
+    }
+    for(size_t k = 0; k < solvers.size(); k++) {
+        solvers[k].join();
+    }
+    ASSERT_EQ(dubins_simd_level(), GetParam());
+    ASSERT_EQ(dubins_shortest_path_batch(&in, &out, n), EDUBOK);
+    for(int k = 0; k < 2; k++) {
+        for(size_t i = 0; i < n; i++) {
+            ASSERT_NEAR(lengths[k][i], length[i], 1e-9) << "pair " << i;
+        }
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(Levels,
+                        SimdTests,
+                        ::testing::Values(DUBINS_SIMD_NONE, DUBINS_SIMD_SSE2, DUBINS_SIMD_AVX2,
+                                          DUBINS_SIMD_AVX512, DUBINS_SIMD_NEON,
+                                          DUBINS_SIMD_WASM));
@@ -270,3 +270,72 @@ TEST_F(DubinsTests, extractInvalidSubpath)
 }
 
 
+
+TEST_F(DubinsTests, shortestLength)
+{
+    configure_inputs(0.0, 0.0, 4.0);
+
+    double length;
+    int err = dubins_shortest_length(&length, q0, q1, turning_radius);
+    ASSERT_EQ(err, EDUBOK);
+    ASSERT_DOUBLE_EQ(length, 4.0);
+
+    err = dubins_shortest_length(&length, q0, q1, -1.0);
+    ASSERT_EQ(err, EDUBBADRHO);
+}
+
+TEST_F(DubinsTests, singlePrecisionShortestPath)
+{
+    configure_inputs(0.0, 0.0, 4.0);
+
+    float f0[3] = { 0.0f, 0.0f, 0.0f };
+    float f1[3] = { 4.0f, 0.0f, 0.0f };
+    DubinsPathF path;
+    int err = dubins_shortest_path_f(&path, f0, f1, (float)turning_radius);
+    ASSERT_EQ(err, EDUBOK);
+    ASSERT_FLOAT_EQ(dubins_path_length_f(&path), 4.0f);
+
+    float qsamp[3];
+    err = dubins_path_sample_f(&path, 2.0f, qsamp);
+    ASSERT_EQ(err, EDUBOK);
+    ASSERT_NEAR(qsamp[0], 2.0f, 1e-6);
+    ASSERT_NEAR(qsamp[1], 0.0f, 1e-6);
+    err = dubins_path_sample_f(&path, 5.0f, qsamp);
+    ASSERT_EQ(err, EDUBPARAM);
+
+    err = dubins_shortest_path_f(&path, f0, f1, -1.0f);
+    ASSERT_EQ(err, EDUBBADRHO);
+}
+
+TEST_F(DubinsTests, singlePrecisionMatchesDouble)
+{
+    // headings on a grid, so both solvers see the same inputs
+    for(int i = 0; i < 8; i++) {
+        for(int j = 0; j < 8; j++) {
+            for(int k = 1; k <= 6; k++) {
+                configure_inputs(i * M_PI / 4 + 0.1, j * M_PI / 4 - 0.2, k * 1.5);
+                float f0[3] = { (float)q0[0], (float)q0[1], (float)q0[2] };
+                float f1[3] = { (float)q1[0], (float)q1[1], (float)q1[2] };
+                DubinsPath path;
+                DubinsPathF pathf;
+                ASSERT_EQ(dubins_shortest_path(&path, q0, q1, turning_radius), EDUBOK);
+                ASSERT_EQ(dubins_shortest_path_f(&pathf, f0, f1, (float)turning_radius), EDUBOK);
+                double len = dubins_path_length(&path);
+                ASSERT_NEAR(dubins_path_length_f(&pathf), len, 1e-5 * (1 + len));
+            }
+        }
+    }
+}
+
+TEST_F(DubinsTests, singlePrecisionMany)
+{
+    float q0s[6] = { 0, 0, 0, 0, 0, 0 };
+    float q1s[6] = { 4, 0, 0, 0, 0, 0 };
+    DubinsPathF paths[2];
+    int errcodes[2];
+    int err = dubins_shortest_path_many_f(paths, q0s, q1s, 1.0f, errcodes, 2);
+    ASSERT_EQ(err, EDUBOK);
+    ASSERT_EQ(errcodes[0], EDUBOK);
+    ASSERT_FLOAT_EQ(dubins_path_length_f(&paths[0]), 4.0f);
+    ASSERT_FLOAT_EQ(dubins_path_length_f(&paths[1]), 0.0f);
+}
@@ -0,0 +1,79 @@
+extern "C" {
+#include "dubins.h"
+}
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <thread>
+#include "gtest/gtest.h"
+
+#ifdef DUBINS_ENABLE_STATS
+
+TEST(StatsTests, countsWinsAndWords)
+{
+    double q0[3] = { 0, 0, 0 };
+    double q1[3] = { 10, 0, 0 };
+    DubinsPath path;
+    DubinsStats stats;
+    dubins_stats_reset();
+    ASSERT_EQ(dubins_shortest_path(&path, q0, q1, 1.0), EDUBOK);
+    ASSERT_EQ(dubins_stats_snapshot(&stats), EDUBOK);
+    EXPECT_EQ(stats.wins[path.type], 1u);
+    EXPECT_EQ(stats.intermediate_calls, 1u);
+    /* d = 10 skips the CCC words and at least some CSC words */
+    EXPECT_GE(stats.words_pruned, 2u);
+    uint64_t calls = 0;
+    for(int i = 0; i < 6; i++) {
+        calls += stats.word_calls[i];
+    }
+    EXPECT_EQ(calls + stats.words_pruned, 6u);
+}
+
+TEST(StatsTests, countsRejects)
+{
+    double q0[3] = { 0, 0, 0 };
+    double q1[3] = { 100, 0, 0 };
+    DubinsPath path;
+    DubinsStats stats;
+    dubins_stats_reset();
+    ASSERT_EQ(dubins_path(&path, q0, q1, 1.0, RLR), EDUBNOPATH);
+    ASSERT_EQ(dubins_stats_snapshot(&stats), EDUBOK);
+    EXPECT_EQ(stats.word_calls[RLR], 1u);
+    EXPECT_EQ(stats.word_nopath[RLR], 1u);
+    EXPECT_EQ(stats.acos_rejects, 1u);
+    EXPECT_EQ(stats.p_sq_rejects, 0u);
+}
+
+TEST(StatsTests, includesOtherThreads)
+{
+    DubinsStats stats;
+    dubins_stats_reset();
+    std::thread worker([]() {
+        double q0[3] = { 0, 0, 0 };
+        double q1[3] = { 1, 1, 0 };
+        double length;
+        for(int i = 0; i < 10; i++) {
+            dubins_shortest_length(&length, q0, q1, 1.0);
+        }
+    });
+    worker.join();
+    ASSERT_EQ(dubins_stats_snapshot(&stats), EDUBOK);
+    uint64_t wins = 0;
+    for(int i = 0; i < 6; i++) {
+        wins += stats.wins[i];
+    }
+    EXPECT_EQ(wins, 10u);
+}
+
+#else
+
+TEST(StatsTests, disabled)
+{
+    DubinsStats stats;
+    ASSERT_EQ(dubins_stats_snapshot(&stats), EDUBPARAM);
+    ASSERT_EQ(stats.intermediate_calls, 0u);
+}
+
+#endif
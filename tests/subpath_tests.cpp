@@ -0,0 +1,153 @@
+extern "C" {
+#include "dubins.h"
+}
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <vector>
+#include "gtest/gtest.h"
+#include "random_configs.h"
+
+class SubpathTests : public ::testing::Test
+{
+public:
+    void SetUp()
+    {
+        RandomConfigs configs(29, 10.0);
+        for(int i = 0; i < 300; i++) {
+            double q0[3], q1[3];
+            configs.next(q0);
+            configs.next(q1);
+            DubinsPath path;
+            ASSERT_EQ(dubins_shortest_path(&path, q0, q1, 1.3), EDUBOK);
+            double length = dubins_path_length(&path);
+            double a = configs.uniform(0.0, 1.0) * length;
+            double b = configs.uniform(0.0, 1.0) * length;
+            paths.push_back(path);
+            t0s.push_back(fmin(a, b));
+            t1s.push_back(fmax(a, b));
+        }
+    }
+
+    static void expectSameConfig(const double* a, const double* b, double tol)
+    {
+        EXPECT_NEAR(a[0], b[0], tol);
+        EXPECT_NEAR(a[1], b[1], tol);
+        EXPECT_NEAR(remainder(a[2] - b[2], 2 * M_PI), 0.0, tol);
+    }
+
+protected:
+    std::vector<DubinsPath> paths;
+    std::vector<double> t0s;
+    std::vector<double> t1s;
+};
+
+TEST_F(SubpathTests, windowSamplesMatchOriginal)
+{
+    for(size_t i = 0; i < paths.size(); i++) {
+        DubinsPath window;
+        ASSERT_EQ(dubins_extract_window(&paths[i], t0s[i], t1s[i], &window), EDUBOK);
+        EXPECT_EQ(window.type, paths[i].type);
+        EXPECT_NEAR(dubins_path_length(&window), t1s[i] - t0s[i], 1e-12);
+        for(int k = 0; k <= 16; k++) {
+            double t = (t1s[i] - t0s[i]) * k / 16;
+            double a[3], b[3];
+            ASSERT_EQ(dubins_path_sample(&window, fmin(t, dubins_path_length(&window)), a), EDUBOK);
+            ASSERT_EQ(dubins_path_sample(&paths[i], fmin(t0s[i] + t, dubins_path_length(&paths[i])), b), EDUBOK);
+            expectSameConfig(a, b, 1e-9);
+        }
+    }
+}
+
+TEST_F(SubpathTests, suffixEndsWithOriginal)
+{
+    for(size_t i = 0; i < paths.size(); i++) {
+        DubinsPath suffix;
+        double a[3], b[3];
+        ASSERT_EQ(dubins_extract_suffix(&paths[i], t0s[i], &suffix), EDUBOK);
+        ASSERT_EQ(dubins_path_endpoint(&suffix, a), EDUBOK);
+        ASSERT_EQ(dubins_path_endpoint(&paths[i], b), EDUBOK);
+        expectSameConfig(a, b, 1e-8);
+    }
+    DubinsPath suffix;
+    EXPECT_EQ(dubins_extract_suffix(&paths[0], -1e-9, &suffix), EDUBPARAM);
+    EXPECT_EQ(dubins_extract_suffix(&paths[0], dubins_path_length(&paths[0]) + 1e-9, &suffix), EDUBPARAM);
+}
+
+TEST_F(SubpathTests, splicedWindowsRebuildOriginal)
+{
+    for(size_t i = 0; i < paths.size(); i++) {
+        double length = dubins_path_length(&paths[i]);
+        DubinsPath head, middle, tail, joined;
+        ASSERT_EQ(dubins_extract_window(&paths[i], 0.0, t0s[i], &head), EDUBOK);
+        ASSERT_EQ(dubins_extract_window(&paths[i], t0s[i], t1s[i], &middle), EDUBOK);
+        ASSERT_EQ(dubins_extract_window(&paths[i], t1s[i], length, &tail), EDUBOK);
+        ASSERT_EQ(dubins_path_splice(&head, &middle, &joined), EDUBOK);
+        ASSERT_EQ(dubins_path_splice(&joined, &tail, &joined), EDUBOK);
+        EXPECT_EQ(joined.type, paths[i].type);
+        for(int j = 0; j < 3; j++) {
+            EXPECT_NEAR(joined.param[j], paths[i].param[j], 1e-12);
+            EXPECT_EQ(joined.qi[j], paths[i].qi[j]);
+        }
+    }
+}
+
+TEST_F(SubpathTests, spliceRejectsGapsAndLongWords)
+{
+    double q0[3] = { 0.0, 0.0, 0.0 };
+    double q1[3] = { 4.0, 4.0, M_PI / 2 };
+    double end[3];
+    DubinsPath first, second, joined;
+    ASSERT_EQ(dubins_path(&first, q0, q1, 1.0, LSL), EDUBOK);
+    ASSERT_EQ(dubins_path_endpoint(&first, end), EDUBOK);
+
+    second = first;
+    EXPECT_EQ(dubins_path_splice(&first, &second, &joined), EDUBPARAM);
+
+    double q2[3] = { 0.0, 10.0, M_PI };
+    ASSERT_EQ(dubins_path(&second, q1, q2, 1.0, RSR), EDUBOK);
+    if(first.param[2] > 0 && second.param[0] > 0) {
+        EXPECT_EQ(dubins_path_splice(&first, &second, &joined), EDUBNOPATH);
+    }
+
+    /* a straight then a right turn fits neither word, but is LSR */
+    DubinsPath straight = { { 0.0, 0.0, 0.0 }, { 0.0, 2.0, 0.0 }, 1.0, LSL };
+    DubinsPath turn = { { 2.0, 0.0, 0.0 }, { 1.0, 0.0, 0.0 }, 1.0, RLR };
+    ASSERT_EQ(dubins_path_splice(&straight, &turn, &joined), EDUBOK);
+    EXPECT_EQ(joined.type, LSR);
+    EXPECT_DOUBLE_EQ(joined.param[1], 2.0);
+    EXPECT_DOUBLE_EQ(joined.param[2], 1.0);
+
+    turn.rho = 2.0;
+    EXPECT_EQ(dubins_path_splice(&straight, &turn, &joined), EDUBPARAM);
+}
+
+TEST_F(SubpathTests, batchMatchesSingle)
+{
+    std::vector<DubinsPath> out(paths.size());
+    std::vector<int> errcodes(paths.size());
+    t1s[5] = dubins_path_length(&paths[5]) + 1.0;
+    EXPECT_EQ(dubins_extract_windows(paths.data(), t0s.data(), t1s.data(), out.data(), errcodes.data(), paths.size()),
+              EDUBPARAM);
+    for(size_t i = 0; i < paths.size(); i++) {
+        DubinsPath window;
+        int err = dubins_extract_window(&paths[i], t0s[i], t1s[i], &window);
+        EXPECT_EQ(errcodes[i], err);
+        if(err == EDUBOK) {
+            for(int j = 0; j < 3; j++) {
+                EXPECT_EQ(out[i].qi[j], window.qi[j]);
+                EXPECT_EQ(out[i].param[j], window.param[j]);
+            }
+        }
+    }
+
+    /* in place */
+    t1s[5] = t0s[5];
+    std::vector<DubinsPath> copy = paths;
+    EXPECT_EQ(dubins_extract_windows(copy.data(), t0s.data(), t1s.data(), copy.data(), nullptr, copy.size()), EDUBOK);
+    for(size_t i = 0; i < paths.size(); i++) {
+        EXPECT_EQ(copy[i].param[0] + copy[i].param[1] + copy[i].param[2] > 0, t1s[i] > t0s[i]);
+    }
+}
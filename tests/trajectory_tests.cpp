@@ -0,0 +1,208 @@
+extern "C" {
+#include "dubins.h"
+}
+
+#ifdef WIN32
+#define _USE_MATH_DEFINES
+#endif
+#include <math.h>
+#include <algorithm>
+#include <vector>
+#include "gtest/gtest.h"
+#include "random_configs.h"
+
+class TrajectoryTests : public ::testing::Test
+{
+public:
+    void SetUp()
+    {
+        std::vector<ConfigPair> pairs = RandomConfigs(27, 10.0).pairs(200);
+        for(size_t i = 0; i < pairs.size(); i++) {
+            DubinsPath path;
+            ASSERT_EQ(dubins_shortest_path(&path, pairs[i].q0, pairs[i].q1, 1.5), EDUBOK);
+            paths.push_back(path);
+        }
+        profile.straight_speed = 3.0;
+        profile.arc_speed = 1.2;
+        profile.accel = 0.8;
+        profile.decel = 1.5;
+        profile.start_speed = 0.0;
+        profile.end_speed = 0.5;
+    }
+
+protected:
+    std::vector<DubinsPath> paths;
+    DubinsSpeedProfile profile;
+};
+
+TEST_F(TrajectoryTests, rejectsBadProfiles)
+{
+    DubinsTrajectory traj;
+    DubinsSpeedProfile bad = profile;
+    bad.accel = 0.0;
+    EXPECT_EQ(dubins_trajectory_init(&traj, &paths[0], &bad), EDUBPARAM);
+    bad = profile;
+    bad.arc_speed = -1.0;
+    EXPECT_EQ(dubins_trajectory_init(&traj, &paths[0], &bad), EDUBPARAM);
+    bad = profile;
+    bad.start_speed = NAN;
+    EXPECT_EQ(dubins_trajectory_init(&traj, &paths[0], &bad), EDUBPARAM);
+
+    ASSERT_EQ(dubins_trajectory_init(&traj, &paths[0], &profile), EDUBOK);
+    double q[3];
+    EXPECT_EQ(dubins_trajectory_sample(&traj, -1e-9, q, nullptr, nullptr), EDUBPARAM);
+    EXPECT_EQ(dubins_trajectory_sample(&traj, dubins_trajectory_duration(&traj) + 1e-9, q, nullptr, nullptr), EDUBPARAM);
+    double t;
+    EXPECT_EQ(dubins_trajectory_time_at(&traj, dubins_path_length(&paths[0]) + 1e-9, &t), EDUBPARAM);
+    EXPECT_EQ(dubins_trajectory_sample_into(&traj, 0.0, nullptr, nullptr, nullptr, nullptr, nullptr, 10, 0), 0u);
+}
+
+TEST_F(TrajectoryTests, straightLineDuration)
+{
+    double q0[3] = { 0.0, 0.0, 0.0 };
+    double q1[3] = { 20.0, 0.0, 0.0 };
+    DubinsPath path;
+    ASSERT_EQ(dubins_shortest_path(&path, q0, q1, 1.0), EDUBOK);
+    DubinsSpeedProfile p = { 2.0, 1.0, 1.0, 0.5, 0.0, 0.0 };
+    DubinsTrajectory traj;
+    ASSERT_EQ(dubins_trajectory_init(&traj, &path, &p), EDUBOK);
+    /* 2 s to reach top speed over 2 m, 4 s to stop over 4 m, 14 m of cruise at 2 m/s */
+    EXPECT_NEAR(dubins_trajectory_duration(&traj), 13.0, 1e-12);
+
+    double q[3], s, v;
+    ASSERT_EQ(dubins_trajectory_sample(&traj, 1.0, q, &s, &v), EDUBOK);
+    EXPECT_NEAR(s, 0.5, 1e-12);
+    EXPECT_NEAR(v, 1.0, 1e-12);
+    EXPECT_NEAR(q[0], 0.5, 1e-12);
+    ASSERT_EQ(dubins_trajectory_sample(&traj, 11.0, q, &s, &v), EDUBOK);
+    EXPECT_NEAR(v, 1.0, 1e-12);
+    EXPECT_NEAR(s, 19.0, 1e-12);
+}
+
+TEST_F(TrajectoryTests, positionsMatchPathSampling)
+{
+    for(auto& path : paths) {
+        DubinsTrajectory traj;
+        ASSERT_EQ(dubins_trajectory_init(&traj, &path, &profile), EDUBOK);
+        double duration = dubins_trajectory_duration(&traj);
+        for(int i = 0; i <= 50; i++) {
+            double q[3], expected[3], s;
+            ASSERT_EQ(dubins_trajectory_sample(&traj, std::min(duration * i / 50, duration), q, &s, nullptr), EDUBOK);
+            ASSERT_EQ(dubins_path_sample(&path, s, expected), EDUBOK);
+            for(int j = 0; j < 3; j++) {
+                EXPECT_EQ(q[j], expected[j]);
+            }
+        }
+        double s_end;
+        double q[3];
+        ASSERT_EQ(dubins_trajectory_sample(&traj, duration, q, &s_end, nullptr), EDUBOK);
+        EXPECT_NEAR(s_end, dubins_path_length(&path), 1e-9);
+    }
+}
+
+TEST_F(TrajectoryTests, respectsLimits)
+{
+    for(auto& path : paths) {
+        DubinsTrajectory traj;
+        ASSERT_EQ(dubins_trajectory_init(&traj, &path, &profile), EDUBOK);
+        double duration = dubins_trajectory_duration(&traj);
+        double dt = duration / 2000;
+        double q[3], s, v, prev_s = 0, prev_v = 0;
+        const double seg1 = path.param[0] * path.rho;
+        const double seg2 = (path.param[0] + path.param[1]) * path.rho;
+        for(int i = 0; i <= 2000; i++) {
+            ASSERT_EQ(dubins_trajectory_sample(&traj, std::min(i * dt, duration), q, &s, &v), EDUBOK);
+            bool straight = (path.type == LSL || path.type == LSR || path.type == RSL || path.type == RSR)
+                            && s > seg1 + 1e-9 && s < seg2 - 1e-9;
+            bool arc = (s < seg1 - 1e-9 || s > seg2 + 1e-9 || path.type == RLR || path.type == LRL);
+            if(arc) {
+                EXPECT_LE(v, profile.arc_speed + 1e-9);
+            }
+            if(straight) {
+                EXPECT_LE(v, profile.straight_speed + 1e-9);
+            }
+            if(i > 0) {
+                EXPECT_GE(s, prev_s);
+                EXPECT_LE(v - prev_v, profile.accel * dt + 1e-9);
+                EXPECT_GE(v - prev_v, -profile.decel * dt - 1e-9);
+                /* the distance covered matches the average speed over the step */
+                EXPECT_NEAR(s - prev_s, 0.5 * (v + prev_v) * dt, 0.5 * (profile.accel + profile.decel) * dt * dt);
+            }
+            prev_s = s;
+            prev_v = v;
+        }
+        EXPECT_NEAR(prev_v, std::min(profile.end_speed, profile.arc_speed), 1e-9);
+    }
+}
+
+TEST_F(TrajectoryTests, timeAtInvertsSampling)
+{
+    for(auto& path : paths) {
+        DubinsTrajectory traj;
+        ASSERT_EQ(dubins_trajectory_init(&traj, &path, &profile), EDUBOK);
+        double duration = dubins_trajectory_duration(&traj);
+        for(int i = 0; i <= 40; i++) {
+            double t = std::min(duration * i / 40, duration), q[3], s, back;
+            ASSERT_EQ(dubins_trajectory_sample(&traj, t, q, &s, nullptr), EDUBOK);
+            ASSERT_EQ(dubins_trajectory_time_at(&traj, s, &back), EDUBOK);
+            EXPECT_NEAR(back, t, 1e-7);
+        }
+    }
+}
+
+TEST_F(TrajectoryTests, sampleIntoMatchesSample)
+{
+    DubinsTrajectory traj;
+    ASSERT_EQ(dubins_trajectory_init(&traj, &paths[3], &profile), EDUBOK);
+    const double dt = 0.05;
+    size_t expected = (size_t)floor(dubins_trajectory_duration(&traj) / dt) + 1;
+    std::vector<double> xs(expected + 5), ys(expected + 5), ths(expected + 5), ss(expected + 5), vs(expected + 5);
+    size_t n = dubins_trajectory_sample_into(&traj, dt, xs.data(), ys.data(), ths.data(), ss.data(), vs.data(),
+                                             xs.size(), 0);
+    ASSERT_EQ(n, expected);
+    for(size_t k = 0; k < n; k++) {
+        double q[3], s, v;
+        ASSERT_EQ(dubins_trajectory_sample(&traj, k * dt, q, &s, &v), EDUBOK);
+        EXPECT_EQ(xs[k], q[0]);
+        EXPECT_EQ(ys[k], q[1]);
+        EXPECT_EQ(ths[k], q[2]);
+        EXPECT_EQ(ss[k], s);
+        EXPECT_EQ(vs[k], v);
+    }
+
+    /* in pieces, with only some outputs */
+    std::vector<double> piece(7);
+    size_t offset = 0, got;
+    while((got = dubins_trajectory_sample_into(&traj, dt, nullptr, piece.data(), nullptr, nullptr, nullptr,
+                                               piece.size(), offset)) > 0) {
+        for(size_t k = 0; k < got; k++) {
+            EXPECT_EQ(piece[k], ys[offset + k]);
+        }
+        offset += got;
+    }
+    EXPECT_EQ(offset, expected);
+}
+
+TEST_F(TrajectoryTests, boundarySpeedsAreLowered)
+{
+    double q0[3] = { 0.0, 0.0, 0.0 };
+    double q1[3] = { 1.0, 0.0, 0.0 };
+    DubinsPath path;
+    ASSERT_EQ(dubins_shortest_path(&path, q0, q1, 1.0), EDUBOK);
+    /* 1 m is too short to brake from 3 m/s to rest at 1 m/s^2 */
+    DubinsSpeedProfile p = { 5.0, 1.0, 1.0, 1.0, 3.0, 0.0 };
+    DubinsTrajectory traj;
+    ASSERT_EQ(dubins_trajectory_init(&traj, &path, &p), EDUBOK);
+    double q[3], v;
+    ASSERT_EQ(dubins_trajectory_sample(&traj, 0.0, q, nullptr, &v), EDUBOK);
+    EXPECT_NEAR(v, sqrt(2.0), 1e-12);
+    ASSERT_EQ(dubins_trajectory_sample(&traj, dubins_trajectory_duration(&traj), q, nullptr, &v), EDUBOK);
+    EXPECT_NEAR(v, 0.0, 1e-12);
+
+    /* entering a turn faster than the arc limit */
+    double q2[3] = { 0.0, 3.0, M_PI };
+    ASSERT_EQ(dubins_path(&path, q0, q2, 1.5, LSL), EDUBOK);
+    ASSERT_EQ(dubins_trajectory_init(&traj, &path, &p), EDUBOK);
+    ASSERT_EQ(dubins_trajectory_sample(&traj, 0.0, q, nullptr, &v), EDUBOK);
+    EXPECT_NEAR(v, 1.0, 1e-12);
+}
@@ -1,7 +1,25 @@
 // wasm.config.js
 module.exports = {
   emscripten_path: './../emsdk',
-  inputfile: './src/dubins.c',
+  // Left out on purpose, none of them has a JS binding in src/dubins.js:
+  //   dubins_lut.c, dubins_map.c, dubins_roadmap.c - save and map tables and graphs as files
+  //   dubins_route.c                                 - streaming waypoint sampler for native callers
+  //   dubins_fixed.c                                 - fixed point solver for targets without an FPU
+  inputfiles: [
+    './src/dubins.c',
+    './src/dubins_simd.c',
+    './src/dubins_matrix.c',
+    './src/dubins_parallel.c',
+    './src/dubins_stats.c',
+    './src/dubins_float.c',
+    './src/dubins_packed.c',
+    './src/dubins_heading.c',
+    './src/dubins_collision.c',
+    './src/dubins_index.c',
+    './src/dubins_cache.c',
+    './src/dubins_canonical.c',
+    './src/dubins_trajectory.c',
+  ],
   outputfile: './dist/dubins.js',
   exported_functions: [
     'dubins_shortest_path',
@@ -16,5 +34,17 @@ module.exports = {
     '-s WASM=1',
     '',
   ],
+  // second flavour, picked by src/dubins_loader.js where SIMD128 and shared memory are available
+  simd_threads: {
+    outputfile: './dist/dubins.simd.js',
+    flags: [
+      '-O3',
+      '-msimd128',
+      '-pthread',
+      '-s USE_PTHREADS=1',
+      '-s PTHREAD_POOL_SIZE=8',
+      '-DDUBINS_WASM_POOL_SIZE=8',
+      '-s INITIAL_MEMORY=67108864',
+    ],
+  },
 };
-